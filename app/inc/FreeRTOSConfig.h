@@ -111,6 +111,7 @@ extern uint32_t SystemCoreClock;
 #define INCLUDE_vTaskSuspend              1   /**< Enable vTaskSuspend API      */
 #define INCLUDE_vTaskDelayUntil           1   /**< Enable vTaskDelayUntil API   */
 #define INCLUDE_vTaskDelay                1   /**< Enable vTaskDelay API        */
+#define INCLUDE_xTaskGetSchedulerState    1   /**< Enable scheduler state API   */
 /** @} */ /* i2_FreeRTOS_Tasks */
 
 /**
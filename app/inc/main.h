@@ -50,10 +50,13 @@
 /* Drivers -------------------------------------------------------------------*/
 #include "i2_fifo.h"
 #include "i2_led.h"
+#include "i2_spi_flash.h"
 
 /* HMI Interface -------------------------------------------------------------*/
 #include "i2_font5x7.h"
 #include "i2_oled_ssd1306.h"
+#include "i2_oled_ssd1306_spi.h"
+#include "i2_oled_widget.h"
 
 /**
  * @defgroup I2_HUB_VERSION iota2 Firmware version.
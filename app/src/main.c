@@ -32,6 +32,9 @@
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
 
+#include <stdio.h>
+#include <string.h>
+
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
 /* Private macro -------------------------------------------------------------*/
@@ -46,9 +49,68 @@ static i2_spi_inst_t ext_flash = {
     "extflash", "SPI1", { "extflash_CS", GPIOG, GPIO_PIN_15 }
 };
 
+/** @brief External SPI NOR flash device */
+static i2_spi_flash_t ext_flash_dev;
+
 /* Private function prototypes -----------------------------------------------*/
 /* Private functions ---------------------------------------------------------*/
 
+/**
+ * @brief   Console report.
+ * @details Prints a message on console, usable before scheduler starts.
+ *
+ * @param[in] *msg    Message to print.
+ * @retval  None.
+ */
+static void HUB_report( const char *msg )
+{
+  int32_t sent;
+
+  i2_uart_tx_polling( &uart_console, (uint8_t *)msg, (int32_t)strlen(msg),
+                      &sent, 100 );
+}
+
+#if ( I2_FIFO_BENCH_SUPPORT == I2_ENABLE )
+/**
+ * @brief   FIFO benchmark report.
+ * @details Prints cycles per byte of locked and SPSC FIFO modes on console,
+ *          for single byte and bulk calls. Runs from main before scheduler
+ *          start, user task stack is too small for it.
+ *
+ * @retval  None.
+ */
+static void HUB_fifo_bench( void )
+{
+  static const i2_fifo_mode_t modes[] = {
+    I2_FIFO_MODE_LOCKED, I2_FIFO_MODE_SPSC
+  };
+  i2_fifo_bench_t result;
+  uint32_t wr, rd;
+  char msg[80];
+  int32_t i;
+  int32_t bulk;
+
+  for ( i = 0; i < (int32_t)(sizeof(modes) / sizeof(modes[0])); i++ ) {
+    for ( bulk = 0; bulk < 2; bulk++ ) {
+      if ( i2_fifo_bench( modes[i], bulk, &result ) != I2_SUCCESS ) {
+        HUB_report( "fifo bench: failed\r\n" );
+        return;
+      }
+      /* Cycles per byte, two decimals */
+      wr = (result.write_cycles * 100) / result.bytes;
+      rd = (result.read_cycles * 100) / result.bytes;
+      snprintf( msg, sizeof(msg),
+                "fifo %-6s %-4s: write %lu.%02lu read %lu.%02lu cyc/B\r\n",
+                (modes[i] == I2_FIFO_MODE_SPSC) ? "spsc" : "locked",
+                bulk ? "bulk" : "byte",
+                (unsigned long)(wr / 100), (unsigned long)(wr % 100),
+                (unsigned long)(rd / 100), (unsigned long)(rd % 100) );
+      HUB_report( msg );
+    }
+  }
+}
+#endif /* I2_FIFO_BENCH_SUPPORT */
+
 /**
  * @brief   User task.
  * @details Generic user task.
@@ -97,7 +159,16 @@ int main(void)
   i2_rtc_init();
   i2_led_init();
   i2_uart_init( &uart_console );
+#if ( I2_FIFO_BENCH_SUPPORT == I2_ENABLE )
+  HUB_fifo_bench();
+#endif /* I2_FIFO_BENCH_SUPPORT */
   i2_spi_init( &ext_flash );
+  if ( i2_spi_flash_init( &ext_flash_dev, &ext_flash ) != I2_SUCCESS ) {
+    /* Keep booting, a zero sized device rejects every access */
+    memset( &ext_flash_dev, 0, sizeof(ext_flash_dev) );
+    HUB_report( "extflash: init failed\r\n" );
+  }
+  ssd1306_set_backend(&ssd1306_spi_backend);
   ssd1306_init(SSD1306_CMD_SWITCH_CAP_VCC);
 
   /* Create user task */
@@ -0,0 +1,45 @@
+/**
+ * @author      iota square [i2]
+ * <pre>
+ * ██╗ ██████╗ ████████╗ █████╗ ██████╗
+ * ██║██╔═══██╗╚══██╔══╝██╔══██╗╚════██╗
+ * ██║██║   ██║   ██║   ███████║ █████╔╝
+ * ██║██║   ██║   ██║   ██╔══██║██╔═══╝
+ * ██║╚██████╔╝   ██║   ██║  ██║███████╗
+ * ╚═╝ ╚═════╝    ╚═╝   ╚═╝  ╚═╝╚══════╝
+ * </pre>
+ *
+ * @date        17-10-2026
+ * @file        i2_common.h
+ * @brief       iota2 common definitions, independent of MCU HAL.
+ *
+ * @copyright   GNU GPU v3
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * Free Software, Hell Yeah!
+ *
+ **/
+
+#pragma once
+
+/* Exported define -----------------------------------------------------------*/
+/**
+ * @defgroup I2_DISABLE_ENABLE iota2 Enabling options.
+ * Definitions For Enabling / Disabling Functionalities.
+ *
+ * @{
+ */
+#define I2_DISABLE                  ( 0 ) /**< Defines to disable a feature   */
+#define I2_ENABLE                   ( 1 ) /**< Defines to enable a feature    */
+/** @} */ /* I2_DISABLE_ENABLE */
+
+/************************ (C) COPYRIGHT iota2 ***[i2]*****END OF FILE**********/
@@ -35,29 +35,132 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "i2_common.h"
+#include "i2_error.h"
+
 /* Public define -------------------------------------------------------------*/
+/**
+ * @defgroup I2_FIFO_BENCH_SPEC FIFO benchmark.
+ * On target cycles per byte measurement of FIFO modes, taken with DWT cycle
+ * counter.
+ *
+ * @{
+ */
+#define I2_FIFO_BENCH_SUPPORT     ( I2_DISABLE ) /**< Benchmark option      */
+#define I2_FIFO_BENCH_SIZE        ( 256 )   /**< FIFO size, power of two    */
+#define I2_FIFO_BENCH_ROUNDS      ( 16 )    /**< Fill and drain rounds      */
+/** @} */ /* I2_FIFO_BENCH_SPEC */
+
 /**
  * @defgroup i2_fifo_t FIFO context.
  * Definitions for FIFO context.
  *
  * @{
  */
+/** @brief FIFO access modes */
+typedef enum {
+  I2_FIFO_MODE_LOCKED = 0,  /**< Indexes guarded by critical sections     */
+  I2_FIFO_MODE_SPSC,        /**< Lock-free single producer, single consumer */
+  I2_FIFO_MODE_MPSC,        /**< Lock-free multi producer, single consumer  */
+} i2_fifo_mode_t;
+
 /** @brief FIFO implementation context */
 typedef struct {
-  int32_t wr_index;     /**< FIFO write index       */
-  int32_t rd_index;     /**< FIFO read index        */
-  int32_t fifo_size;    /**< Size of FIFO buffer    */
-  uint8_t *buf;         /**< FIFO buffer            */
+  volatile uint32_t wr_index;   /**< FIFO write index               */
+  volatile uint32_t rd_index;   /**< FIFO read index                */
+  int32_t fifo_size;            /**< Size of FIFO buffer (elements) */
+  int32_t elem_size;            /**< Size of one element in bytes   */
+  uint8_t *buf;                 /**< FIFO buffer                    */
+  uint32_t mask;                /**< Index mask (lock-free modes)   */
+  i2_fifo_mode_t mode;          /**< FIFO access mode               */
+  volatile uint32_t wr_reserve; /**< Reserved write index (MPSC)    */
+  volatile uint32_t producers;  /**< Active producers (MPSC)        */
 } i2_fifo_t ;
 /** @} */ /* i2_fifo_t */
 
+/**
+ * @defgroup i2_fifo_bench_t FIFO benchmark result.
+ * Cycles of fastest fill and fastest drain of a @ref I2_FIFO_BENCH_SIZE
+ * bytes FIFO.
+ *
+ * @{
+ */
+/** @brief FIFO benchmark result */
+typedef struct {
+  int32_t   bytes;              /**< Bytes per fill and drain       */
+  uint32_t  write_cycles;       /**< Cycles to fill FIFO            */
+  uint32_t  read_cycles;        /**< Cycles to drain FIFO           */
+} i2_fifo_bench_t;
+/** @} */ /* i2_fifo_bench_t */
+
+/**
+ * @defgroup i2_fifo_typed Typed FIFO wrapper.
+ * Generates a type safe element FIFO on top of @ref i2_fifo_t.
+ *
+ * Usage:
+ *   I2_FIFO_TYPED_DEFINE(evt_fifo, evt_t)
+ *   static evt_t evt_storage[16];
+ *   static evt_fifo_t evt_q;
+ *   evt_fifo_init(&evt_q, evt_storage, 16, I2_FIFO_MODE_MPSC);
+ *
+ * @{
+ */
+#define I2_FIFO_TYPED_DEFINE(name, type)                                      \
+  typedef struct {                                                            \
+    i2_fifo_t fifo;                                                           \
+  } name##_t;                                                                 \
+  static inline i2_error name##_init(name##_t *q, type *buf, int32_t count,  \
+                                     i2_fifo_mode_t mode)                     \
+  {                                                                           \
+    return i2_fifo_init_elem(&q->fifo, buf, count, sizeof(type), mode);      \
+  }                                                                           \
+  static inline int32_t name##_put(name##_t *q, const type *elem,            \
+                                   bool in_isr)                               \
+  {                                                                           \
+    return i2_fifo_put(&q->fifo, elem, in_isr);                               \
+  }                                                                           \
+  static inline int32_t name##_get(name##_t *q, type *elem, bool in_isr)     \
+  {                                                                           \
+    return i2_fifo_get(&q->fifo, elem, in_isr);                               \
+  }                                                                           \
+  static inline int32_t name##_write(name##_t *q, const type *elems,         \
+                                     int32_t count, bool in_isr)              \
+  {                                                                           \
+    return i2_fifo_write_bulk(&q->fifo, (const uint8_t *)elems, count,        \
+                              in_isr);                                        \
+  }                                                                           \
+  static inline int32_t name##_read(name##_t *q, type *elems,                \
+                                    int32_t count, bool in_isr)               \
+  {                                                                           \
+    return i2_fifo_read_bulk(&q->fifo, (uint8_t *)elems, count, in_isr);      \
+  }                                                                           \
+  static inline int32_t name##_count(name##_t *q, bool in_isr)               \
+  {                                                                           \
+    return i2_fifo_count(&q->fifo, in_isr);                                   \
+  }
+/** @} */ /* i2_fifo_typed */
+
 /* Public functions --------------------------------------------------------- */
 void i2_fifo_init(i2_fifo_t *fifo, uint8_t *buf, int32_t fifo_size);
+i2_error i2_fifo_init_spsc(i2_fifo_t *fifo, uint8_t *buf, int32_t fifo_size);
+i2_error i2_fifo_init_elem(i2_fifo_t *fifo, void *buf, int32_t fifo_size,
+                           int32_t elem_size, i2_fifo_mode_t mode);
 void i2_fifo_reset(i2_fifo_t *fifo);
 int32_t i2_fifo_size(i2_fifo_t *fifo);
 int32_t i2_fifo_count(i2_fifo_t *fifo, bool in_isr);
 int32_t i2_fifo_write(i2_fifo_t *fifo, uint8_t data, bool in_isr);
 int32_t i2_fifo_read(i2_fifo_t *fifo, uint8_t *data, bool in_isr);
+int32_t i2_fifo_put(i2_fifo_t *fifo, const void *elem, bool in_isr);
+int32_t i2_fifo_get(i2_fifo_t *fifo, void *elem, bool in_isr);
 void i2_fifo_copy(i2_fifo_t *fifo, uint8_t *dst, int32_t *size, bool in_isr);
+int32_t i2_fifo_write_bulk(i2_fifo_t *fifo, const uint8_t *src, int32_t size,
+                           bool in_isr);
+int32_t i2_fifo_read_bulk(i2_fifo_t *fifo, uint8_t *dst, int32_t size,
+                          bool in_isr);
+int32_t i2_fifo_peek_linear(i2_fifo_t *fifo, uint8_t **data, bool in_isr);
+int32_t i2_fifo_commit(i2_fifo_t *fifo, int32_t size, bool in_isr);
+#if ( I2_FIFO_BENCH_SUPPORT == I2_ENABLE )
+i2_error i2_fifo_bench(i2_fifo_mode_t mode, bool bulk, i2_fifo_bench_t *result);
+#endif /* I2_FIFO_BENCH_SUPPORT */
 
 /************************ (C) COPYRIGHT iota2 ***[i2]*****END OF FILE**********/
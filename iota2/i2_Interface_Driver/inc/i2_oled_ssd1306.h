@@ -35,9 +35,13 @@
 #include "math.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
 
-#include "i2_stm32f4xx_hal_common.h"
-#include "i2_stm32f4xx_hal_spi.h"
+#include "i2_common.h"
+#include "i2_error.h"
+#include "i2_assert.h"
 
 /* Global Defines ------------------------------------------------------------*/
 /**
@@ -48,8 +52,8 @@
  */
 #define SSD1306_DISPLAY_WIDTH     ( 128 ) /**< Display width configuration    */
 #define SSD1306_DISPLAY_HEIGHT    ( 64 )  /**< DIsplay height configuration   */
+#define SSD1306_DISPLAY_PAGES     ( SSD1306_DISPLAY_HEIGHT / 8 ) /**< Pages   */
 #define SSD1306_MAX_POLY_CORNERS  ( 10 )  /**< Max num of corners in polygon  */
-#define SSD1306_SPI_TIMEOUT       ( 100 ) /**< default timeout for SPI bus    */
 /** Size of buffer required, according to configured width and height         */
 #define SSD1306_DATA_BUF_SIZE     (SSD1306_LCDWIDTH * SSD1306_LCDHEIGHT / 8)
 /** @} */ /* SSD1306_DISPLAY_SPEC */
@@ -95,6 +99,31 @@
 #define SSD1306_LAYER2              ( 2 )           /**< Display layer 2      */
 /** @} */ /* SSD1306_MULTI_LAYER_SPEC */
 
+/**
+ * @defgroup SSD1306_BLEND_SPEC SSD1306 layer blend modes.
+ * How layer 1 is blended over layer 2 in multi-layer display.
+ *
+ * @{
+ */
+#define SSD1306_BLEND_OR            ( 0 ) /**< Pixels set in either layer */
+#define SSD1306_BLEND_AND           ( 1 ) /**< Pixels set in both layers  */
+#define SSD1306_BLEND_XOR           ( 2 ) /**< Layer 1 inverts layer 2    */
+#define SSD1306_BLEND_MASK          ( 3 ) /**< Layer 1 clears layer 2     */
+/** @} */ /* SSD1306_BLEND_SPEC */
+
+/**
+ * @defgroup SSD1306_DISPLAY_TASK_SPEC SSD1306 display service task.
+ * Optional task owning a front buffer, which is streamed over SPI DMA while
+ * drawing continues into the layer (back) buffers. Needs RTOS aware HAL.
+ *
+ * @{
+ */
+#define SSD1306_DISPLAY_TASK_SUPPORT  ( I2_DISABLE ) /**< Display task option */
+#define SSD1306_DISPLAY_TASK_FPS      ( 30 )   /**< Max display frame rate    */
+#define SSD1306_DISPLAY_TASK_PRIORITY ( 2 )    /**< Display task priority     */
+#define SSD1306_DISPLAY_TASK_STACK    ( 256 )  /**< Display task stack depth  */
+/** @} */ /* SSD1306_DISPLAY_TASK_SPEC */
+
 /**
  * @defgroup SSD1306_TEXT_SPEC SSD1306 text display specifications.
  * Specifications for displaying text over screen.
@@ -106,6 +135,8 @@
 #define SSD1306_TEXT_SIZE_NORMAL        ( 0 )   /**< Font size normal         */
 #define SSD1306_TEXT_SIZE_LARGE         ( 1 )   /**< Font size medium         */
 #define SSD1306_TEXT_SIZE_EXTREA_LARGE  ( 2 )   /**< Font size large          */
+#define SSD1306_GLYPH_CACHE_SIZE        ( 16 )  /**< Scaled glyphs cached     */
+#define SSD1306_GLYPH_CACHE_MAX_SCALE   ( 4 )   /**< Max cached glyph scale   */
 /** @} */ /* SSD1306_TEXT_SPEC */
 
 /**
@@ -130,6 +161,8 @@
 #define SSD1306_CMD_SET_HIGH_COLUMN           0x10  /**< Higher column setting*/
 #define SSD1306_CMD_SET_START_LINE            0x40  /**< COnfigure start line */
 #define SSD1306_CMD_MEMORY_ADDRESSING_MODE    0x20  /**< Addressing mode      */
+#define SSD1306_CMD_SET_COLUMN_ADDR           0x21  /**< Column window        */
+#define SSD1306_CMD_SET_PAGE_ADDR             0x22  /**< Page window          */
 #define SSD1306_CMD_SET_COM_PINS              0xDA  /**< Set COM pins         */
 #define SSD1306_CMD_COM_SCAN_INC              0xC0  /**< Incremental COM scan */
 #define SSD1306_CMD_COM_SCAN_DEC              0xC8  /**< Decremental COM scan */
@@ -191,8 +224,36 @@
 #define SSD1306_VERTICAL_AND_RIGHT_HORIZONTAL_SCROLL    0x29
 /** @brief Enable Vertical scrolling with horizontal in left direction */
 #define SSD1306_VERTICAL_AND_LEFT_HORIZONTAL_SCROLL     0x2A
+/** @brief Scroll step every 2 frames */
+#define SSD1306_SCROLL_2_FRAMES                         0x07
+/** @brief Scroll step every 3 frames */
+#define SSD1306_SCROLL_3_FRAMES                         0x04
+/** @brief Scroll step every 4 frames */
+#define SSD1306_SCROLL_4_FRAMES                         0x05
+/** @brief Scroll step every 5 frames */
+#define SSD1306_SCROLL_5_FRAMES                         0x00
+/** @brief Scroll step every 25 frames */
+#define SSD1306_SCROLL_25_FRAMES                        0x06
+/** @brief Scroll step every 64 frames */
+#define SSD1306_SCROLL_64_FRAMES                        0x01
+/** @brief Scroll step every 128 frames */
+#define SSD1306_SCROLL_128_FRAMES                       0x02
+/** @brief Scroll step every 256 frames */
+#define SSD1306_SCROLL_256_FRAMES                       0x03
 /** @} */ /* SSD1306_SCROLL_SPEC */
 
+/**
+ * @defgroup SSD1306_SHIFT_SPEC SSD1306 frame buffer shift directions.
+ * Directions for @ref ssd1306_shift_frame_buffer.
+ *
+ * @{
+ */
+#define SSD1306_SHIFT_UP            ( 0 ) /**< Shift content up           */
+#define SSD1306_SHIFT_DOWN          ( 1 ) /**< Shift content down         */
+#define SSD1306_SHIFT_LEFT          ( 2 ) /**< Shift content left         */
+#define SSD1306_SHIFT_RIGHT         ( 3 ) /**< Shift content right        */
+/** @} */ /* SSD1306_SHIFT_SPEC */
+
 /* Public Definitions --------------------------------------------------------*/
 /**
  * @defgroup SSD1306_POINT_SPEC SSD1306 display point specification.
@@ -220,11 +281,117 @@ typedef struct {
 } ssd1306_poly_t;
 /** @} */ /* SSD1306_POLYGON_SPEC */
 
+/**
+ * @defgroup SSD1306_EDGE_TABLE_SPEC SSD1306 polygon edge table.
+ * Polygon prepared for scanline filling, edges carry their scanline range
+ * and 16.16 fixed point x position and slope. Built once with
+ * @ref ssd1306_edge_table_build and filled at any position with
+ * @ref ssd1306_fill_edge_table.
+ *
+ * @{
+ */
+/** @brief SSD1306 polygon edge */
+typedef struct {
+  int16_t   y_start;  /**< First scanline crossed by edge       */
+  int16_t   y_end;    /**< Last scanline crossed by edge        */
+  int32_t   x;        /**< x at first scanline, 16.16 fixed     */
+  int32_t   dx;       /**< x step per scanline, 16.16 fixed     */
+} ssd1306_edge_t;
+
+/** @brief SSD1306 polygon edge table */
+typedef struct {
+  /** Non horizontal edges, sorted by first scanline */
+  ssd1306_edge_t  edge[SSD1306_MAX_POLY_CORNERS];
+  int16_t         edges;                            /**< Number of edges  */
+  int16_t         corner_x[SSD1306_MAX_POLY_CORNERS]; /**< Outline x     */
+  int16_t         corner_y[SSD1306_MAX_POLY_CORNERS]; /**< Outline y     */
+  int16_t         corners;                          /**< Outline corners  */
+} ssd1306_edge_table_t;
+/** @} */ /* SSD1306_EDGE_TABLE_SPEC */
+
+/**
+ * @defgroup SSD1306_CMD_BATCH_SPEC SSD1306 command batch.
+ * Command bytes collected by @ref ssd1306_cmd_add and friends, then sent by
+ * @ref ssd1306_cmd_send as a single bus write with a single DC change.
+ *
+ * @{
+ */
+#define SSD1306_CMD_BATCH_SIZE      ( 32 )  /**< Max bytes in a batch       */
+
+/** @brief SSD1306 command batch */
+typedef struct {
+  uint8_t         cmd[SSD1306_CMD_BATCH_SIZE];  /**< Commands and arguments */
+  uint16_t        size;                         /**< Number of bytes        */
+} ssd1306_cmd_batch_t;
+/** @} */ /* SSD1306_CMD_BATCH_SPEC */
+
+/**
+ * @defgroup SSD1306_INIT_SPEC SSD1306 power up sequence.
+ * Reset and configuration steps, each step tells how long to wait before
+ * the next one so that a task can step through without blocking.
+ *
+ * @{
+ */
+#define SSD1306_POWER_UP_DELAY_MS   ( 2 ) /**< VDD settle time before reset */
+#define SSD1306_RESET_PULSE_MS      ( 1 ) /**< Reset low pulse width        */
+#define SSD1306_RESET_RECOVERY_MS   ( 2 ) /**< Controller start after reset */
+
+/** @brief SSD1306 power up state */
+typedef enum {
+  SSD1306_STATE_POWER_UP,       /**< Reset released, VDD settling       */
+  SSD1306_STATE_RESET,          /**< Reset asserted                     */
+  SSD1306_STATE_RESET_RELEASE,  /**< Reset released, controller starting*/
+  SSD1306_STATE_CONFIG,         /**< Configuration and display on       */
+  SSD1306_STATE_READY,          /**< Display ready for GDDRAM data      */
+} ssd1306_state_t;
+/** @} */ /* SSD1306_INIT_SPEC */
+
+/**
+ * @defgroup SSD1306_BACKEND_SPEC SSD1306 display backend.
+ * Transport used to reach the display controller. Drawing code only emits
+ * command and GDDRAM data streams, backend delivers them, e.g. over SPI with
+ * DC and RST pins (i2_oled_ssd1306_spi.h) or to a host display emulator
+ * (i2_oled_ssd1306_emu.h).
+ *
+ * @{
+ */
+/** @brief SSD1306 data segment, part of a single data write */
+typedef struct {
+  const uint8_t   *data;    /**< Data bytes       */
+  uint16_t        size;     /**< Number of bytes  */
+} ssd1306_segment_t;
+
+/** @brief SSD1306 display backend */
+typedef struct {
+  /** Transport and control pins setup */
+  void (*init)(void);
+  /** Drives display reset line, true holds display in reset */
+  void (*reset)(bool asserted);
+  /** Writes commands and their arguments */
+  void (*write_cmd)(const uint8_t *cmd, uint16_t size);
+  /** Writes GDDRAM data segments as a single write */
+  void (*write_data)(const ssd1306_segment_t *segments, uint8_t count);
+  /** Delay in ms */
+  void (*delay)(uint32_t ms);
+} ssd1306_backend_t;
+/** @} */ /* SSD1306_BACKEND_SPEC */
+
 /* Public functions ----------------------------------------------------------*/
+void ssd1306_set_backend(const ssd1306_backend_t *backend);
 void ssd1306_init(uint8_t vcc_state);
-void ssd1306_write_byte(uint8_t byte);
-void ssd1306_write_buffer(uint8_t* buff,uint16_t bytes_to_write);
+void ssd1306_init_start(uint8_t vcc_state);
+bool ssd1306_init_step(uint32_t *wait_ms);
+bool ssd1306_is_ready(void);
+void ssd1306_cmd_begin(ssd1306_cmd_batch_t *batch);
+void ssd1306_cmd_add(ssd1306_cmd_batch_t *batch, uint8_t cmd);
+void ssd1306_cmd_add_window(ssd1306_cmd_batch_t *batch,
+                            uint8_t first_page, uint8_t last_page,
+                            uint8_t first_col, uint8_t last_col);
+void ssd1306_cmd_add_display(ssd1306_cmd_batch_t *batch, bool on);
+void ssd1306_cmd_send(ssd1306_cmd_batch_t *batch);
 void ssd1306_refresh ( void );
+void ssd1306_present(void);
+void ssd1306_mark_dirty(int16_t y, int16_t x, int16_t h, int16_t w);
 void ssd1306_turn_on(void);
 void ssd1306_turn_off(void);
 void ssd1306_draw_pixel(int16_t y, int16_t x, uint16_t color, uint16_t layer);
@@ -241,8 +408,13 @@ void ssd1306_draw_fast_hline( int16_t y, int16_t x, int16_t w,
 void ssd1306_draw_polygon(ssd1306_poly_t* poly,
                           int16_t y, int16_t x,
                           uint16_t color, uint16_t layer);
-void ssd1306_fill_polygon(ssd1306_poly_t* poly, double y, double x,
+void ssd1306_fill_polygon(ssd1306_poly_t* poly, int16_t y, int16_t x,
                           uint16_t color, uint16_t layer);
+void ssd1306_edge_table_build(ssd1306_edge_table_t *table,
+                              const ssd1306_poly_t *poly);
+void ssd1306_fill_edge_table(const ssd1306_edge_table_t *table,
+                             int16_t y, int16_t x,
+                             uint16_t color, uint16_t layer);
 void ssd1306_fill_screen(uint16_t color, uint16_t layer);
 void ssd1306_draw_circle( uint8_t y0, uint8_t x0, uint8_t r,
                           uint16_t color, uint16_t layer);
@@ -255,7 +427,7 @@ void ssd1306_fill_circle_helper(int16_t y0, int16_t x0, int16_t r,
                                 uint16_t color, uint16_t layer);
 void ssd1306_draw_rectangle(int16_t y, int16_t x, int16_t h, int16_t w,
                             uint16_t color, uint16_t layer);
-void ssd1306_fill_rectangle(uint8_t y, uint8_t x, uint8_t h, uint8_t w,
+void ssd1306_fill_rectangle(int16_t y, int16_t x, int16_t h, int16_t w,
                             uint16_t color, uint16_t layer);
 void ssd1306_draw_bitmap( int16_t y, int16_t x, uint8_t *bitmap,
                           int16_t h, int16_t w, uint16_t color, uint16_t layer);
@@ -265,12 +437,22 @@ void ssd1306_draw_char_loc( int16_t y, int16_t x, uint16_t c, uint8_t size,
                             uint16_t color, uint16_t layer);
 void ssd1306_draw_string( int16_t y, int16_t x, char *txt, uint8_t size,
                           uint16_t color, uint16_t layer);
+void ssd1306_draw_text_run(int16_t y, int16_t x, const char *text,
+                           uint8_t size, uint16_t color, uint16_t layer);
 void ssd1306_draw_string_loc( int16_t y, int16_t x, char *text, uint8_t size,
                               uint16_t color, uint16_t layer);
 void ssd1306_type_string_loc( int16_t y, int16_t x, char *text, uint8_t size,
                               uint8_t delay, uint16_t color, uint16_t layer);
 void ssd1306_shift_frame_buffer( uint16_t height, uint16_t direction);
+void ssd1306_scroll_horizontal(bool right, uint8_t start_page,
+                               uint8_t end_page, uint8_t interval);
+void ssd1306_scroll_diagonal(bool right, uint8_t start_page, uint8_t end_page,
+                             uint8_t interval, uint8_t fixed_rows,
+                             uint8_t rows, uint8_t offset);
+void ssd1306_scroll_stop(void);
+#if ( SSD1306_MULTILAYER_SUPPORT == I2_ENABLE )
 void ssd1306_mix_frame_buffer(void);
-void ssd1306_delay(__IO uint32_t nCount);
+void ssd1306_set_blend_mode(uint8_t mode);
+#endif /* SSD1306_MULTILAYER_SUPPORT */
 
 /************************ (C) COPYRIGHT iota2 ***[i2]*****END OF FILE**********/
@@ -0,0 +1,65 @@
+/**
+ * @author      iota square [i2]
+ * <pre>
+ * ██╗ ██████╗ ████████╗ █████╗ ██████╗
+ * ██║██╔═══██╗╚══██╔══╝██╔══██╗╚════██╗
+ * ██║██║   ██║   ██║   ███████║ █████╔╝
+ * ██║██║   ██║   ██║   ██╔══██║██╔═══╝
+ * ██║╚██████╔╝   ██║   ██║  ██║███████╗
+ * ╚═╝ ╚═════╝    ╚═╝   ╚═╝  ╚═╝╚══════╝
+ * </pre>
+ *
+ * @date        17-10-2026
+ * @file        i2_oled_ssd1306_emu.h
+ * @brief       SSD1306 OLED display host emulator backend.
+ *
+ * @copyright   GNU GPU v3
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * Free Software, Hell Yeah!
+ *
+ **/
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include "i2_oled_ssd1306.h"
+
+/* Global Defines ------------------------------------------------------------*/
+/**
+ * @defgroup ssd1306_emu_stats_t SSD1306 emulator statistics.
+ * Traffic seen by emulated display controller.
+ *
+ * @{
+ */
+/** @brief SSD1306 emulator statistics */
+typedef struct {
+  uint32_t    cmd_writes;       /**< Command writes                     */
+  uint32_t    cmd_bytes;        /**< Command and argument bytes         */
+  uint32_t    data_writes;      /**< GDDRAM data writes                 */
+  uint32_t    data_bytes;       /**< GDDRAM data bytes                  */
+  uint32_t    delay_ms;         /**< Time requested through delays      */
+} ssd1306_emu_stats_t;
+/** @} */ /* ssd1306_emu_stats_t */
+
+/* Public variables ----------------------------------------------------------*/
+/** @brief Host display emulator backend, see @ref ssd1306_set_backend */
+extern const ssd1306_backend_t ssd1306_emu_backend;
+
+/* Public functions ----------------------------------------------------------*/
+const uint8_t* ssd1306_emu_gddram(void);
+bool ssd1306_emu_pixel(int16_t y, int16_t x);
+void ssd1306_emu_stats_get(ssd1306_emu_stats_t *stats);
+void ssd1306_emu_stats_reset(void);
+i2_error ssd1306_emu_write_pbm(const char *path);
+
+/************************ (C) COPYRIGHT iota2 ***[i2]*****END OF FILE**********/
@@ -0,0 +1,57 @@
+/**
+ * @author      iota square [i2]
+ * <pre>
+ * ██╗ ██████╗ ████████╗ █████╗ ██████╗
+ * ██║██╔═══██╗╚══██╔══╝██╔══██╗╚════██╗
+ * ██║██║   ██║   ██║   ███████║ █████╔╝
+ * ██║██║   ██║   ██║   ██╔══██║██╔═══╝
+ * ██║╚██████╔╝   ██║   ██║  ██║███████╗
+ * ╚═╝ ╚═════╝    ╚═╝   ╚═╝  ╚═╝╚══════╝
+ * </pre>
+ *
+ * @date        17-10-2026
+ * @file        i2_oled_ssd1306_spi.h
+ * @brief       SSD1306 OLED display SPI backend.
+ *
+ * @copyright   GNU GPU v3
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * Free Software, Hell Yeah!
+ *
+ **/
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include "i2_oled_ssd1306.h"
+#include "i2_stm32f4xx_hal_spi.h"
+
+/* Global Defines ------------------------------------------------------------*/
+/**
+ * @defgroup SSD1306_SPI_BUS_SPEC SSD1306 SPI bus specification.
+ * SPI bus parameters of display.
+ *
+ * @{
+ */
+#define SSD1306_SPI_TIMEOUT       ( 100 ) /**< default timeout for SPI bus    */
+/** @} */ /* SSD1306_SPI_BUS_SPEC */
+
+/* Public variables ----------------------------------------------------------*/
+/** @brief SPI and GPIO display backend, see @ref ssd1306_set_backend */
+extern const ssd1306_backend_t ssd1306_spi_backend;
+
+/* Public functions ----------------------------------------------------------*/
+void ssd1306_write_byte(uint8_t byte);
+void ssd1306_write_buffer(uint8_t* buff,uint16_t bytes_to_write);
+void ssd1306_delay(uint32_t ms);
+
+/************************ (C) COPYRIGHT iota2 ***[i2]*****END OF FILE**********/
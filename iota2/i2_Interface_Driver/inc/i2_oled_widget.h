@@ -0,0 +1,156 @@
+/**
+ * @author      iota square [i2]
+ * <pre>
+ * ██╗ ██████╗ ████████╗ █████╗ ██████╗
+ * ██║██╔═══██╗╚══██╔══╝██╔══██╗╚════██╗
+ * ██║██║   ██║   ██║   ███████║ █████╔╝
+ * ██║██║   ██║   ██║   ██╔══██║██╔═══╝
+ * ██║╚██████╔╝   ██║   ██║  ██║███████╗
+ * ╚═╝ ╚═════╝    ╚═╝   ╚═╝  ╚═╝╚══════╝
+ * </pre>
+ *
+ * @date        17-10-2026
+ * @file        i2_oled_widget.h
+ * @brief       OLED retained-mode widgets interface.
+ *
+ * @copyright   GNU GPU v3
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * Free Software, Hell Yeah!
+ *
+ **/
+
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "i2_oled_ssd1306.h"
+
+/* Public defines ------------------------------------------------------------*/
+/**
+ * @defgroup I2_WIDGET_SPEC OLED widget parameters.
+ * Limits of widgets drawn on SSD1306 display.
+ *
+ * @{
+ */
+#define I2_WIDGET_LOG_LINES       ( 4 )   /**< Max lines in log widget      */
+/** Max characters per log line */
+#define I2_WIDGET_LOG_LINE_CHARS  ( SSD1306_TEXT_MAX_LINE_CHAR )
+#define I2_WIDGET_VALUE_CHARS     ( 11 )  /**< Max digits of value widget   */
+/** @} */ /* I2_WIDGET_SPEC */
+
+/**
+ * @defgroup i2_widget_type_t OLED widget types.
+ * Kinds of widgets available.
+ *
+ * @{
+ */
+/** @brief OLED widget types */
+typedef enum {
+  I2_WIDGET_LABEL = 0,          /**< Static text                    */
+  I2_WIDGET_VALUE,              /**< Right aligned number with unit */
+  I2_WIDGET_BAR,                /**< Horizontal bar gauge           */
+  I2_WIDGET_ICON,               /**< Bitmap shown or hidden         */
+  I2_WIDGET_LOG,                /**< Scrolling text lines           */
+} i2_widget_type_t;
+/** @} */ /* i2_widget_type_t */
+
+/**
+ * @defgroup i2_widget_t OLED widget.
+ * Retained-mode widget, tracks its own bounds and redraws only itself when
+ * its content changes.
+ *
+ * @{
+ */
+/** @brief OLED widget */
+typedef struct i2_widget {
+  i2_widget_type_t    type;     /**< Widget type                      */
+  int16_t             y;        /**< (y) coordinate of bounds         */
+  int16_t             x;        /**< (x) coordinate of bounds         */
+  int16_t             h;        /**< Height of bounds                 */
+  int16_t             w;        /**< Width of bounds                  */
+  uint8_t             size;     /**< Text size @ref SSD1306_TEXT_SPEC */
+  bool                dirty;    /**< Needs redraw                     */
+  struct i2_widget    *next;    /**< Next widget on screen            */
+  /** Widget type specific state */
+  union {
+    /** Label state */
+    struct {
+      const char      *text;    /**< Text to display                  */
+      uint32_t        hash;     /**< Hash of text contents when set   */
+    } label;
+    /** Value state */
+    struct {
+      int32_t         value;    /**< Value to display                 */
+      uint8_t         digits;   /**< Characters reserved for value    */
+      const char      *unit;    /**< Unit displayed after value       */
+    } value;
+    /** Bar gauge state */
+    struct {
+      int32_t         min;      /**< Value of empty bar               */
+      int32_t         max;      /**< Value of full bar                */
+      int16_t         fill;     /**< Filled width to display          */
+      int16_t         drawn;    /**< Filled width on display, or -1   */
+    } bar;
+    /** Icon state */
+    struct {
+      uint8_t         *bitmap;  /**< Icon bitmap, rows of bytes       */
+      bool            visible;  /**< Icon shown                       */
+    } icon;
+    /** Log state */
+    struct {
+      /** Log lines, ring buffer */
+      char            line[I2_WIDGET_LOG_LINES][I2_WIDGET_LOG_LINE_CHARS + 1];
+      uint8_t         lines;    /**< Lines displayed                  */
+      uint8_t         head;     /**< Oldest line                      */
+      uint8_t         count;    /**< Lines in use                     */
+    } log;
+  } u;
+} i2_widget_t;
+/** @} */ /* i2_widget_t */
+
+/**
+ * @defgroup i2_widget_screen_t OLED widget screen.
+ * Set of widgets updated together.
+ *
+ * @{
+ */
+/** @brief OLED widget screen */
+typedef struct {
+  i2_widget_t         *first;   /**< First widget on screen           */
+} i2_widget_screen_t;
+/** @} */ /* i2_widget_screen_t */
+
+/* Public functions --------------------------------------------------------- */
+void i2_widget_label_init(i2_widget_t *widget, int16_t y, int16_t x,
+                          uint8_t size, const char *text);
+void i2_widget_value_init(i2_widget_t *widget, int16_t y, int16_t x,
+                          uint8_t size, uint8_t digits, const char *unit);
+void i2_widget_bar_init(i2_widget_t *widget, int16_t y, int16_t x,
+                        int16_t h, int16_t w, int32_t min, int32_t max);
+void i2_widget_icon_init(i2_widget_t *widget, int16_t y, int16_t x,
+                         int16_t h, int16_t w, uint8_t *bitmap);
+void i2_widget_log_init(i2_widget_t *widget, int16_t y, int16_t x,
+                        uint8_t size, uint8_t lines);
+void i2_widget_add(i2_widget_screen_t *screen, i2_widget_t *widget);
+void i2_widget_invalidate(i2_widget_t *widget);
+void i2_widget_label_set(i2_widget_t *widget, const char *text);
+void i2_widget_value_set(i2_widget_t *widget, int32_t value);
+void i2_widget_bar_set(i2_widget_t *widget, int32_t value);
+void i2_widget_icon_show(i2_widget_t *widget, bool visible);
+void i2_widget_log_append(i2_widget_t *widget, const char *text);
+bool i2_widget_update(i2_widget_screen_t *screen);
+
+/************************ (C) COPYRIGHT iota2 ***[i2]*****END OF FILE**********/
@@ -0,0 +1,117 @@
+/**
+ * @author      iota square [i2]
+ * <pre>
+ * ██╗ ██████╗ ████████╗ █████╗ ██████╗
+ * ██║██╔═══██╗╚══██╔══╝██╔══██╗╚════██╗
+ * ██║██║   ██║   ██║   ███████║ █████╔╝
+ * ██║██║   ██║   ██║   ██╔══██║██╔═══╝
+ * ██║╚██████╔╝   ██║   ██║  ██║███████╗
+ * ╚═╝ ╚═════╝    ╚═╝   ╚═╝  ╚═╝╚══════╝
+ * </pre>
+ *
+ * @date        17-10-2026
+ * @file        i2_spi_flash.h
+ * @brief       JEDEC SPI NOR flash interface.
+ *
+ * @copyright   GNU GPU v3
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * Free Software, Hell Yeah!
+ *
+ **/
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "i2_error.h"
+#include "i2_stm32f4xx_hal_spi.h"
+
+/* Public defines ------------------------------------------------------------*/
+/**
+ * @defgroup I2_SPI_FLASH_SPEC SPI NOR flash parameters.
+ * Limits and defaults used by the SPI NOR flash driver.
+ *
+ * @{
+ */
+#define I2_SPI_FLASH_MAX_PAGE_SIZE    ( 256 )   /**< Page buffer size         */
+#define I2_SPI_FLASH_ERASE_TYPES      ( 4 )     /**< Erase types from SFDP    */
+#define I2_SPI_FLASH_TIMEOUT          ( 100 )   /**< SPI bus timeout in ms    */
+/** @} */ /* I2_SPI_FLASH_SPEC */
+
+/**
+ * @defgroup i2_spi_flash_erase_t SPI NOR flash erase type.
+ * One erase granularity supported by the flash.
+ *
+ * @{
+ */
+/** @brief SPI NOR flash erase type */
+typedef struct {
+  uint32_t        size;         /**< Erase size in bytes, 0 if unused */
+  uint8_t         opcode;       /**< Erase instruction                */
+} i2_spi_flash_erase_t;
+/** @} */ /* i2_spi_flash_erase_t */
+
+/**
+ * @defgroup i2_spi_flash_t SPI NOR flash device.
+ * Flash geometry and instructions, filled in by @ref i2_spi_flash_init
+ * from JEDEC ID and SFDP tables.
+ *
+ * @{
+ */
+/** @brief SPI NOR flash device */
+typedef struct {
+  i2_spi_inst_t         *spi;           /**< SPI instance of flash      */
+  uint8_t               jedec_id[3];    /**< Manufacturer, type, size   */
+  bool                  sfdp;           /**< Parameters read from SFDP  */
+  uint32_t              size;           /**< Flash size in bytes        */
+  uint32_t              page_size;      /**< Program page size          */
+  uint8_t               addr_len;       /**< Address bytes, 3 or 4      */
+  uint8_t               suspend_opcode; /**< Erase suspend instruction  */
+  uint8_t               resume_opcode;  /**< Erase resume instruction   */
+  /** Erase types, sorted from smallest to largest */
+  i2_spi_flash_erase_t  erase[I2_SPI_FLASH_ERASE_TYPES];
+  /** Page buffer used by @ref i2_spi_flash_program */
+  uint8_t               page[I2_SPI_FLASH_MAX_PAGE_SIZE];
+} i2_spi_flash_t;
+/** @} */ /* i2_spi_flash_t */
+
+/**
+ * @brief   SPI NOR flash page fill callback.
+ * @details Provides data for next page program, called while previous page
+ *          is being programmed by the flash. Either fill page buffer and
+ *          return it, or return a pointer to @p size bytes of own data.
+ */
+typedef const uint8_t* (*i2_spi_flash_fill_cb_t)(void *arg, uint8_t *page,
+                                                 uint32_t offset, int32_t size);
+
+/* Public functions --------------------------------------------------------- */
+i2_error i2_spi_flash_init(i2_spi_flash_t *flash, i2_spi_inst_t *spi);
+i2_error i2_spi_flash_read(i2_spi_flash_t *flash, uint32_t addr,
+                           uint8_t *buf, int32_t size);
+i2_error i2_spi_flash_write(i2_spi_flash_t *flash, uint32_t addr,
+                            const uint8_t *buf, int32_t size);
+i2_error i2_spi_flash_program(i2_spi_flash_t *flash, uint32_t addr,
+                              int32_t size, i2_spi_flash_fill_cb_t fill,
+                              void *arg);
+i2_error i2_spi_flash_erase(i2_spi_flash_t *flash, uint32_t addr,
+                            uint32_t size);
+i2_error i2_spi_flash_erase_start(i2_spi_flash_t *flash, uint32_t addr,
+                                  uint32_t size);
+i2_error i2_spi_flash_is_busy(i2_spi_flash_t *flash, bool *busy);
+i2_error i2_spi_flash_wait_ready(i2_spi_flash_t *flash, uint32_t timeout);
+i2_error i2_spi_flash_suspend(i2_spi_flash_t *flash);
+i2_error i2_spi_flash_resume(i2_spi_flash_t *flash);
+
+/************************ (C) COPYRIGHT iota2 ***[i2]*****END OF FILE**********/
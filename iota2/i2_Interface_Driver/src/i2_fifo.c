@@ -40,6 +40,271 @@
 #include <semphr.h>
 #endif
 
+/* Private functions -------------------------------------------------------- */
+/**
+ * @brief   Enter FIFO critical section.
+ * @details Guards locked mode FIFOs, and MPSC producers running in task
+ *          context. ISR callers are never guarded.
+ *
+ * @param[in] fifo      FIFO context @ref i2_fifo_t.
+ * @param[in] in_isr    Is this function is called from an ISR or not.
+ * @return  None.
+ */
+static inline void fifo_lock(i2_fifo_t *fifo, bool in_isr)
+{
+#if defined ( ENABLE_RTOS_AWARE_HAL )
+  if ( (fifo->mode != I2_FIFO_MODE_SPSC) && !in_isr ) {
+    vPortEnterCritical();
+  }
+#else
+  UNUSED_PARAMETER(fifo);
+  UNUSED_PARAMETER(in_isr);
+#endif
+}
+
+/**
+ * @brief   Exit FIFO critical section.
+ * @details Counterpart of @ref fifo_lock.
+ *
+ * @param[in] fifo      FIFO context @ref i2_fifo_t.
+ * @param[in] in_isr    Is this function is called from an ISR or not.
+ * @return  None.
+ */
+static inline void fifo_unlock(i2_fifo_t *fifo, bool in_isr)
+{
+#if defined ( ENABLE_RTOS_AWARE_HAL )
+  if ( (fifo->mode != I2_FIFO_MODE_SPSC) && !in_isr ) {
+    vPortExitCritical();
+  }
+#else
+  UNUSED_PARAMETER(fifo);
+  UNUSED_PARAMETER(in_isr);
+#endif
+}
+
+/**
+ * @brief   Atomically add to a FIFO index.
+ * @details Exclusive load/store loop, monitor is cleared on exception entry
+ *          so a preempted update simply retries.
+ *
+ * @param[in] addr      Address of index to update.
+ * @param[in] value     Value to add.
+ * @return  Index value before update.
+ */
+static inline uint32_t fifo_atomic_add(volatile uint32_t *addr, uint32_t value)
+{
+  uint32_t old;
+
+  do {
+    old = __LDREXW(addr);
+  } while ( __STREXW(old + value, addr) );
+
+  return old;
+}
+
+/**
+ * @brief   Locked mode FIFO count.
+ * @details Counts elements and brings indexes back into buffer range. Must
+ *          be called within @ref fifo_lock.
+ *
+ * @param[in] fifo      FIFO context @ref i2_fifo_t.
+ * @return  Number of elements in FIFO.
+ */
+static inline int32_t fifo_locked_count(i2_fifo_t *fifo)
+{
+  int32_t count;
+
+  count = (int32_t)(fifo->wr_index - fifo->rd_index);
+  if (count < 0) {
+    count += fifo->fifo_size;
+  }
+
+  /* Keep write index ahead of read index, so full and empty stay distinct */
+  fifo->rd_index %= fifo->fifo_size;
+  fifo->wr_index = fifo->rd_index + count;
+
+  return count;
+}
+
+/**
+ * @brief   Get element offset of a FIFO index.
+ * @details Masks the index in lock-free modes, wraps with modulo in locked
+ *          mode.
+ *
+ * @param[in] fifo      FIFO context @ref i2_fifo_t.
+ * @param[in] index     FIFO read or write index.
+ * @return  Element offset in FIFO buffer.
+ */
+static inline int32_t fifo_offset(i2_fifo_t *fifo, uint32_t index)
+{
+  if (fifo->mode != I2_FIFO_MODE_LOCKED) {
+    return (int32_t)(index & fifo->mask);
+  }
+  return (int32_t)(index % (uint32_t)fifo->fifo_size);
+}
+
+/**
+ * @brief   Copy elements into FIFO buffer.
+ * @details Copies in at most two segments split at the buffer wrap point.
+ *
+ * @param[in] fifo      FIFO context @ref i2_fifo_t.
+ * @param[in] index     FIFO index of first element.
+ * @param[in] src       Source elements.
+ * @param[in] count     Number of elements to copy.
+ * @return  None.
+ */
+static void fifo_copy_in(i2_fifo_t *fifo, uint32_t index, const uint8_t *src,
+                         int32_t count)
+{
+  int32_t offset = fifo_offset(fifo, index);
+  int32_t first = fifo->fifo_size - offset;
+
+  if (fifo->elem_size == 1 && count == 1) {
+    fifo->buf[offset] = *src;
+    return;
+  }
+
+  if (first > count) {
+    first = count;
+  }
+  memcpy(&fifo->buf[offset * fifo->elem_size], src, first * fifo->elem_size);
+  if (count > first) {
+    memcpy(fifo->buf, &src[first * fifo->elem_size],
+           (count - first) * fifo->elem_size);
+  }
+}
+
+/**
+ * @brief   Copy elements out of FIFO buffer.
+ * @details Copies in at most two segments split at the buffer wrap point.
+ *
+ * @param[in]  fifo     FIFO context @ref i2_fifo_t.
+ * @param[in]  index    FIFO index of first element.
+ * @param[out] dst      Destination for elements.
+ * @param[in]  count    Number of elements to copy.
+ * @return  None.
+ */
+static void fifo_copy_out(i2_fifo_t *fifo, uint32_t index, uint8_t *dst,
+                          int32_t count)
+{
+  int32_t offset = fifo_offset(fifo, index);
+  int32_t first = fifo->fifo_size - offset;
+
+  if (fifo->elem_size == 1 && count == 1) {
+    *dst = fifo->buf[offset];
+    return;
+  }
+
+  if (first > count) {
+    first = count;
+  }
+  memcpy(dst, &fifo->buf[offset * fifo->elem_size], first * fifo->elem_size);
+  if (count > first) {
+    memcpy(&dst[first * fifo->elem_size], fifo->buf,
+           (count - first) * fifo->elem_size);
+  }
+}
+
+/**
+ * @brief   Publish elements written to FIFO buffer.
+ * @details Advances write index once data has been stored in buffer.
+ *
+ * @param[in] fifo      FIFO context @ref i2_fifo_t.
+ * @param[in] count     Number of elements written.
+ * @param[in] in_isr    Is this function is called from an ISR or not.
+ * @return  None.
+ */
+static void fifo_produce(i2_fifo_t *fifo, int32_t count, bool in_isr)
+{
+  __DMB();
+  fifo_lock(fifo, in_isr);
+  fifo->wr_index += (uint32_t)count;
+  fifo_unlock(fifo, in_isr);
+}
+
+/**
+ * @brief   Release elements read from FIFO buffer.
+ * @details Advances read index once data has been fetched from buffer.
+ *
+ * @param[in] fifo      FIFO context @ref i2_fifo_t.
+ * @param[in] count     Number of elements consumed.
+ * @param[in] in_isr    Is this function is called from an ISR or not.
+ * @return  None.
+ */
+static void fifo_consume(i2_fifo_t *fifo, int32_t count, bool in_isr)
+{
+  __DMB();
+  if (fifo->mode == I2_FIFO_MODE_LOCKED) {
+    fifo_lock(fifo, in_isr);
+    fifo->rd_index += (uint32_t)count;
+    fifo_unlock(fifo, in_isr);
+  } else {
+    fifo->rd_index += (uint32_t)count;
+  }
+}
+
+/**
+ * @brief   Write elements to MPSC FIFO buffer.
+ * @details Producers reserve slots with an atomic update of the reserve
+ *          index, fill them and leave. Last producer to leave publishes all
+ *          reservations, which are complete at that point since producers
+ *          only ever nest (ISR preempting ISR or task). Task context
+ *          producers are made atomic against ISRs with a short critical
+ *          section, so time sliced tasks cannot interleave.
+ *
+ * @param[in] fifo      FIFO context @ref i2_fifo_t.
+ * @param[in] src       Source elements.
+ * @param[in] count     Number of elements to write.
+ * @param[in] in_isr    Is this function is called from an ISR or not.
+ * @return  Number of elements written.
+ */
+static int32_t fifo_mpsc_write(i2_fifo_t *fifo, const uint8_t *src,
+                               int32_t count, bool in_isr)
+{
+  uint32_t slot;
+  uint32_t space;
+  uint32_t pending;
+  uint32_t reserve;
+
+  fifo_lock(fifo, in_isr);
+  fifo_atomic_add(&fifo->producers, 1);
+
+  do {
+    slot = __LDREXW(&fifo->wr_reserve);
+    space = (uint32_t)fifo->fifo_size - (slot - fifo->rd_index);
+    if ((uint32_t)count > space) {
+      count = (int32_t)space;
+    }
+    if (count <= 0) {
+      __CLREX();
+      break;
+    }
+  } while ( __STREXW(slot + count, &fifo->wr_reserve) );
+
+  if (count > 0) {
+    fifo_copy_in(fifo, slot, src, count);
+  }
+  __DMB();
+
+  pending = fifo_atomic_add(&fifo->producers, (uint32_t)-1);
+  if (pending == 1) {
+    /* Never move published index backwards, a nested producer may have
+     * already published a newer reservation */
+    reserve = fifo->wr_reserve;
+    do {
+      slot = __LDREXW(&fifo->wr_index);
+      if ((int32_t)(reserve - slot) <= 0) {
+        __CLREX();
+        break;
+      }
+    } while ( __STREXW(reserve, &fifo->wr_index) );
+  }
+
+  fifo_unlock(fifo, in_isr);
+
+  return (count > 0) ? count : 0;
+}
+
 /* Public functions --------------------------------------------------------- */
 /**
  * @brief   Initializes FIFO context.
@@ -54,10 +319,65 @@ void i2_fifo_init(i2_fifo_t *fifo, uint8_t *buf, int32_t fifo_size)
 {
   i2_fifo_reset(fifo);
   fifo->fifo_size = fifo_size;
+  fifo->elem_size = 1;
   fifo->buf = buf;
+  fifo->mask = 0;
+  fifo->mode = I2_FIFO_MODE_LOCKED;
   memset(buf, 0, fifo_size);
 }
 
+/**
+ * @brief   Initializes FIFO context in lock-free SPSC mode.
+ * @details FIFO is accessed without critical sections, it is only safe with
+ *          exactly one producer context and one consumer context (e.g. an ISR
+ *          writing and a task reading). Indexes run freely and are masked to
+ *          buffer, so FIFO size has to be a power of two.
+ *
+ * @param[in] fifo        FIFO context to initialize @ref i2_fifo_t.
+ * @param[in] buf         Buffer to allocation to FIFO context.
+ * @param[in] fifo_size   Size of FIFO, must be a power of two.
+ * @return  i2 error code, I2_INVALID_PARAM if size is not a power of two.
+ */
+i2_error i2_fifo_init_spsc(i2_fifo_t *fifo, uint8_t *buf, int32_t fifo_size)
+{
+  return i2_fifo_init_elem(fifo, buf, fifo_size, 1, I2_FIFO_MODE_SPSC);
+}
+
+/**
+ * @brief   Initializes FIFO context for fixed size elements.
+ * @details Element FIFO holds @p fifo_size elements of @p elem_size bytes
+ *          each, buffer must provide fifo_size * elem_size bytes. Lock-free
+ *          modes require a power of two element count.
+ *
+ * @param[in] fifo        FIFO context to initialize @ref i2_fifo_t.
+ * @param[in] buf         Element storage to allocation to FIFO context.
+ * @param[in] fifo_size   Number of elements in FIFO.
+ * @param[in] elem_size   Size of one element in bytes.
+ * @param[in] mode        FIFO access mode @ref i2_fifo_mode_t.
+ * @return  i2 error code.
+ */
+i2_error i2_fifo_init_elem(i2_fifo_t *fifo, void *buf, int32_t fifo_size,
+                           int32_t elem_size, i2_fifo_mode_t mode)
+{
+  if ( !fifo || !buf || (fifo_size <= 0) || (elem_size <= 0) ) {
+    return I2_INVALID_PARAM;
+  }
+
+  if ( (mode != I2_FIFO_MODE_LOCKED) && (fifo_size & (fifo_size - 1)) ) {
+    return I2_INVALID_PARAM;
+  }
+
+  i2_fifo_reset(fifo);
+  fifo->fifo_size = fifo_size;
+  fifo->elem_size = elem_size;
+  fifo->buf = buf;
+  fifo->mask = (mode != I2_FIFO_MODE_LOCKED) ? (uint32_t)(fifo_size - 1) : 0;
+  fifo->mode = mode;
+  memset(buf, 0, fifo_size * elem_size);
+
+  return I2_SUCCESS;
+}
+
 /**
  * @brief   Reset FIFO context.
  * @details Reset read and write indexes of FIFO.
@@ -68,6 +388,8 @@ void i2_fifo_init(i2_fifo_t *fifo, uint8_t *buf, int32_t fifo_size)
 void i2_fifo_reset(i2_fifo_t *fifo)
 {
   fifo->wr_index = fifo->rd_index = 0;
+  fifo->wr_reserve = 0;
+  fifo->producers = 0;
 }
 
 /**
@@ -85,6 +407,7 @@ int32_t i2_fifo_size(i2_fifo_t *fifo)
 /**
  * @brief   Get count of FIFO buffer.
  * @details Returns the difference between write and read buffer.
+ *          In lock-free modes no critical section is taken.
  *
  * @param[in] fifo      FIFO context @ref i2_fifo_t.
  * @param[in] in_isr    Is this function is called from an ISR or not.
@@ -94,31 +417,114 @@ int32_t i2_fifo_count(i2_fifo_t *fifo, bool in_isr)
 {
   int32_t count;
 
-#if defined ( ENABLE_RTOS_AWARE_HAL )
-  if (!in_isr) {
-    vPortEnterCritical();
+  if (fifo->mode != I2_FIFO_MODE_LOCKED) {
+    /* Free running indexes, unsigned difference survives index wrap */
+    return (int32_t)(fifo->wr_index - fifo->rd_index);
   }
-#else
-  UNUSED_PARAMETER(in_isr);
-#endif
 
-  count = fifo->wr_index - fifo->rd_index;
-  if (count < 0) {
-    count += fifo->fifo_size;
+  fifo_lock(fifo, in_isr);
+  count = fifo_locked_count(fifo);
+  fifo_unlock(fifo, in_isr);
+
+  return count;
+}
+
+/**
+ * @brief   Write element to FIFO buffer.
+ * @details Copies one element of FIFO element size into FIFO.
+ *
+ * @param[in] fifo      FIFO context to write @ref i2_fifo_t.
+ * @param[in] elem      Element to write on FIFO.
+ * @param[in] in_isr    Is this function is called from an ISR or not.
+ * @return  If Success returns FIFO count else ( -1 ) when error occurred.
+ */
+int32_t i2_fifo_put(i2_fifo_t *fifo, const void *elem, bool in_isr)
+{
+  uint32_t wr;
+  uint32_t rd;
+  int32_t count;
+
+  switch (fifo->mode) {
+    case I2_FIFO_MODE_SPSC:
+      wr = fifo->wr_index;
+      rd = fifo->rd_index;
+      if ((wr - rd) >= (uint32_t)fifo->fifo_size) {
+        /* FIFO Full */
+        return -1;
+      }
+      fifo_copy_in(fifo, wr, elem, 1);
+      /* Data must land before consumer can observe the new write index */
+      __DMB();
+      fifo->wr_index = wr + 1;
+      return (int32_t)(wr + 1 - rd);
+
+    case I2_FIFO_MODE_MPSC:
+      if ( !fifo_mpsc_write(fifo, elem, 1, in_isr) ) {
+        /* FIFO Full */
+        return -1;
+      }
+      return (int32_t)(fifo->wr_reserve - fifo->rd_index);
+
+    default:
+      /* Check, store and publish in a single critical section */
+      fifo_lock(fifo, in_isr);
+      count = fifo_locked_count(fifo);
+      if (count >= fifo->fifo_size) {
+        fifo_unlock(fifo, in_isr);
+        /* FIFO Full */
+        return -1;
+      }
+      fifo_copy_in(fifo, fifo->wr_index, elem, 1);
+      fifo->wr_index++;
+      fifo_unlock(fifo, in_isr);
+      return count + 1;
   }
+}
 
-  if (count < fifo->fifo_size) {
-    fifo->wr_index %= fifo->fifo_size;
-    fifo->rd_index %= fifo->fifo_size;
+/**
+ * @brief   Read element from FIFO buffer.
+ * @details Copies oldest element out of FIFO.
+ *
+ * @param[in]  fifo     FIFO context to read @ref i2_fifo_t.
+ * @param[out] elem     Element read from FIFO.
+ * @param[in]  in_isr   Is this function is called from an ISR or not.
+ * @return  If Success returns FIFO count else ( -1 ) when error occurred.
+ */
+int32_t i2_fifo_get(i2_fifo_t *fifo, void *elem, bool in_isr)
+{
+  uint32_t rd;
+  uint32_t wr;
+  int32_t count;
+
+  if (fifo->mode == I2_FIFO_MODE_LOCKED) {
+    /* Check, fetch and release in a single critical section */
+    fifo_lock(fifo, in_isr);
+    count = fifo_locked_count(fifo);
+    if ( !count ) {
+      fifo_unlock(fifo, in_isr);
+      /* FIFO empty */
+      return -1;
+    }
+    fifo_copy_out(fifo, fifo->rd_index, elem, 1);
+    fifo->rd_index++;
+    fifo_unlock(fifo, in_isr);
+    return count - 1;
   }
 
-#if defined ( ENABLE_RTOS_AWARE_HAL )
-  if (!in_isr) {
-    vPortExitCritical();
+  rd = fifo->rd_index;
+  wr = fifo->wr_index;
+  if (wr == rd) {
+    /* FIFO empty */
+    return -1;
   }
-#endif
 
-  return count;
+  /* Pairs with producer barrier, index observed before data is fetched */
+  __DMB();
+  fifo_copy_out(fifo, rd, elem, 1);
+  __DMB();
+  fifo->rd_index = rd + 1;
+
+  return (int32_t)(wr - (rd + 1));
 }
 
 /**
@@ -132,18 +538,7 @@ int32_t i2_fifo_count(i2_fifo_t *fifo, bool in_isr)
  */
 int32_t i2_fifo_write(i2_fifo_t *fifo, uint8_t data, bool in_isr)
 {
-  int32_t retval = 0;
-
-  if (i2_fifo_count(fifo, in_isr) < fifo->fifo_size) {
-    fifo->buf[fifo->wr_index % fifo->fifo_size] = data;
-    fifo->wr_index++;
-    retval = i2_fifo_count(fifo, in_isr);
-  } else {
-    /* FIFO Full */
-    retval = -1;
-  }
-
-  return retval;
+  return i2_fifo_put(fifo, &data, in_isr);
 }
 
 /**
@@ -157,18 +552,142 @@ int32_t i2_fifo_write(i2_fifo_t *fifo, uint8_t data, bool in_isr)
  */
 int32_t i2_fifo_read(i2_fifo_t *fifo, uint8_t *data, bool in_isr)
 {
-  int32_t retval = 0;
+  return i2_fifo_get(fifo, data, in_isr);
+}
 
-  if ( i2_fifo_count(fifo, in_isr) ) {
-    *data = fifo->buf[fifo->rd_index % fifo->fifo_size];
-    fifo->rd_index++;
-    retval = i2_fifo_count(fifo, in_isr);
-  } else {
-    /* FIFO empty */
-    retval = -1;
+/**
+ * @brief   Write a buffer to FIFO.
+ * @details Copies as many elements as fit in FIFO, in at most two segments
+ *          split at the buffer wrap point.
+ *
+ * @param[in] fifo      FIFO context to write @ref i2_fifo_t.
+ * @param[in] src       Source buffer to copy from.
+ * @param[in] size      Number of elements (bytes for byte FIFO) to write.
+ * @param[in] in_isr    Is this function is called from an ISR or not.
+ * @return  Number of elements written else ( -1 ) when error occurred.
+ */
+int32_t i2_fifo_write_bulk(i2_fifo_t *fifo, const uint8_t *src, int32_t size,
+                           bool in_isr)
+{
+  int32_t space;
+
+  if ( !fifo || !src ) {
+    return -1;
   }
 
-  return retval;
+  if (fifo->mode == I2_FIFO_MODE_MPSC) {
+    return (size > 0) ? fifo_mpsc_write(fifo, src, size, in_isr) : 0;
+  }
+
+  space = fifo->fifo_size - i2_fifo_count(fifo, in_isr);
+  if (size > space) {
+    size = space;
+  }
+  if (size <= 0) {
+    return 0;
+  }
+
+  fifo_copy_in(fifo, fifo->wr_index, src, size);
+  fifo_produce(fifo, size, in_isr);
+
+  return size;
+}
+
+/**
+ * @brief   Read a buffer from FIFO.
+ * @details Copies up to requested elements out of FIFO, in at most two
+ *          segments split at the buffer wrap point.
+ *
+ * @param[in] fifo      FIFO context to read @ref i2_fifo_t.
+ * @param[in] dst       Destination buffer to copy to.
+ * @param[in] size      Maximum number of elements (bytes for byte FIFO).
+ * @param[in] in_isr    Is this function is called from an ISR or not.
+ * @return  Number of elements read else ( -1 ) when error occurred.
+ */
+int32_t i2_fifo_read_bulk(i2_fifo_t *fifo, uint8_t *dst, int32_t size,
+                          bool in_isr)
+{
+  int32_t count;
+
+  if ( !fifo || !dst ) {
+    return -1;
+  }
+
+  count = i2_fifo_count(fifo, in_isr);
+  if (size > count) {
+    size = count;
+  }
+  if (size <= 0) {
+    return 0;
+  }
+
+  __DMB();
+  fifo_copy_out(fifo, fifo->rd_index, dst, size);
+  fifo_consume(fifo, size, in_isr);
+
+  return size;
+}
+
+/**
+ * @brief   Peek linear readable region of FIFO.
+ * @details Returns pointer to oldest element in FIFO and number of elements
+ *          that can be read contiguously from there, without copying. Data
+ *          stays in FIFO until it is released with @ref i2_fifo_commit. If
+ *          FIFO wraps, a second peek after commit returns the remaining part.
+ *
+ * @param[in]  fifo     FIFO context to read @ref i2_fifo_t.
+ * @param[out] data     Pointer to readable region in FIFO buffer.
+ * @param[in]  in_isr   Is this function is called from an ISR or not.
+ * @return  Number of contiguous readable elements else ( -1 ) on error.
+ */
+int32_t i2_fifo_peek_linear(i2_fifo_t *fifo, uint8_t **data, bool in_isr)
+{
+  int32_t count;
+  int32_t offset;
+
+  if ( !fifo || !data ) {
+    return -1;
+  }
+
+  count = i2_fifo_count(fifo, in_isr);
+  __DMB();
+  offset = fifo_offset(fifo, fifo->rd_index);
+  if (count > (fifo->fifo_size - offset)) {
+    count = fifo->fifo_size - offset;
+  }
+  *data = &fifo->buf[offset * fifo->elem_size];
+
+  return count;
+}
+
+/**
+ * @brief   Release elements from FIFO.
+ * @details Consumes elements previously obtained with
+ *          @ref i2_fifo_peek_linear.
+ *
+ * @param[in] fifo      FIFO context to read @ref i2_fifo_t.
+ * @param[in] size      Number of elements to release.
+ * @param[in] in_isr    Is this function is called from an ISR or not.
+ * @return  Number of elements released else ( -1 ) on error.
+ */
+int32_t i2_fifo_commit(i2_fifo_t *fifo, int32_t size, bool in_isr)
+{
+  int32_t count;
+
+  if ( !fifo ) {
+    return -1;
+  }
+
+  count = i2_fifo_count(fifo, in_isr);
+  if (size > count) {
+    size = count;
+  }
+  if (size <= 0) {
+    return 0;
+  }
+  fifo_consume(fifo, size, in_isr);
+
+  return size;
 }
 
 /**
@@ -184,17 +703,100 @@ int32_t i2_fifo_read(i2_fifo_t *fifo, uint8_t *data, bool in_isr)
  */
 void i2_fifo_copy(i2_fifo_t *fifo, uint8_t *dst, int32_t *size, bool in_isr)
 {
-  uint8_t data;
-  int32_t counter = 0;
+  int32_t counter;
 
-  /* Read until given buffer is full or fifo empty */
-  while ((*size > counter) && (i2_fifo_read(fifo, &data, in_isr) >= 0)) {
-    *dst++ = data;
-    counter++;
-  }
-  *size = counter;
+  counter = i2_fifo_read_bulk(fifo, dst, *size, in_isr);
+  *size = (counter < 0) ? 0 : counter;
 
   return;
 }
 
+#if ( I2_FIFO_BENCH_SUPPORT == I2_ENABLE )
+/**
+ * @brief   Measures FIFO cycles per byte.
+ * @details Fills and drains a @ref I2_FIFO_BENCH_SIZE bytes FIFO
+ *          @ref I2_FIFO_BENCH_ROUNDS times with task level calls (in_isr
+ *          false) and keeps the fastest fill and drain, so interrupts
+ *          landing in a round do not count. Byte mode goes through
+ *          @ref i2_fifo_write and @ref i2_fifo_read, bulk mode through
+ *          @ref i2_fifo_write_bulk and @ref i2_fifo_read_bulk in 16 byte
+ *          chunks. Locked mode is the current critical section path, not the
+ *          original implementation. Callable before scheduler start, kernel
+ *          critical sections then cost the same as from a task.
+ *
+ * @param[in]  mode     FIFO mode to measure, locked or SPSC.
+ * @param[in]  bulk     Use bulk calls instead of single bytes.
+ * @param[out] result   Measured cycles @ref i2_fifo_bench_t.
+ * @return  i2 error code, I2_INVALID_PARAM on unsupported mode.
+ */
+i2_error i2_fifo_bench(i2_fifo_mode_t mode, bool bulk, i2_fifo_bench_t *result)
+{
+  static uint8_t buf[I2_FIFO_BENCH_SIZE];
+  uint8_t chunk[16];
+  i2_fifo_t fifo;
+  uint32_t start;
+  uint32_t cycles;
+  int32_t round;
+  int32_t i;
+
+  if ( !result || (mode == I2_FIFO_MODE_MPSC) ) {
+    return I2_INVALID_PARAM;
+  }
+
+  if ( i2_fifo_init_elem(&fifo, buf, I2_FIFO_BENCH_SIZE, 1, mode) !=
+       I2_SUCCESS ) {
+    return I2_INVALID_PARAM;
+  }
+
+  if ( !(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) ) {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  }
+
+  memset(chunk, 0xA5, sizeof(chunk));
+  result->bytes = I2_FIFO_BENCH_SIZE;
+  result->write_cycles = UINT32_MAX;
+  result->read_cycles = UINT32_MAX;
+
+  for (round = 0; round < I2_FIFO_BENCH_ROUNDS; round++) {
+    start = DWT->CYCCNT;
+    if (bulk) {
+      for (i = 0; i < I2_FIFO_BENCH_SIZE; i += sizeof(chunk)) {
+        i2_fifo_write_bulk(&fifo, chunk, sizeof(chunk), false);
+      }
+    } else {
+      for (i = 0; i < I2_FIFO_BENCH_SIZE; i++) {
+        i2_fifo_write(&fifo, (uint8_t)i, false);
+      }
+    }
+    cycles = DWT->CYCCNT - start;
+    if (cycles < result->write_cycles) {
+      result->write_cycles = cycles;
+    }
+
+    start = DWT->CYCCNT;
+    if (bulk) {
+      for (i = 0; i < I2_FIFO_BENCH_SIZE; i += sizeof(chunk)) {
+        i2_fifo_read_bulk(&fifo, chunk, sizeof(chunk), false);
+      }
+    } else {
+      for (i = 0; i < I2_FIFO_BENCH_SIZE; i++) {
+        i2_fifo_read(&fifo, &chunk[0], false);
+      }
+    }
+    cycles = DWT->CYCCNT - start;
+    if (cycles < result->read_cycles) {
+      result->read_cycles = cycles;
+    }
+
+    if (i2_fifo_count(&fifo, false) != 0) {
+      return I2_FAILURE;
+    }
+  }
+
+  return I2_SUCCESS;
+}
+#endif /* I2_FIFO_BENCH_SUPPORT */
+
 /************************ (C) COPYRIGHT iota2 ***[i2]*****END OF FILE**********/
@@ -32,224 +32,805 @@
 #include "i2_oled_ssd1306.h"
 #include "i2_font5x7.h"
 
+#if ( SSD1306_DISPLAY_TASK_SUPPORT == I2_ENABLE )
+#if !defined ( ENABLE_RTOS_AWARE_HAL )
+#error "SSD1306 display task requires ENABLE_RTOS_AWARE_HAL"
+#endif /* ENABLE_RTOS_AWARE_HAL */
+#include <FreeRTOS.h>
+#include <task.h>
+#include <semphr.h>
+#endif /* SSD1306_DISPLAY_TASK_SUPPORT */
+
 /**
- * @defgroup SSD1306_HW_SPEC SSD1306 Hardware Pins Definition.
- * Pin configurations of SSD1306 LCD module.
+ * @defgroup SSD1306_STATE_SPEC SSD1306 power up state.
+ * Progress of @ref SSD1306_INIT_SPEC sequence, GDDRAM data is held back
+ * until display is ready.
  *
  * @{
+ */
+/** @brief Power up state */
+static ssd1306_state_t ssd1306_state = SSD1306_STATE_POWER_UP;
+/** @brief Display VCC connection state */
+static uint8_t ssd1306_vcc_state;
+/** @} */ /* SSD1306_STATE_SPEC */
+
+/**
+ * @defgroup SSD1306_LAYER_BUFFER_SPEC SSD1306  display buffers.
+ * This will act as LAYER1 and LAYER2 for display.
  *
- *    | PIN No. | SSD1306 PIN   | PIN ID    |  MCU  |
- *    |---------|---------------|-----------|-------|
- *    |    1    | GND           |  0 V      |  GND  |
- *    |    2    | VCC           |  3.3 V    |  VCC  |
- *    |    3    | CLOCK         |  C        |  SCK  |
- *    |    4    | DATA          |  D        |  MOSI |
- *    |    5    | RESET         |  ST       |  RST  |
- *    |    6    | DATA/CMD      |  D/C      |  CMD  |
- *    |    7    | CHIP SELECT   |  CS       |  NSS  |
+ * @{
  */
-#define SSD1306_PIN_CS            GPIOG, GPIO_PIN_14  /**< Chip Select Pin    */
-#define SSD1306_PIN_DC            GPIOH, GPIO_PIN_2   /**< Data / CMD Pin     */
-#define SSD1306_PIN_RST           GPIOC, GPIO_PIN_7   /**< Display Reset Pin  */
-/** @} */ /* SSD1306_HW_SPEC */
+/** @brief Layer 1 (or default) display buffer */
+static uint8_t ssd1306_buffer_layer1[SSD1306_DISPLAY_WIDTH *     \
+                              SSD1306_DISPLAY_HEIGHT / 8] __attribute__((aligned(4)));
+#if ( SSD1306_MULTILAYER_SUPPORT == I2_ENABLE )
+/** @brief Layer 2 display buffer when multi-layer display is enabled */
+static uint8_t ssd1306_buffer_layer2[SSD1306_DISPLAY_WIDTH *    \
+                                     SSD1306_DISPLAY_HEIGHT / 8] __attribute__((aligned(4)));
+/** @brief Layers composed together, this is what gets displayed */
+static uint8_t ssd1306_buffer_output[SSD1306_DISPLAY_WIDTH *    \
+                                     SSD1306_DISPLAY_HEIGHT / 8] __attribute__((aligned(4)));
+/** @brief Blend mode of layer 1 over layer 2 */
+static uint8_t ssd1306_blend_mode = SSD1306_BLEND_OR;
+#endif /* SSD1306_MULTILAYER_SUPPORT */
+/** @} */ /* SSD1306_LAYER_BUFFER_SPEC */
 
 /**
- * @defgroup SSD1306_SPI_SPEC SSD1306 SPI instance.
- * SPI interface and Chip Select definition.
+ * @defgroup SSD1306_DIRTY_SPEC SSD1306 dirty region tracking.
+ * Column range of every page modified since last refresh, a page is clean
+ * when its first dirty column is past its last dirty column.
  *
  * @{
  */
-/** @brief ssd1306 display control instance */
-static i2_spi_inst_t ssd1306 = {
-  "ssd1306", "SPI1", { "ssd1306_CS", SSD1306_PIN_CS }
-};
-/** @} */ /* SSD1306_SPI_SPEC */
+#define SSD1306_DIRTY_CLEAN_FIRST   ( 0xFF )  /**< First column of clean page */
+#define SSD1306_DIRTY_CLEAN_LAST    ( 0x00 )  /**< Last column of clean page  */
+/** Bytes worth sending instead of opening a new refresh window */
+#define SSD1306_WINDOW_OVERHEAD     ( 8 )
+/** @brief First dirty column of each page */
+static uint8_t ssd1306_dirty_first[SSD1306_DISPLAY_PAGES];
+/** @brief Last dirty column of each page */
+static uint8_t ssd1306_dirty_last[SSD1306_DISPLAY_PAGES];
+/** @} */ /* SSD1306_DIRTY_SPEC */
 
 /**
- * @defgroup SSD1306_PIN_SPEC SSD1306 GPIO pins definition.
- * DC and RST Pins Definitions for SSD1306 Interface.
+ * @defgroup SSD1306_GLYPH_CACHE_SPEC SSD1306 scaled glyph cache.
+ * Recently used glyphs expanded to larger text sizes.
  *
  * @{
  */
-/** @brief Display (DC) pin GPIO instance initialization */
-static i2_gpio_inst_t ssd1306_DC  = { "ssd1306_DC",   SSD1306_PIN_DC };
-/** @brief Display (RST) GPIO instance initialization */
-static i2_gpio_inst_t ssd1306_RST = { "ssd1306_RST",  SSD1306_PIN_RST };
-/** @} */ /* SSD1306_PIN_SPEC */
+#define SSD1306_GLYPH_COLUMNS       ( 5 )     /**< Font columns per glyph   */
+#if ( SSD1306_GLYPH_CACHE_MAX_SCALE > 4 )
+#error "Scaled glyph columns are limited to 32 pixels"
+#endif /* SSD1306_GLYPH_CACHE_MAX_SCALE */
+/** @brief Scaled glyph */
+typedef struct {
+  uint16_t  c;                              /**< Character                */
+  uint8_t   size;                           /**< Scale, 0 for empty entry */
+  uint32_t  column[SSD1306_GLYPH_COLUMNS];  /**< Expanded columns         */
+} ssd1306_glyph_t;
+/** @brief Scaled glyph cache */
+static ssd1306_glyph_t ssd1306_glyph_cache[SSD1306_GLYPH_CACHE_SIZE];
+/** @brief Next glyph cache entry to replace */
+static uint8_t ssd1306_glyph_next;
+/** @} */ /* SSD1306_GLYPH_CACHE_SPEC */
 
 /**
- * @defgroup SSD1306_LAYER_BUFFER_SPEC SSD1306  display buffers.
- * This will act as LAYER1 and LAYER2 for display.
+ * @brief   Marks columns of a page as dirty.
+ * @details Grows dirty column range of page, columns must be on screen.
+ *
+ * @param[in] page    Display page (0..7).
+ * @param[in] first   First modified column.
+ * @param[in] last    Last modified column.
+ * @return  None.
+ */
+static inline void ssd1306_dirty_columns(uint8_t page,
+                                         uint8_t first, uint8_t last)
+{
+  if (first < ssd1306_dirty_first[page]) {
+    ssd1306_dirty_first[page] = first;
+  }
+  if (last > ssd1306_dirty_last[page]) {
+    ssd1306_dirty_last[page] = last;
+  }
+}
+
+#if ( SSD1306_DISPLAY_TASK_SUPPORT == I2_ENABLE )
+/**
+ * @defgroup SSD1306_FRONT_BUFFER_SPEC SSD1306 display task front buffer.
+ * Frame handed over to display task by @ref ssd1306_present, with its own
+ * dirty regions still to be sent.
  *
  * @{
  */
-/** @brief Layer 1 (or default) display buffer */
-static uint8_t ssd1306_buffer_layer1[SSD1306_DISPLAY_WIDTH *     \
-                              SSD1306_DISPLAY_HEIGHT / 8];
-#if ( SSD1306_MULTILAYER_SUPPORT == I2_ENABLE )
-/** @brief Layer 2 display buffer when multi-layer display is enabled */
-static uint8_t ssd1306_buffer_layer2[SSD1306_DISPLAY_WIDTH *    \
-                                     SSD1306_DISPLAY_HEIGHT / 8];
-#endif /* SSD1306_MULTILAYER_SUPPORT */
-/** @} */ /* SSD1306_LAYER_BUFFER_SPEC */
+/** @brief Front buffer streamed by display task */
+static uint8_t ssd1306_front[SSD1306_DISPLAY_WIDTH *
+                             SSD1306_DISPLAY_HEIGHT / 8];
+/** @brief First dirty column of each front buffer page */
+static uint8_t ssd1306_front_first[SSD1306_DISPLAY_PAGES];
+/** @brief Last dirty column of each front buffer page */
+static uint8_t ssd1306_front_last[SSD1306_DISPLAY_PAGES];
+/** @brief Front buffer and display bus ownership */
+static SemaphoreHandle_t ssd1306_front_mutex;
+/** @brief Display task handle */
+static TaskHandle_t ssd1306_task_handle;
+/** @} */ /* SSD1306_FRONT_BUFFER_SPEC */
+
+static void ssd1306_display_task(void *pvParameters);
+#endif /* SSD1306_DISPLAY_TASK_SUPPORT */
 
 /**
- * @brief   SPI write.
- * @details Writes a single byte to SPI.
+ * @brief   Takes ownership of display bus.
+ * @details Serializes display commands with display task streaming, no-op
+ *          without display task or before scheduler is started.
  *
- * @param[in] byte      data to send.
+ * @return  true if lock is taken and needs to be released.
+ */
+static inline bool ssd1306_lock(void)
+{
+#if ( SSD1306_DISPLAY_TASK_SUPPORT == I2_ENABLE )
+  if ( (ssd1306_front_mutex != NULL) &&
+       (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) ) {
+    xSemaphoreTake(ssd1306_front_mutex, portMAX_DELAY);
+    return true;
+  }
+#endif /* SSD1306_DISPLAY_TASK_SUPPORT */
+  return false;
+}
+
+/**
+ * @brief   Releases ownership of display bus.
+ * @details Counterpart of @ref ssd1306_lock.
+ *
+ * @param[in] locked  Value returned by @ref ssd1306_lock.
  * @return  None.
  */
-void ssd1306_write_byte(uint8_t byte)
+static inline void ssd1306_unlock(bool locked)
 {
-  if (i2_spi_tx(&ssd1306, I2_SPI_DATA_WIDTH_8BIT, I2_SPI_CLK_20_MHZ,
-      I2_SPI_MODE_0, I2_SPI_MSBIT_FIRST, &byte, 1,
-      SSD1306_SPI_TIMEOUT) == I2_SUCCESS) {
-    i2_assert(0);
+#if ( SSD1306_DISPLAY_TASK_SUPPORT == I2_ENABLE )
+  if (locked) {
+    xSemaphoreGive(ssd1306_front_mutex);
   }
+#else
+  (void)locked;
+#endif /* SSD1306_DISPLAY_TASK_SUPPORT */
+}
+
+/** @brief Display backend in use, see @ref ssd1306_set_backend */
+static const ssd1306_backend_t *ssd1306_backend;
+
+/**
+ * @brief   Starts a command batch.
+ * @details Empties batch, commands are then added with @ref ssd1306_cmd_add.
+ *
+ * @param[out] batch    Command batch.
+ * @return  None.
+ */
+void ssd1306_cmd_begin(ssd1306_cmd_batch_t *batch)
+{
+  batch->size = 0;
 }
 
 /**
- * @brief   SPI buffer write.
- * @details Writes data buffer over SPI.
+ * @brief   Adds a command byte to batch.
+ * @details Commands and their arguments are added byte by byte.
  *
- * @param[in] buff             Buffer to send.
- * @param[in] bytes_to_write   Number of bytes.
+ * @param[in] batch   Command batch.
+ * @param[in] cmd     Command or argument byte @ref SSD1306_CMD_SPEC.
  * @return  None.
  */
-void ssd1306_write_buffer(uint8_t* buff, uint16_t bytes_to_write)
+void ssd1306_cmd_add(ssd1306_cmd_batch_t *batch, uint8_t cmd)
 {
-  if (i2_spi_tx(&ssd1306, I2_SPI_DATA_WIDTH_8BIT, I2_SPI_CLK_20_MHZ,
-      I2_SPI_MODE_0, I2_SPI_MSBIT_FIRST, buff, bytes_to_write,
-      SSD1306_SPI_TIMEOUT) == I2_SUCCESS) {
+  if (batch->size >= SSD1306_CMD_BATCH_SIZE) {
     i2_assert(0);
+    return;
   }
+  batch->cmd[batch->size++] = cmd;
 }
 
 /**
- * @brief   Writes a command to display.
- * @details Asserts DC pin in command mode and writes SPI byte.
+ * @brief   Adds GDDRAM addressing window to batch.
+ * @details Following data writes fill window in horizontal addressing mode.
  *
- * @param[in] c     Command to write.
+ * @param[in] batch       Command batch.
+ * @param[in] first_page  First page of window.
+ * @param[in] last_page   Last page of window.
+ * @param[in] first_col   First column of window.
+ * @param[in] last_col    Last column of window.
  * @return  None.
  */
-#define SSD1306_CMD(c)    do {  \
-                            i2_gpio_set(&ssd1306_DC, I2_LOW); \
-                            ssd1306_write_byte( c );  \
-                          } while (0);
+void ssd1306_cmd_add_window(ssd1306_cmd_batch_t *batch,
+                            uint8_t first_page, uint8_t last_page,
+                            uint8_t first_col, uint8_t last_col)
+{
+  ssd1306_cmd_add(batch, SSD1306_CMD_SET_COLUMN_ADDR);
+  ssd1306_cmd_add(batch, first_col);
+  ssd1306_cmd_add(batch, last_col);
+  ssd1306_cmd_add(batch, SSD1306_CMD_SET_PAGE_ADDR);
+  ssd1306_cmd_add(batch, first_page);
+  ssd1306_cmd_add(batch, last_page);
+}
 
 /**
- * @brief   Writes a data byte to display.
- * @details Asserts DC pin in data mode and writes SPI byte.
+ * @brief   Adds display on or off to batch.
+ * @details Display pixels are turned on or off, GDDRAM is kept.
  *
- * @param[in] d     Data byte to write.
+ * @param[in] batch   Command batch.
+ * @param[in] on      Turn display on if true, off otherwise.
  * @return  None.
  */
-#define SSD1306_DATA(d)   do {  \
-                            i2_gpio_set(&ssd1306_DC, I2_HIGH);  \
-                            ssd1306_write_byte( d );  \
-                          } while (0);  \
+void ssd1306_cmd_add_display(ssd1306_cmd_batch_t *batch, bool on)
+{
+  ssd1306_cmd_add(batch, on ? SSD1306_CMD_DISPLAY_ON :
+                              SSD1306_CMD_DISPLAY_OFF);
+}
+
+/**
+ * @brief   Writes a command batch without taking display bus.
+ * @details For callers already owning display bus.
+ *
+ * @param[in] batch   Command batch.
+ * @return  None.
+ */
+static inline void ssd1306_cmd_write(const ssd1306_cmd_batch_t *batch)
+{
+  if (batch->size) {
+    ssd1306_backend->write_cmd(batch->cmd, batch->size);
+  }
+}
+
+/**
+ * @brief   Selects display backend.
+ * @details Must be called before @ref ssd1306_init, e.g. with
+ *          ssd1306_spi_backend on target or a display emulator on host.
+ *
+ * @param[in] backend   Backend to use.
+ * @return  None.
+ */
+void ssd1306_set_backend(const ssd1306_backend_t *backend)
+{
+  ssd1306_backend = backend;
+}
+
+/**
+ * @brief   Runs power up sequence to its end.
+ * @details Waits between steps through display backend.
+ *
+ * @return  None.
+ */
+static void ssd1306_init_run(void)
+{
+  uint32_t wait_ms;
+
+  while (!ssd1306_init_step(&wait_ms)) {
+    ssd1306_backend->delay(wait_ms);
+  }
+}
+
+/**
+ * @brief   Makes sure display is ready before bus access.
+ * @details Completes power up sequence when a command is sent before the
+ *          display task got to it. Called with display bus lock held.
+ *
+ * @return  None.
+ */
+static inline void ssd1306_ready_wait(void)
+{
+  if (ssd1306_state != SSD1306_STATE_READY) {
+    ssd1306_init_run();
+  }
+}
+
+/**
+ * @brief   Sends a command batch.
+ * @details Whole batch goes out as a single bus write, after power up
+ *          sequence is done.
+ *
+ * @param[in] batch   Command batch.
+ * @return  None.
+ */
+void ssd1306_cmd_send(ssd1306_cmd_batch_t *batch)
+{
+  bool locked = ssd1306_lock();
+  ssd1306_ready_wait();
+  ssd1306_cmd_write(batch);
+  ssd1306_unlock(locked);
+}
+
+/**
+ * @brief   Starts SSD1306 power up sequence.
+ * @details Sets up display backend, sequence is then advanced by
+ *          @ref ssd1306_init_step.
+ *
+ * @param[in] vcc_state   Display VCC connection state.
+ * @return  None.
+ */
+void ssd1306_init_start(uint8_t vcc_state)
+{
+  i2_assert(ssd1306_backend != NULL);
+
+  ssd1306_vcc_state = vcc_state;
+  ssd1306_state = SSD1306_STATE_POWER_UP;
+  ssd1306_backend->init();
+}
+
+/**
+ * @brief   Advances SSD1306 power up sequence.
+ * @details Performs next step of @ref SSD1306_INIT_SPEC sequence without
+ *          waiting. Display task drives the steps when it is enabled.
+ *
+ * @param[out] wait_ms    Time to wait before next step in ms.
+ * @return  true once display is ready.
+ */
+bool ssd1306_init_step(uint32_t *wait_ms)
+{
+  ssd1306_cmd_batch_t batch;
+
+  *wait_ms = 0;
+
+  switch (ssd1306_state) {
+  case SSD1306_STATE_POWER_UP :
+    /* VDD (3.3V) goes high at start, lets just chill for a ms */
+    ssd1306_backend->reset(false);
+    *wait_ms = SSD1306_POWER_UP_DELAY_MS;
+    ssd1306_state = SSD1306_STATE_RESET;
+    break;
+  case SSD1306_STATE_RESET :
+    ssd1306_backend->reset(true);
+    *wait_ms = SSD1306_RESET_PULSE_MS;
+    ssd1306_state = SSD1306_STATE_RESET_RELEASE;
+    break;
+  case SSD1306_STATE_RESET_RELEASE :
+    ssd1306_backend->reset(false);
+    *wait_ms = SSD1306_RESET_RECOVERY_MS;
+    ssd1306_state = SSD1306_STATE_CONFIG;
+    break;
+  case SSD1306_STATE_CONFIG :
+    /* Initialization sequence @ref SSD1306_CMD_SPEC */
+    ssd1306_cmd_begin(&batch);
+    ssd1306_cmd_add(&batch, SSD1306_CMD_DISPLAY_OFF);
+    ssd1306_cmd_add(&batch, SSD1306_CMD_SET_CLOCK_DIV_AND_FREQ);
+    ssd1306_cmd_add(&batch, SSD1306_CUSTOM_FREQ);
+    ssd1306_cmd_add(&batch, SSD1306_CMD_SET_MULTIPLEX);
+    ssd1306_cmd_add(&batch, SSD1306_DISPLAY_HEIGHT - 1);
+    ssd1306_cmd_add(&batch, SSD1306_CMD_DISPLAY_SET_OFFSET);
+    ssd1306_cmd_add(&batch, SSD1306_OFFSET_NULL);
+    ssd1306_cmd_add(&batch, SSD1306_CMD_SET_START_LINE | SSD1306_LINE_0);
+    ssd1306_cmd_add(&batch, SSD1306_CMD_CHARGE_PUMP);
+    if (ssd1306_vcc_state == SSD1306_CMD_EXTERNAL_VCC) {
+      ssd1306_cmd_add(&batch, SSD1306_CHARGE_PUMP_DISABLE);
+    } else {
+      ssd1306_cmd_add(&batch, SSD1306_CHARGE_PUMP_ENABLE);
+    }
+
+    ssd1306_cmd_add(&batch, SSD1306_CMD_MEMORY_ADDRESSING_MODE);
+    ssd1306_cmd_add(&batch, SSD1306_HORIZONTAL_ADDRESSING_MODE);
+    ssd1306_cmd_add(&batch, SSD1306_CMD_SEGMENT_REMAP |
+                            SSD1306_SEGMENT_REMAP_COL_127);
+    ssd1306_cmd_add(&batch, SSD1306_CMD_COM_SCAN_DEC);
+    ssd1306_cmd_add(&batch, SSD1306_CMD_SET_COM_PINS);
+    ssd1306_cmd_add(&batch, SSD1306_COM_PINS_ALT |
+                            SSD1306_COM_PINS_DISABLE_REMAP);
+    ssd1306_cmd_add(&batch, SSD1306_CMD_SET_CONTRAST);
+    if (ssd1306_vcc_state == SSD1306_CMD_EXTERNAL_VCC) {
+      ssd1306_cmd_add(&batch, SSD1306_EXTERNAL_VCC_CONTRAST);
+    } else {
+      ssd1306_cmd_add(&batch, SSD1306_SWITCH_CAP_VCC_CONTRAST);
+    }
+
+    ssd1306_cmd_add(&batch, SSD1306_CMD_SET_PRECHARGE);
+    if (ssd1306_vcc_state == SSD1306_CMD_EXTERNAL_VCC) {
+      ssd1306_cmd_add(&batch, SSD1306_PRECHARGE_PHASE1_DEFAULT |
+                              SSD1306_PRECHARGE_PHASE2_DEFAULT);
+    } else {
+      ssd1306_cmd_add(&batch, SSD1306_PRECHARGE_PHASE1_CUSTOM |
+                              SSD1306_PRECHARGE_PHASE2_CUSTOM);
+    }
+
+    ssd1306_cmd_add(&batch, SSD1306_CMD_SET_VCOM_DETECT);
+    ssd1306_cmd_add(&batch, SSD1306_VCOM_DEFAULT);
+    ssd1306_cmd_add(&batch, SSD1306_CMD_DISPLAY_ALLON_RESUME);
+    ssd1306_cmd_add(&batch, SSD1306_CMD_DISPLAY_NORMAL);
+    ssd1306_cmd_add(&batch, SSD1306_DEACTIVATE_SCROLL);
+    ssd1306_cmd_add_display(&batch, true);
+    ssd1306_cmd_write(&batch);
+
+    /* GDDRAM content is unknown after reset, next flush sends everything */
+#if ( SSD1306_DISPLAY_TASK_SUPPORT == I2_ENABLE )
+    memset(ssd1306_front_first, 0, sizeof(ssd1306_front_first));
+    memset(ssd1306_front_last, SSD1306_DISPLAY_WIDTH - 1,
+           sizeof(ssd1306_front_last));
+#else
+    ssd1306_mark_dirty(0, 0, SSD1306_DISPLAY_HEIGHT, SSD1306_DISPLAY_WIDTH);
+#endif /* SSD1306_DISPLAY_TASK_SUPPORT */
+    ssd1306_state = SSD1306_STATE_READY;
+    break;
+  case SSD1306_STATE_READY :
+  default :
+    break;
+  }
+
+  return (ssd1306_state == SSD1306_STATE_READY);
+}
+
+/**
+ * @brief   Checks SSD1306 power up state.
+ * @details Display accepts GDDRAM data once power up sequence is done.
+ *
+ * @return  true if display is ready.
+ */
+bool ssd1306_is_ready(void)
+{
+  return (ssd1306_state == SSD1306_STATE_READY);
+}
 
 /**
  * @brief   Initializes SSD1306 LCD display.
  * @details Initialize Hardware for SPI and GPIO also LCD reset sequence.
+ *          With display task enabled, display task steps through reset
+ *          sequence and this returns right away, frames refreshed until
+ *          then are sent once display is ready.
  *
  * @param[in] vcc_state   Display VCC connection state.
  * @return  None.
  */
 void ssd1306_init(uint8_t vcc_state)
 {
-  if (i2_gpio_is_valid(&ssd1306_DC)) {
-    i2_gpio_config_out(&ssd1306_DC, false);
+  ssd1306_init_start(vcc_state);
+
+#if ( SSD1306_DISPLAY_TASK_SUPPORT == I2_ENABLE )
+  if (ssd1306_task_handle == NULL) {
+    memset(ssd1306_front_first, SSD1306_DIRTY_CLEAN_FIRST,
+           sizeof(ssd1306_front_first));
+    memset(ssd1306_front_last, SSD1306_DIRTY_CLEAN_LAST,
+           sizeof(ssd1306_front_last));
+    ssd1306_front_mutex = xSemaphoreCreateMutex();
+    i2_assert(ssd1306_front_mutex != NULL);
+    if (xTaskCreate(ssd1306_display_task, "ssd1306",
+                    SSD1306_DISPLAY_TASK_STACK, NULL,
+                    SSD1306_DISPLAY_TASK_PRIORITY,
+                    &ssd1306_task_handle) != pdPASS) {
+      i2_assert(0);
+    }
   }
+#else
+  ssd1306_init_run();
+#endif /* SSD1306_DISPLAY_TASK_SUPPORT */
+}
 
-  if (i2_gpio_is_valid(&ssd1306_RST)) {
-    i2_gpio_config_out(&ssd1306_RST, false);
+/**
+ * @brief   Sends a window of pixel buffer to the LCD.
+ * @details Sets column and page address window, then streams window data as
+ *          a single backend data write with one segment per page, or a
+ *          single segment when window spans full display width.
+ *
+ * @param[in] buffer      Pixel buffer to send from.
+ * @param[in] first_page  First page of window.
+ * @param[in] last_page   Last page of window.
+ * @param[in] first_col   First column of window.
+ * @param[in] last_col    Last column of window.
+ * @return  None.
+ */
+static void ssd1306_refresh_window(uint8_t *buffer,
+                                   uint8_t first_page, uint8_t last_page,
+                                   uint8_t first_col, uint8_t last_col)
+{
+  ssd1306_cmd_batch_t batch;
+  ssd1306_segment_t segments[SSD1306_DISPLAY_PAGES];
+  uint16_t width = last_col - first_col + 1;
+  uint8_t count = 0;
+  uint8_t page;
+
+  ssd1306_cmd_begin(&batch);
+  ssd1306_cmd_add_window(&batch, first_page, last_page, first_col, last_col);
+  ssd1306_cmd_write(&batch);
+
+  if (width == SSD1306_DISPLAY_WIDTH) {
+    segments[count].data = buffer + (first_page * SSD1306_DISPLAY_WIDTH);
+    segments[count].size = (last_page - first_page + 1) *
+                           SSD1306_DISPLAY_WIDTH;
+    count++;
+  } else {
+    for (page = first_page; page <= last_page; page++) {
+      segments[count].data = buffer + (page * SSD1306_DISPLAY_WIDTH) +
+                             first_col;
+      segments[count].size = width;
+      count++;
+    }
   }
 
-  /* Initialize SPI interface */
-  i2_spi_init(&ssd1306);
+  ssd1306_backend->write_data(segments, count);
+}
 
-  /* Start Initialization by bringing RESET HIGH */
-  i2_gpio_set(&ssd1306_RST, I2_HIGH);
-  /* VDD (3.3V) goes high at start, lets just chill for a ms */
-  ssd1306_delay(2);
+/**
+ * @brief   Sends dirty regions of a pixel buffer to the LCD.
+ * @details Runs of adjacent dirty pages are merged into one window as long as
+ *          the extra columns cost less than a new window. Dirty regions are
+ *          cleared once sent, and kept until display is ready.
+ *
+ * @param[in] buffer      Pixel buffer to send from.
+ * @param[in] dirty_first First dirty column of each page.
+ * @param[in] dirty_last  Last dirty column of each page.
+ * @return  None.
+ */
+static void ssd1306_flush(uint8_t *buffer,
+                          uint8_t *dirty_first, uint8_t *dirty_last)
+{
+  uint8_t page = 0;
+  uint8_t start, first, last;
+  uint8_t next_first, next_last;
+  int32_t merged, separate;
 
-  /* Bring RESET LOW */
-  i2_gpio_set(&ssd1306_RST, I2_LOW);
-  ssd1306_delay(1);
+  if (ssd1306_state != SSD1306_STATE_READY) {
+    return;
+  }
 
-  /* Bring RESET HIGH */
-  i2_gpio_set(&ssd1306_RST, I2_HIGH);
-  ssd1306_delay(2);
+  while (page < SSD1306_DISPLAY_PAGES) {
+    if (dirty_first[page] > dirty_last[page]) {
+      page++;
+      continue;
+    }
 
-  /* Initialization sequence @ref SSD1306_CMD_SPEC */
-  SSD1306_CMD(SSD1306_CMD_DISPLAY_OFF);
-  SSD1306_CMD(SSD1306_CMD_SET_CLOCK_DIV_AND_FREQ);
-  SSD1306_CMD(SSD1306_CUSTOM_FREQ);
-  SSD1306_CMD(SSD1306_CMD_SET_MULTIPLEX);
-  SSD1306_CMD(SSD1306_DISPLAY_HEIGHT - 1);
-  SSD1306_CMD(SSD1306_CMD_DISPLAY_SET_OFFSET);
-  SSD1306_CMD(SSD1306_OFFSET_NULL);
-  SSD1306_CMD(SSD1306_CMD_SET_START_LINE | SSD1306_LINE_0);
-  SSD1306_CMD(SSD1306_CMD_CHARGE_PUMP);
-  if (vcc_state == SSD1306_CMD_EXTERNAL_VCC) {
-    SSD1306_CMD(SSD1306_CHARGE_PUMP_DISABLE);
-  } else {
-    SSD1306_CMD(SSD1306_CHARGE_PUMP_ENABLE);
-  }
-
-  SSD1306_CMD(SSD1306_CMD_MEMORY_ADDRESSING_MODE);
-  SSD1306_CMD(SSD1306_HORIZONTAL_ADDRESSING_MODE);
-  SSD1306_CMD(SSD1306_CMD_SEGMENT_REMAP | SSD1306_SEGMENT_REMAP_COL_127);
-  SSD1306_CMD(SSD1306_CMD_COM_SCAN_DEC);
-  SSD1306_CMD(SSD1306_CMD_SET_COM_PINS);
-  SSD1306_CMD(SSD1306_COM_PINS_ALT | SSD1306_COM_PINS_DISABLE_REMAP);
-  SSD1306_CMD(SSD1306_CMD_SET_CONTRAST);
-  if (vcc_state == SSD1306_CMD_EXTERNAL_VCC) {
-    SSD1306_CMD(SSD1306_EXTERNAL_VCC_CONTRAST);
-  } else {
-    SSD1306_CMD(SSD1306_SWITCH_CAP_VCC_CONTRAST);
+    start = page;
+    first = dirty_first[page];
+    last  = dirty_last[page];
+    for (page++; page < SSD1306_DISPLAY_PAGES; page++) {
+      if (dirty_first[page] > dirty_last[page]) {
+        break;
+      }
+      next_first = SSD1306_MIN(first, dirty_first[page]);
+      next_last  = SSD1306_MAX(last, dirty_last[page]);
+      merged   = (page - start + 1) * (next_last - next_first + 1);
+      separate = (page - start) * (last - first + 1) +
+                 (dirty_last[page] - dirty_first[page] + 1) +
+                 SSD1306_WINDOW_OVERHEAD;
+      if (merged > separate) {
+        break;
+      }
+      first = next_first;
+      last  = next_last;
+    }
+
+    ssd1306_refresh_window(buffer, start, page - 1, first, last);
   }
 
-  SSD1306_CMD(SSD1306_CMD_SET_PRECHARGE);
-  if (vcc_state == SSD1306_CMD_EXTERNAL_VCC) {
-    SSD1306_CMD(SSD1306_PRECHARGE_PHASE1_DEFAULT |
-                SSD1306_PRECHARGE_PHASE2_DEFAULT);
-  } else {
-    SSD1306_CMD(SSD1306_PRECHARGE_PHASE1_CUSTOM |
-                SSD1306_PRECHARGE_PHASE2_CUSTOM);
+  memset(dirty_first, SSD1306_DIRTY_CLEAN_FIRST, SSD1306_DISPLAY_PAGES);
+  memset(dirty_last, SSD1306_DIRTY_CLEAN_LAST, SSD1306_DISPLAY_PAGES);
+}
+
+#if ( SSD1306_MULTILAYER_SUPPORT == I2_ENABLE )
+/**
+ * @brief   Loads a word of pixel buffer.
+ * @details Compiles to a single word load, without breaking type aliasing.
+ *
+ * @param[in] src     Pixel buffer bytes.
+ * @return  Four pixel buffer bytes.
+ */
+static inline uint32_t ssd1306_load32(const uint8_t *src)
+{
+  uint32_t word;
+  memcpy(&word, src, sizeof(word));
+  return word;
+}
+
+/**
+ * @brief   Stores a word of pixel buffer.
+ * @details Counterpart of @ref ssd1306_load32.
+ *
+ * @param[out] dst    Pixel buffer bytes.
+ * @param[in]  word   Four pixel buffer bytes.
+ * @return  None.
+ */
+static inline void ssd1306_store32(uint8_t *dst, uint32_t word)
+{
+  memcpy(dst, &word, sizeof(word));
+}
+
+/**
+ * @brief   Composes columns of a page into output buffer.
+ * @details Layer 1 is blended over layer 2, 32 pixels (four columns) per
+ *          step. Column range is widened to whole words. Layers are left
+ *          untouched.
+ *
+ * @param[in] page    Display page (0..7).
+ * @param[in] first   First column to compose.
+ * @param[in] last    Last column to compose.
+ * @return  None.
+ */
+static void ssd1306_compose(uint8_t page, uint8_t first, uint8_t last)
+{
+  uint16_t offset = (page * SSD1306_DISPLAY_WIDTH) + (first & ~0x3);
+  uint16_t end    = (page * SSD1306_DISPLAY_WIDTH) + (last | 0x3) + 1;
+  uint32_t top, bottom;
+
+  for (; offset < end; offset += 4) {
+    top    = ssd1306_load32(&ssd1306_buffer_layer1[offset]);
+    bottom = ssd1306_load32(&ssd1306_buffer_layer2[offset]);
+    switch (ssd1306_blend_mode) {
+    case SSD1306_BLEND_AND :
+      bottom &= top;
+      break;
+    case SSD1306_BLEND_XOR :
+      bottom ^= top;
+      break;
+    case SSD1306_BLEND_MASK :
+      bottom &= ~top;
+      break;
+    case SSD1306_BLEND_OR :
+    default :
+      bottom |= top;
+      break;
+    }
+    ssd1306_store32(&ssd1306_buffer_output[offset], bottom);
   }
+}
+#endif /* SSD1306_MULTILAYER_SUPPORT */
 
-  SSD1306_CMD(SSD1306_CMD_SET_VCOM_DETECT);
-  SSD1306_CMD(SSD1306_VCOM_DEFAULT);
-  SSD1306_CMD(SSD1306_CMD_DISPLAY_ALLON_RESUME);
-  SSD1306_CMD(SSD1306_CMD_DISPLAY_NORMAL);
-  SSD1306_CMD(SSD1306_DEACTIVATE_SCROLL);
-  ssd1306_turn_on();
+/**
+ * @brief   Gets pixel buffer to be displayed.
+ * @details Composes dirty regions of layers when multi-layer display is
+ *          enabled.
+ *
+ * @return  Pixel buffer holding the frame to display.
+ */
+static uint8_t* ssd1306_frame(void)
+{
+#if ( SSD1306_MULTILAYER_SUPPORT == I2_ENABLE )
+  uint8_t page;
+
+  for (page = 0; page < SSD1306_DISPLAY_PAGES; page++) {
+    if (ssd1306_dirty_first[page] <= ssd1306_dirty_last[page]) {
+      ssd1306_compose(page, ssd1306_dirty_first[page],
+                      ssd1306_dirty_last[page]);
+    }
+  }
+  return ssd1306_buffer_output;
+#else
+  return ssd1306_buffer_layer1;
+#endif /* SSD1306_MULTILAYER_SUPPORT */
 }
 
 /**
  * @brief   Renders the contents of the pixel buffer on the LCD.
- * @details Picks data from the two layers buffer.
+ * @details Picks data from the two layers buffer and sends only the dirty
+ *          regions. With display task enabled this is @ref ssd1306_present.
  *
  * @return  None.
  */
 void ssd1306_refresh(void)
 {
-  SSD1306_CMD(SSD1306_CMD_SET_LOW_COLUMN  | 0x0);    /* Low Column = 0 */
-  SSD1306_CMD(SSD1306_CMD_SET_HIGH_COLUMN | 0x0);    /* High Column = 0 */
-  SSD1306_CMD(SSD1306_CMD_SET_START_LINE  | 0x0);    /* Line Number = 0*/
+#if ( SSD1306_DISPLAY_TASK_SUPPORT == I2_ENABLE )
+  ssd1306_present();
+#else
+  ssd1306_flush(ssd1306_frame(), ssd1306_dirty_first, ssd1306_dirty_last);
+#endif /* SSD1306_DISPLAY_TASK_SUPPORT */
+}
 
-  i2_gpio_set(&ssd1306_DC, I2_HIGH);
-#if ( SSD1306_MULTILAYER_SUPPORT == I2_ENABLE )
-  ssd1306_mix_frame_buffer();
-  ssd1306_write_buffer( (uint8_t *)ssd1306_buffer_layer2,
-                        sizeof(ssd1306_buffer_layer2));
+/**
+ * @brief   Hands over drawn frame for display.
+ * @details With display task enabled, dirty regions are copied into front
+ *          buffer and display task streams them over SPI DMA, at most
+ *          @ref SSD1306_DISPLAY_TASK_FPS frames per second, while caller
+ *          continues drawing. Blocks only while a previous frame is on the
+ *          bus. Before scheduler is started frame is sent synchronously,
+ *          or by display task once display is ready.
+ *          Without display task this is @ref ssd1306_refresh.
+ *
+ * @return  None.
+ */
+void ssd1306_present(void)
+{
+#if ( SSD1306_DISPLAY_TASK_SUPPORT == I2_ENABLE )
+  uint8_t *buffer;
+  uint8_t page;
+  uint32_t offset;
+  bool locked;
+
+  locked = ssd1306_lock();
+  buffer = ssd1306_frame();
+  for (page = 0; page < SSD1306_DISPLAY_PAGES; page++) {
+    if (ssd1306_dirty_first[page] > ssd1306_dirty_last[page]) {
+      continue;
+    }
+    offset = (page * SSD1306_DISPLAY_WIDTH) + ssd1306_dirty_first[page];
+    memcpy(ssd1306_front + offset, buffer + offset,
+           ssd1306_dirty_last[page] - ssd1306_dirty_first[page] + 1);
+    ssd1306_front_first[page] = SSD1306_MIN(ssd1306_front_first[page],
+                                            ssd1306_dirty_first[page]);
+    ssd1306_front_last[page]  = SSD1306_MAX(ssd1306_front_last[page],
+                                            ssd1306_dirty_last[page]);
+  }
+  memset(ssd1306_dirty_first, SSD1306_DIRTY_CLEAN_FIRST,
+         sizeof(ssd1306_dirty_first));
+  memset(ssd1306_dirty_last, SSD1306_DIRTY_CLEAN_LAST,
+         sizeof(ssd1306_dirty_last));
+
+  if (locked) {
+    ssd1306_unlock(locked);
+    xTaskNotifyGive(ssd1306_task_handle);
+  } else {
+    ssd1306_flush(ssd1306_front, ssd1306_front_first, ssd1306_front_last);
+  }
 #else
-  ssd1306_write_buffer( (uint8_t *)ssd1306_buffer_layer1,
-                        sizeof(ssd1306_buffer_layer1));
-#endif /* SSD1306_MULTILAYER_SUPPORT */
+  ssd1306_refresh();
+#endif /* SSD1306_DISPLAY_TASK_SUPPORT */
+}
+
+#if ( SSD1306_DISPLAY_TASK_SUPPORT == I2_ENABLE )
+/**
+ * @brief   Display service task.
+ * @details Steps through power up sequence, then waits for presented frames
+ *          and streams front buffer dirty regions, keeping frames at least
+ *          1 / @ref SSD1306_DISPLAY_TASK_FPS apart.
+ *          Frames presented meanwhile are merged into the next one.
+ *
+ * @param[in] pvParameters    Unused.
+ * @return  None.
+ */
+static void ssd1306_display_task(void *pvParameters)
+{
+  const TickType_t period = pdMS_TO_TICKS(1000 / SSD1306_DISPLAY_TASK_FPS);
+  TickType_t last = xTaskGetTickCount() - period;
+  TickType_t elapsed;
+  bool locked;
+
+  uint32_t wait_ms;
+  bool ready;
+
+  (void)pvParameters;
+
+  /* Step through power up, bus is released while waiting between steps */
+  do {
+    locked = ssd1306_lock();
+    ready = ssd1306_init_step(&wait_ms);
+    if (ready) {
+      ssd1306_flush(ssd1306_front, ssd1306_front_first, ssd1306_front_last);
+    }
+    ssd1306_unlock(locked);
+    ssd1306_backend->delay(wait_ms);
+  } while (!ready);
+
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    elapsed = xTaskGetTickCount() - last;
+    if (elapsed < period) {
+      vTaskDelay(period - elapsed);
+    }
+    last = xTaskGetTickCount();
+
+    locked = ssd1306_lock();
+    ssd1306_flush(ssd1306_front, ssd1306_front_first, ssd1306_front_last);
+    ssd1306_unlock(locked);
+  }
+}
+#endif /* SSD1306_DISPLAY_TASK_SUPPORT */
+
+/**
+ * @brief   Marks a display region for next refresh.
+ * @details Needed only when pixel buffer is modified outside of drawing
+ *          functions, drawing functions track their own changes.
+ *
+ * @param[in] y       (y) coordinate of region beginning.
+ * @param[in] x       (x) coordinate of region beginning.
+ * @param[in] h       Height of region.
+ * @param[in] w       Width of region.
+ * @return  None.
+ */
+void ssd1306_mark_dirty(int16_t y, int16_t x, int16_t h, int16_t w)
+{
+  int16_t y1 = SSD1306_MIN(y + h, SSD1306_DISPLAY_HEIGHT) - 1;
+  int16_t x1 = SSD1306_MIN(x + w, SSD1306_DISPLAY_WIDTH) - 1;
+  int16_t page;
+
+  y = SSD1306_MAX(y, 0);
+  x = SSD1306_MAX(x, 0);
+  if ((y > y1) || (x > x1)) {
+    return;
+  }
+
+  for (page = (y / 8); page <= (y1 / 8); page++) {
+    ssd1306_dirty_columns(page, x, x1);
+  }
 }
 
 /**
@@ -260,7 +841,11 @@ void ssd1306_refresh(void)
  */
 void ssd1306_turn_on(void)
 {
-  SSD1306_CMD(SSD1306_CMD_DISPLAY_ON);
+  ssd1306_cmd_batch_t batch;
+
+  ssd1306_cmd_begin(&batch);
+  ssd1306_cmd_add_display(&batch, true);
+  ssd1306_cmd_send(&batch);
 }
 
 /**
@@ -271,7 +856,11 @@ void ssd1306_turn_on(void)
  */
 void ssd1306_turn_off(void)
 {
-  SSD1306_CMD(SSD1306_CMD_DISPLAY_OFF);
+  ssd1306_cmd_batch_t batch;
+
+  ssd1306_cmd_begin(&batch);
+  ssd1306_cmd_add_display(&batch, false);
+  ssd1306_cmd_send(&batch);
 }
 
 /**
@@ -293,6 +882,8 @@ void ssd1306_draw_pixel(int16_t y, int16_t x, uint16_t color, uint16_t layer)
     return;
   }
 
+  ssd1306_dirty_columns(y / 8, x, x);
+
   if (layer & SSD1306_LAYER1) {
     switch (color) {
     case SSD1306_WHITE :
@@ -366,6 +957,8 @@ void ssd1306_clear_pixel(int16_t y, int16_t x)
     return;
   }
 
+  ssd1306_dirty_columns(y / 8, x, x);
+
 #if ( SSD1306_MULTILAYER_SUPPORT == I2_ENABLE )
   ssd1306_buffer_layer1[x+ (y/8) * SSD1306_DISPLAY_WIDTH] &= ~(1 << y%8);
   ssd1306_buffer_layer2[x+ (y/8) * SSD1306_DISPLAY_WIDTH] &= ~(1 << y%8);
@@ -416,6 +1009,7 @@ void ssd1306_clear_char(int16_t y, int16_t x, uint8_t size)
       return;
     }
 
+    ssd1306_mark_dirty(y, x, 20, 12);
     for (i=0; i<12; i++) {
       for (j=0; j<20; j++) {
 #if ( SSD1306_MULTILAYER_SUPPORT == I2_ENABLE )
@@ -446,6 +1040,7 @@ void ssd1306_clear_screen(uint16_t layer)
     memset(ssd1306_buffer_layer2, 0x00, 1024);
   }
 #endif /* SSD1306_MULTILAYER_SUPPORT */
+  ssd1306_mark_dirty(0, 0, SSD1306_DISPLAY_HEIGHT, SSD1306_DISPLAY_WIDTH);
   ssd1306_refresh();
 }
 
@@ -503,6 +1098,99 @@ void ssd1306_draw_line(int16_t y0, int16_t x0, int16_t y1, int16_t x1,
   }
 }
 
+/**
+ * @brief   Applies a column mask to a run of frame buffer bytes.
+ * @details Full byte masks for set and clear colors are written with memset.
+ *
+ * @param[in] dst     First frame buffer byte.
+ * @param[in] count   Number of bytes (columns) to update.
+ * @param[in] mask    Pixels of each byte to update.
+ * @param[in] color   Color to apply @ref SSD1306_COLOR_SPEC.
+ * @return  None.
+ */
+static inline void ssd1306_fill_bytes(uint8_t *dst, int16_t count,
+                                      uint8_t mask, uint16_t color)
+{
+  switch (color) {
+  case SSD1306_WHITE :
+    if (mask == 0xFF) {
+      memset(dst, 0xFF, count);
+    } else {
+      while (count--) {
+        *dst++ |= mask;
+      }
+    }
+    break;
+  case SSD1306_BLACK :
+    if (mask == 0xFF) {
+      memset(dst, 0x00, count);
+    } else {
+      while (count--) {
+        *dst++ &= ~mask;
+      }
+    }
+    break;
+  case SSD1306_INVERSE :
+    while (count--) {
+      *dst++ ^= mask;
+    }
+    break;
+  }
+}
+
+/**
+ * @brief   Fills a rectangular area of frame buffer.
+ * @details Works on page layout of frame buffer, every page of area is
+ *          updated by whole bytes with leading and trailing pixel masks.
+ *          Area is clipped to the display.
+ *
+ * @param[in] y       (y) coordinate of area beginning.
+ * @param[in] x       (x) coordinate of area beginning.
+ * @param[in] h       Height of area.
+ * @param[in] w       Width of area.
+ * @param[in] color   Color to fill @ref SSD1306_COLOR_SPEC.
+ * @param[in] layer   Layer to fill @ref SSD1306_MULTI_LAYER_SPEC.
+ * @return  None.
+ */
+static void ssd1306_fill_span(int16_t y, int16_t x, int16_t h, int16_t w,
+                              uint16_t color, uint16_t layer)
+{
+  int16_t y1 = SSD1306_MIN(y + h, SSD1306_DISPLAY_HEIGHT) - 1;
+  int16_t x1 = SSD1306_MIN(x + w, SSD1306_DISPLAY_WIDTH) - 1;
+  int16_t page, offset;
+  uint8_t mask;
+
+  y = SSD1306_MAX(y, 0);
+  x = SSD1306_MAX(x, 0);
+  if ((y > y1) || (x > x1)) {
+    return;
+  }
+
+  ssd1306_mark_dirty(y, x, y1 - y + 1, x1 - x + 1);
+
+  for (page = (y / 8); page <= (y1 / 8); page++) {
+    mask = 0xFF;
+    if (page == (y / 8)) {
+      mask &= (uint8_t)(0xFF << (y & 7));
+    }
+    if (page == (y1 / 8)) {
+      mask &= (uint8_t)(0xFF >> (7 - (y1 & 7)));
+    }
+
+    offset = (page * SSD1306_DISPLAY_WIDTH) + x;
+    if (layer & SSD1306_LAYER1) {
+      ssd1306_fill_bytes(ssd1306_buffer_layer1 + offset, x1 - x + 1,
+                         mask, color);
+    }
+#if ( SSD1306_MULTILAYER_SUPPORT == I2_ENABLE )
+    if (layer & SSD1306_LAYER2) {
+      ssd1306_fill_bytes(ssd1306_buffer_layer2 + offset, x1 - x + 1,
+                         mask, color);
+    }
+#endif /* SSD1306_MULTILAYER_SUPPORT */
+  }
+}
+
 /**
  * @brief   Draws a vertical line.
  * @details Draws a vertical line from a beginning coordinate to certain length.
@@ -517,7 +1205,11 @@ void ssd1306_draw_line(int16_t y0, int16_t x0, int16_t y1, int16_t x1,
 void ssd1306_draw_fast_vline(int16_t y, int16_t x, int16_t h,
                              uint16_t color, uint16_t layer)
 {
-  ssd1306_draw_line(y, x, y+h-1, x, color, layer);
+  if (h < 0) {
+    y += h + 1;
+    h = -h;
+  }
+  ssd1306_fill_span(y, x, h, 1, color, layer);
 }
 
 /**
@@ -534,7 +1226,11 @@ void ssd1306_draw_fast_vline(int16_t y, int16_t x, int16_t h,
 void ssd1306_draw_fast_hline(int16_t y, int16_t x, int16_t w,
                              uint16_t color, uint16_t layer)
 {
-  ssd1306_draw_line(y, x, y, x+w-1, color, layer);
+  if (w < 0) {
+    x += w + 1;
+    w = -w;
+  }
+  ssd1306_fill_span(y, x, 1, w, color, layer);
 }
 
 /**
@@ -573,82 +1269,183 @@ void ssd1306_draw_polygon(ssd1306_poly_t* poly,
 }
 
 /**
- * @brief   Draws a filled polygon.
- * @details http://alienryderflex.com/polygon_fill/.
+ * @brief   Builds edge table of a polygon.
+ * @details Corners are rounded to pixels. An edge from y0 to y1 (y0 < y1)
+ *          crosses scanlines y0 < y <= y1, horizontal edges are only kept
+ *          for outline. Table can be filled repeatedly at any position with
+ *          @ref ssd1306_fill_edge_table, e.g. for animated icons. Polygons
+ *          with more than @ref SSD1306_MAX_POLY_CORNERS corners are
+ *          rejected, table is left empty.
  *
- * @param[in] poly    SSD1306 polygon parameter @ref SSD1306_POLYGON_SPEC.
+ * @param[out] table  Edge table to build @ref SSD1306_EDGE_TABLE_SPEC.
+ * @param[in]  poly   SSD1306 polygon parameter @ref SSD1306_POLYGON_SPEC.
+ * @return  None.
+ */
+void ssd1306_edge_table_build(ssd1306_edge_table_t *table,
+                              const ssd1306_poly_t *poly)
+{
+  ssd1306_edge_t edge;
+  int16_t i, j, k;
+  int16_t x0, y0, x1, y1;
+
+  table->edges = 0;
+  table->corners = 0;
+  if (poly->corners > SSD1306_MAX_POLY_CORNERS) {
+    /* Truncated outline would draw a different shape */
+    i2_assert(0);
+    return;
+  }
+
+  table->corners = poly->corners;
+  for (i = 0; i < table->corners; i++) {
+    table->corner_x[i] = (int16_t)round(poly->point[i].x);
+    table->corner_y[i] = (int16_t)round(poly->point[i].y);
+  }
+
+  j = table->corners - 1;
+  for (i = 0; i < table->corners; j = i++) {
+    x0 = table->corner_x[j];
+    y0 = table->corner_y[j];
+    x1 = table->corner_x[i];
+    y1 = table->corner_y[i];
+    if (y0 == y1) {
+      continue;
+    }
+    if (y0 > y1) {
+      SSD1306_SWAP(x0, x1);
+      SSD1306_SWAP(y0, y1);
+    }
+
+    edge.y_start = y0 + 1;
+    edge.y_end   = y1;
+    edge.dx      = ((int32_t)(x1 - x0) * 65536) / (y1 - y0);
+    /* Half pixel bias, so truncation at each scanline rounds */
+    edge.x       = ((int32_t)x0 * 65536) + edge.dx + 0x8000;
+
+    /* Insert keeping edges sorted by first scanline */
+    for (k = table->edges; (k > 0) &&
+         (table->edge[k - 1].y_start > edge.y_start); k--) {
+      table->edge[k] = table->edge[k - 1];
+    }
+    table->edge[k] = edge;
+    table->edges++;
+  }
+}
+
+/**
+ * @brief   Draws a filled polygon from its edge table.
+ * @details Walks the scanlines keeping an active edge list, edges join the
+ *          list at their first scanline and leave it after their last one.
+ *          Active edges are kept sorted by x and spans between edge pairs
+ *          are filled a byte column at a time. Integer math only.
+ *
+ * @param[in] table   Edge table to draw @ref SSD1306_EDGE_TABLE_SPEC.
  * @param[in] y       (y) coordinate to draw.
  * @param[in] x       (x) coordinate to draw.
  * @param[in] color   Color of polygon to draw @ref SSD1306_COLOR_SPEC.
  * @param[in] layer   Layer to draw polygon @ref SSD1306_MULTI_LAYER_SPEC.
  * @return  None.
  */
-void ssd1306_fill_polygon(ssd1306_poly_t* poly, double y, double x,
-                         uint16_t color, uint16_t layer)
+void ssd1306_fill_edge_table(const ssd1306_edge_table_t *table,
+                             int16_t y, int16_t x,
+                             uint16_t color, uint16_t layer)
 {
-  int     nodeX[SSD1306_MAX_POLY_CORNERS], nodes, i, j, swap;
-  double  polyX[SSD1306_MAX_POLY_CORNERS], pixelX;
-  double  polyY[SSD1306_MAX_POLY_CORNERS], pixelY;
+  ssd1306_edge_t active[SSD1306_MAX_POLY_CORNERS];
+  ssd1306_edge_t edge;
+  const ssd1306_edge_t *next;
+  int16_t count = 0;
+  int16_t added = 0;
+  int16_t i, j, x0, x1;
+  int16_t line, end;
 
   /* draw shape */
-  ssd1306_draw_polygon(poly, (int16_t)y, (int16_t)x, color, layer);
-  /* copy polygon */
-  i = poly->corners - 1;
-  while (i >= 0) {
-    polyX[i] = round(poly->point[i].x + x);
-    polyY[i] = round(poly->point[i].y + y);
-    i--;
-  }
-  /* Loop through the rows of the image */
-  for (pixelY=0; pixelY<SSD1306_DISPLAY_HEIGHT; pixelY++) {
-    /* Build a list of nodes */
-    nodes = 0;
-    j = poly->corners - 1;
-    for (i=0; i<poly->corners; i++) {
-      if ((polyY[i]<(double) pixelY && polyY[j]>=(double) pixelY) ||
-          (polyY[j]<(double) pixelY && polyY[i]>=(double) pixelY)) {
-        nodeX[nodes++] = (int)round(  polyX[i] +
-                                      (pixelY-polyY[i])/(polyY[j]-polyY[i]) *
-                                      (polyX[j]-polyX[i]) );
-      }
-      j = i;
+  if (table->corners > 1) {
+    j = table->corners - 1;
+    for (i = 0; i < table->corners; j = i++) {
+      ssd1306_draw_line(table->corner_y[j] + y, table->corner_x[j] + x,
+                        table->corner_y[i] + y, table->corner_x[i] + x,
+                        color, layer);
     }
+  }
 
-    /* Sort the nodes, via a simple Bubble sort */
-    i = 0;
-    while (i<nodes-1) {
-      if (nodeX[i]>nodeX[i+1]) {
-        swap = nodeX[i];
-        nodeX[i] = nodeX[i+1];
-        nodeX[i+1] = swap;
-        if (i) {
-          i--;
-        }
+  if (table->edges == 0) {
+    return;
+  }
+
+  /* Scanlines in table coordinates, clipped to display */
+  line = SSD1306_MAX(table->edge[0].y_start, -y);
+  end  = SSD1306_DISPLAY_HEIGHT - y;
+  for (; line < end; line++) {
+    /* Retire edges past their last scanline */
+    for (i = 0; i < count; ) {
+      if (active[i].y_end < line) {
+        active[i] = active[--count];
       } else {
         i++;
       }
     }
 
-    /* Fill the pixels between node pairs. */
-    for (i=0; i<nodes; i+=2) {
-      if (nodeX[i]>=SSD1306_DISPLAY_WIDTH) {
+    /* Activate edges starting on this scanline, or skipped by clipping */
+    while ((added < table->edges) &&
+           (table->edge[added].y_start <= line)) {
+      next = &table->edge[added++];
+      if (next->y_end >= line) {
+        active[count] = *next;
+        active[count].x += next->dx * (line - next->y_start);
+        count++;
+      }
+    }
+
+    if (count == 0) {
+      if (added == table->edges) {
         break;
       }
-      if (nodeX[i+1]> 0) {
-        if (nodeX[i]< 0) {
-          nodeX[i] = 0 ;
-        }
-        if (nodeX[i+1] > SSD1306_DISPLAY_WIDTH) {
-          nodeX[i+1] = SSD1306_DISPLAY_WIDTH;
-        }
-        for (pixelX=nodeX[i]; pixelX<=nodeX[i+1]; pixelX++) {
-          ssd1306_draw_pixel((int16_t)(pixelY), (int16_t)(pixelX), color, layer);
-        }
+      continue;
+    }
+
+    /* Insertion sort by x, list is nearly sorted from previous scanline */
+    for (i = 1; i < count; i++) {
+      edge = active[i];
+      for (j = i; (j > 0) && (active[j - 1].x > edge.x); j--) {
+        active[j] = active[j - 1];
       }
+      active[j] = edge;
+    }
+
+    /* Fill the pixels between edge pairs */
+    for (i = 0; (i + 1) < count; i += 2) {
+      x0 = (int16_t)(active[i].x >> 16) + x;
+      x1 = (int16_t)(active[i + 1].x >> 16) + x;
+      ssd1306_fill_span(line + y, x0, 1, x1 - x0 + 1, color, layer);
+    }
+
+    for (i = 0; i < count; i++) {
+      active[i].x += active[i].dx;
     }
   }
 }
 
+/**
+ * @brief   Draws a filled polygon.
+ * @details Builds polygon edge table and fills it at integer position, see
+ *          @ref ssd1306_edge_table_build and @ref ssd1306_fill_edge_table.
+ *
+ * @param[in] poly    SSD1306 polygon parameter @ref SSD1306_POLYGON_SPEC.
+ * @param[in] y       (y) coordinate to draw.
+ * @param[in] x       (x) coordinate to draw.
+ * @param[in] color   Color of polygon to draw @ref SSD1306_COLOR_SPEC.
+ * @param[in] layer   Layer to draw polygon @ref SSD1306_MULTI_LAYER_SPEC.
+ * @return  None.
+ */
+void ssd1306_fill_polygon(ssd1306_poly_t* poly, int16_t y, int16_t x,
+                         uint16_t color, uint16_t layer)
+{
+  ssd1306_edge_table_t table;
+
+  ssd1306_edge_table_build(&table, poly);
+  ssd1306_fill_edge_table(&table, y, x, color, layer);
+}
+
 /**
  * @brief   Fill the complete screen.
  * @details Draws a rectangle to fills complete screen.
@@ -659,8 +1456,8 @@ void ssd1306_fill_polygon(ssd1306_poly_t* poly, double y, double x,
  */
 void ssd1306_fill_screen(uint16_t color, uint16_t layer)
 {
-  ssd1306_fill_rectangle( 0, 0, SSD1306_DISPLAY_HEIGHT, SSD1306_DISPLAY_WIDTH,
-                          color, layer);
+  ssd1306_fill_span(0, 0, SSD1306_DISPLAY_HEIGHT, SSD1306_DISPLAY_WIDTH,
+                    color, layer);
 }
 
 /**
@@ -839,27 +1636,28 @@ void ssd1306_fill_circle_helper(int16_t y0, int16_t x0, int16_t r,
 void ssd1306_draw_rectangle(int16_t y, int16_t x, int16_t h, int16_t w,
                             uint16_t color, uint16_t layer)
 {
-  int16_t x1, y1;
-  if ((w == 0) | (h == 0)) {
+  if ((w <= 0) | (h <= 0)) {
     return;
   }
-  x1 = x + w - 1;
-  y1 = y + h - 1;
 
-  if ((h > 2 ) | (w > 2)) {
-    ssd1306_draw_line(y, x, y, x1, color, layer);
-    ssd1306_draw_line(y1, x, y1, x1, color, layer);
-    ssd1306_draw_line(y+1, x, y1-1, x, color, layer);
-    ssd1306_draw_line(y+1, x1, y1-1, x1, color, layer);
-  } else {
-    ssd1306_draw_line(y,  x, y, x1, color, layer);
-    ssd1306_draw_line(y1, x, y1, x1, color, layer);
+  /* Edges never overlap, so inverse color stays consistent */
+  ssd1306_draw_fast_hline(y, x, w, color, layer);
+  if (h > 1) {
+    ssd1306_draw_fast_hline(y + h - 1, x, w, color, layer);
+  }
+  if (h > 2) {
+    ssd1306_draw_fast_vline(y + 1, x, h - 2, color, layer);
+    if (w > 1) {
+      ssd1306_draw_fast_vline(y + 1, x + w - 1, h - 2, color, layer);
+    }
   }
 }
 
 /**
  * @brief   Draws a filled rectangle.
- * @details Used to do circles and round rectangles.
+ * @details Used to do circles and round rectangles. Rectangle is clipped
+ *          to the display, so it may start at negative coordinates or
+ *          extend past the display edges.
  *
  * @param[in] y       (y) coordinate of rectangle beginning.
  * @param[in] x       (x) coordinate of rectangle beginning.
@@ -869,19 +1667,10 @@ void ssd1306_draw_rectangle(int16_t y, int16_t x, int16_t h, int16_t w,
  * @param[in] layer   Layer to draw @ref SSD1306_MULTI_LAYER_SPEC.
  * @return  None.
  */
-void ssd1306_fill_rectangle(uint8_t y, uint8_t x, uint8_t h, uint8_t w,
+void ssd1306_fill_rectangle(int16_t y, int16_t x, int16_t h, int16_t w,
                             uint16_t color, uint16_t layer)
 {
-  uint8_t x0, x1, y1;
-
-  x0 = x;
-  x1 = x + w;
-  y1 = y + h;
-  for (; y < y1; y++) {
-    for (x = x0; x < x1; x++) {
-      ssd1306_draw_pixel(y, x, color, layer);
-    }
-  }
+  ssd1306_fill_span(y, x, h, w, color, layer);
 }
 
 /**
@@ -913,9 +1702,181 @@ void ssd1306_draw_bitmap( int16_t y, int16_t x, uint8_t *bitmap,
   }
 }
 
+/**
+ * @brief   Applies glyph pixels to a frame buffer byte.
+ * @details White sets and black clears glyph pixels, inverse toggles the
+ *          background pixels of glyph cell.
+ *
+ * @param[in] dst     Frame buffer byte.
+ * @param[in] bits    Glyph pixels within byte.
+ * @param[in] mask    Glyph cell pixels within byte.
+ * @param[in] color   Color of glyph @ref SSD1306_COLOR_SPEC.
+ * @return  None.
+ */
+static inline void ssd1306_apply_byte(uint8_t *dst, uint8_t bits,
+                                      uint8_t mask, uint16_t color)
+{
+  switch (color) {
+  case SSD1306_WHITE :
+    *dst |= bits;
+    break;
+  case SSD1306_BLACK :
+    *dst &= ~bits;
+    break;
+  case SSD1306_INVERSE :
+    *dst ^= mask & ~bits;
+    break;
+  }
+}
+
+/**
+ * @brief   Writes a glyph column into frame buffer.
+ * @details Column is shifted to y alignment and ORed into every page it
+ *          spans, at most 5 pages for a 32 pixel column.
+ *
+ * @param[in] y       (y) coordinate of column top.
+ * @param[in] x       (x) coordinate of column.
+ * @param[in] bits    Column pixels, bit 0 on top.
+ * @param[in] height  Column height in pixels (1..32).
+ * @param[in] color   Color of glyph @ref SSD1306_COLOR_SPEC.
+ * @param[in] layer   Layer to draw @ref SSD1306_MULTI_LAYER_SPEC.
+ * @return  None.
+ */
+static void ssd1306_blit_column(int16_t y, int16_t x, uint32_t bits,
+                                uint8_t height, uint16_t color, uint16_t layer)
+{
+  uint64_t data = bits;
+  uint64_t mask = (1ULL << height) - 1;
+  int16_t page;
+  int16_t offset;
+
+  if ((x < 0) || (x >= SSD1306_DISPLAY_WIDTH) || (y <= -height)) {
+    return;
+  }
+
+  if (y < 0) {
+    data >>= -y;
+    mask >>= -y;
+    page = 0;
+  } else {
+    data <<= (y & 7);
+    mask <<= (y & 7);
+    page = y / 8;
+  }
+
+  for (; mask && (page < SSD1306_DISPLAY_PAGES);
+       page++, data >>= 8, mask >>= 8) {
+    offset = (page * SSD1306_DISPLAY_WIDTH) + x;
+    if (layer & SSD1306_LAYER1) {
+      ssd1306_apply_byte(&ssd1306_buffer_layer1[offset], (uint8_t)data,
+                         (uint8_t)mask, color);
+    }
+#if ( SSD1306_MULTILAYER_SUPPORT == I2_ENABLE )
+    if (layer & SSD1306_LAYER2) {
+      ssd1306_apply_byte(&ssd1306_buffer_layer2[offset], (uint8_t)data,
+                         (uint8_t)mask, color);
+    }
+#endif /* SSD1306_MULTILAYER_SUPPORT */
+  }
+}
+
+/**
+ * @brief   Gets glyph scaled up by an integer factor.
+ * @details Every font column is expanded vertically, each pixel repeated
+ *          @p size times. Expanded glyphs are kept in a small round robin
+ *          cache, so repeated text is expanded once.
+ *
+ * @param[in] c       Character to get.
+ * @param[in] size    Scale factor (2..@ref SSD1306_GLYPH_CACHE_MAX_SCALE).
+ * @return  Expanded glyph columns.
+ */
+static const uint32_t* ssd1306_glyph_scaled(uint16_t c, uint8_t size)
+{
+  ssd1306_glyph_t *glyph;
+  uint8_t line;
+  uint8_t i, j;
+
+  for (i = 0; i < SSD1306_GLYPH_CACHE_SIZE; i++) {
+    glyph = &ssd1306_glyph_cache[i];
+    if ((glyph->size == size) && (glyph->c == c)) {
+      return glyph->column;
+    }
+  }
+
+  glyph = &ssd1306_glyph_cache[ssd1306_glyph_next];
+  ssd1306_glyph_next = (ssd1306_glyph_next + 1) % SSD1306_GLYPH_CACHE_SIZE;
+  glyph->c    = c;
+  glyph->size = size;
+  for (i = 0; i < SSD1306_GLYPH_COLUMNS; i++) {
+    line = i2_font5x7[(c * SSD1306_GLYPH_COLUMNS) + i];
+    glyph->column[i] = 0;
+    for (j = 0; j < 8; j++) {
+      if (line & (1 << j)) {
+        glyph->column[i] |= ((1UL << size) - 1) << (j * size);
+      }
+    }
+  }
+  return glyph->column;
+}
+
+/**
+ * @brief   Writes a glyph into frame buffer.
+ * @details Glyph columns are written directly into the pages, scaled glyphs
+ *          come from the glyph cache. Sizes beyond the cache are drawn as
+ *          filled blocks. Cell is one blank column wider than the font.
+ *
+ * @param[in] y       (y) coordinate to write.
+ * @param[in] x       (x) coordinate to write.
+ * @param[in] c       Character to display.
+ * @param[in] size    Character size to display @ref SSD1306_TEXT_SPEC.
+ * @param[in] color   Color of char to write @ref SSD1306_COLOR_SPEC.
+ * @param[in] layer   Layer to draw @ref SSD1306_MULTI_LAYER_SPEC.
+ * @return  None.
+ */
+static void ssd1306_blit_glyph(int16_t y, int16_t x, uint16_t c, uint8_t size,
+                               uint16_t color, uint16_t layer)
+{
+  const uint32_t *scaled = NULL;
+  uint32_t column;
+  uint8_t i, j, k;
+
+  if (size > SSD1306_GLYPH_CACHE_MAX_SCALE) {
+    for (i = 0; i <= SSD1306_GLYPH_COLUMNS; i++) {
+      column = (i < SSD1306_GLYPH_COLUMNS) ?
+               i2_font5x7[(c * SSD1306_GLYPH_COLUMNS) + i] : 0;
+      for (j = 0; j < 8; j++) {
+        if ((color == SSD1306_INVERSE) ^ ((column >> j) & 0x1)) {
+          ssd1306_fill_span(y + (j * size), x + (i * size), size, size,
+                            color, layer);
+        }
+      }
+    }
+    return;
+  }
+
+  if (size > 1) {
+    scaled = ssd1306_glyph_scaled(c, size);
+  }
+
+  for (i = 0; i <= SSD1306_GLYPH_COLUMNS; i++) {
+    if (i == SSD1306_GLYPH_COLUMNS) {
+      column = 0;
+    } else if (scaled) {
+      column = scaled[i];
+    } else {
+      column = i2_font5x7[(c * SSD1306_GLYPH_COLUMNS) + i];
+    }
+    for (k = 0; k < size; k++) {
+      ssd1306_blit_column(y, x + (i * size) + k, column, 8 * size,
+                          color, layer);
+    }
+  }
+}
+
 /**
  * @brief   Writes a character on the screen.
- * @details By Default 8514oem character set is used to display.
+ * @details By Default 8514oem character set is used to display. Only the
+ *          pixel buffer is updated, @ref ssd1306_refresh shows it.
  *
  * @param[in] y       (y) coordinate to write.
  * @param[in] x       (x) coordinate to write.
@@ -928,48 +1889,52 @@ void ssd1306_draw_bitmap( int16_t y, int16_t x, uint8_t *bitmap,
 void ssd1306_draw_char(int16_t y, int16_t x, uint16_t c, uint8_t size,
                        uint16_t color, uint16_t layer)
 {
-  int8_t i = 0;
-  int8_t j = 0;
-  if ((x >= SSD1306_DISPLAY_WIDTH)  ||    /* clip right */
+  if ((size == 0)                   ||
+      (x >= SSD1306_DISPLAY_WIDTH)  ||    /* clip right */
       (y >= SSD1306_DISPLAY_HEIGHT) ||    /* clip bottom */
       ((x + 6 * size - 1) < 0)      ||    /* clip left */
       ((y + 8 * size - 1) < 0)) {         /* clip top */
     return;
   }
 
-  for (i=0; i<6; i++) {
-    int8_t line;
-    if (i > SSD1306_TEXT_MAX_LINE) {
-      line = 0x0;
-    } else {
-      line = (int8_t)*(i2_font5x7+(c*5)+i);
-    }
+  ssd1306_mark_dirty(y, x, 8 * size, 6 * size);
+  ssd1306_blit_glyph(y, x, c, size, color, layer);
+}
 
-    for (j = 0; j<8; j++) {
-      if (color == SSD1306_WHITE) {
-        if (line & 0x1) {
-          if (size == 1) {    /* default size */
-            ssd1306_draw_pixel(y+j, x+i, color, layer);
-          } else {            /* big size */
-            ssd1306_draw_rectangle( y+(j*size), x+(i*size), size,
-                                    size, color, layer);
-          }
-        }
-      }
-      if (color == SSD1306_INVERSE) {
-        if (!(line & 0x1)) {
-          if (size == 1) {    /* default size */
-            ssd1306_draw_pixel(y+j, x+i, color, layer);
-          } else {            /* big size */
-            ssd1306_draw_rectangle( y+(j*size), x+(i*size), size,
-                                    size, color, layer);
-          }
-        }
-      }
-      line >>= 1;
+/**
+ * @brief   Writes a run of text on the screen.
+ * @details Renders whole string in one pass, with a single dirty region and
+ *          skipping characters outside the display. Characters advance by
+ *          a whole 6 * size glyph cell so that INVERSE text is not striped
+ *          by overlapping cells. Only the pixel buffer is updated,
+ *          @ref ssd1306_refresh shows it.
+ *
+ * @param[in] y       (y) coordinate to write.
+ * @param[in] x       (x) coordinate to write.
+ * @param[in] text    String to display.
+ * @param[in] size    Character size to display @ref SSD1306_TEXT_SPEC.
+ * @param[in] color   Color of text to write @ref SSD1306_COLOR_SPEC.
+ * @param[in] layer   Layer to write text @ref SSD1306_MULTI_LAYER_SPEC.
+ * @return  None.
+ */
+void ssd1306_draw_text_run(int16_t y, int16_t x, const char *text,
+                           uint8_t size, uint16_t color, uint16_t layer)
+{
+  int16_t advance = 6 * size;              /* full glyph cell, no overlap */
+  int16_t len = (int16_t)strlen(text);
+
+  if ((size == 0) || (len == 0) ||
+      (y >= SSD1306_DISPLAY_HEIGHT) || ((y + 8 * size - 1) < 0)) {
+    return;
+  }
+
+  ssd1306_mark_dirty(y, x, 8 * size, len * advance);
+
+  for (; *text && (x < SSD1306_DISPLAY_WIDTH); text++, x += advance) {
+    if ((x + 6 * size - 1) >= 0) {
+      ssd1306_blit_glyph(y, x, (uint8_t)*text, size, color, layer);
     }
   }
-  ssd1306_refresh();
 }
 
 /**
@@ -1013,12 +1978,8 @@ void  ssd1306_draw_char_loc(int16_t y, int16_t x, uint16_t c, uint8_t size,
 void  ssd1306_draw_string(int16_t y, int16_t x, char *text, uint8_t size,
                           uint16_t color, uint16_t layer)
 {
-  uint8_t l = 0;
-  while (*text) {
-    ssd1306_draw_char(y, x + (l * (5*size + 1)), *text, size, color, layer);
-    text++;
-    l++;
-  }
+  ssd1306_draw_text_run(y, x, text, size, color, layer);
+  ssd1306_refresh();
 }
 
 /**
@@ -1041,6 +2002,7 @@ void  ssd1306_draw_string_loc(int16_t y, int16_t x, char *text, uint8_t size,
     text++;
     x++;
   }
+  ssd1306_refresh();
 }
 
 /**
@@ -1059,129 +2021,211 @@ void  ssd1306_draw_string_loc(int16_t y, int16_t x, char *text, uint8_t size,
 void  ssd1306_type_string_loc(int16_t y, int16_t x, char *text, uint8_t size,
                               uint8_t delay, uint16_t color, uint16_t layer)
 {
-  uint8_t i;
   while (*text) {
     ssd1306_draw_char_loc(y, x, *text, size, color, layer);
     text++;
     x++;
 
-    i = 0;
-    while (i < delay) {
-      ssd1306_delay(1);
-      i++;
-    }
+    ssd1306_backend->delay(delay);
     ssd1306_refresh();
   }
 }
 
 /**
- * @brief   Shifts content of frame buffer up the specified number of pixels.
- * @details Layer 1 will have shifting options and a blank space will be added
- *          at bottom after shifting.
+ * @brief   Shifts content of frame buffer by the specified number of pixels.
+ * @details Layer 1 is shifted on packed page bytes, vertical shifts carry
+ *          bits between pages and horizontal shifts move page rows. Blank
+ *          space is added at the side content is shifted away from.
  *
- * @param[in] height    Number of pixels to shift the frame buffer up.
- * @param[in] direction Direction to shift in.
+ * @param[in] height    Number of pixels to shift the frame buffer by.
+ * @param[in] direction Direction to shift in @ref SSD1306_SHIFT_SPEC.
  * @return  None.
  */
 void ssd1306_shift_frame_buffer(uint16_t height, uint16_t direction)
 {
-  int16_t y = 0;
-  int16_t x = 0;
+  uint8_t *buffer = ssd1306_buffer_layer1;
+  int16_t page, src, x;
+  uint8_t pages, bits;
+
   if (height == 0) {
     return;
   }
 
-#if 0
-  while (height > 0)
-  {
-#endif /* 0 */
-    switch (direction) {
-    case 0 :
-      /* This is horribly inefficient, but at least easy to understand. */
-      /* In a production environment, this should be significantly optimized */
-      if (height >= SSD1306_DISPLAY_HEIGHT) {
-        /* Clear the entire frame buffer */
-        ssd1306_clear_screen(SSD1306_LAYER1);
-        return;
-      }
-      for (y=0; y<SSD1306_DISPLAY_HEIGHT; y++) {
-        for (x=0; x<SSD1306_DISPLAY_WIDTH; x++) {
-          if ((SSD1306_DISPLAY_HEIGHT ) - y > 1) {
-            /* Shift height from further ahead in the buffer */
-            ssd1306_get_pixel(y + 1, x) ?  \
-                ssd1306_draw_pixel(y, x, SSD1306_WHITE, SSD1306_LAYER1) : \
-                ssd1306_draw_pixel(y, x, SSD1306_BLACK, SSD1306_LAYER1);
-          } else {
-            /* Clear the entire line */
-            ssd1306_draw_pixel(y, x, SSD1306_BLACK, SSD1306_LAYER1);
-          }
-        }
-      }
+  switch (direction) {
+  case SSD1306_SHIFT_UP :
+  case SSD1306_SHIFT_DOWN :
+    if (height >= SSD1306_DISPLAY_HEIGHT) {
+      memset(buffer, 0x00, sizeof(ssd1306_buffer_layer1));
       break;
-    case 1 :
-      y = SSD1306_COUNTOF(ssd1306_buffer_layer1);
-      x = y;
-      for (x=SSD1306_COUNTOF(ssd1306_buffer_layer1)-1; x>=0; x--) {
-        ssd1306_buffer_layer1[x] = ssd1306_buffer_layer1[x] << height;
-        if (((x - (int16_t)SSD1306_COUNTOF(ssd1306_buffer_layer1)/8) >= 0) &&
-            ((ssd1306_buffer_layer1[x - SSD1306_COUNTOF(ssd1306_buffer_layer1)/8] & 0x80) == 0x80)) {
-          ssd1306_buffer_layer1[x] = ssd1306_buffer_layer1[x] | 0x01;
+    }
+    pages = height / 8;
+    bits  = height % 8;
+    if (direction == SSD1306_SHIFT_UP) {
+      /* Row y takes row y + height, walking pages top to bottom */
+      for (page = 0; page < SSD1306_DISPLAY_PAGES; page++) {
+        src = page + pages;
+        for (x = 0; x < SSD1306_DISPLAY_WIDTH; x++) {
+          buffer[page * SSD1306_DISPLAY_WIDTH + x] =
+            ((src < SSD1306_DISPLAY_PAGES) ?
+              (buffer[src * SSD1306_DISPLAY_WIDTH + x] >> bits) : 0) |
+            ((bits && ((src + 1) < SSD1306_DISPLAY_PAGES)) ?
+              (uint8_t)(buffer[(src + 1) * SSD1306_DISPLAY_WIDTH + x] <<
+                        (8 - bits)) : 0);
         }
       }
-      break;
-    case 2 :
-      for (y=0; y<=7; y++) {
-        for (x=0; x<(SSD1306_COUNTOF(ssd1306_buffer_layer1)/8 - 1); x++) {
-          ssd1306_buffer_layer1[x + (128 * y)] = ssd1306_buffer_layer1[x + (128 * y) + 1];
+    } else {
+      /* Row y takes row y - height, walking pages bottom to top */
+      for (page = SSD1306_DISPLAY_PAGES - 1; page >= 0; page--) {
+        src = page - pages;
+        for (x = 0; x < SSD1306_DISPLAY_WIDTH; x++) {
+          buffer[page * SSD1306_DISPLAY_WIDTH + x] =
+            ((src >= 0) ?
+              (uint8_t)(buffer[src * SSD1306_DISPLAY_WIDTH + x] << bits) : 0) |
+            ((bits && (src > 0)) ?
+              (buffer[(src - 1) * SSD1306_DISPLAY_WIDTH + x] >>
+               (8 - bits)) : 0);
         }
-        ssd1306_buffer_layer1[127 + (128 * y)] = 0;
       }
-      break;
-    case 3 :
-      for (y=0; y<=7; y++) {
-        for (x=(SSD1306_COUNTOF(ssd1306_buffer_layer1)/8 - 1); x>0; x--) {
-          ssd1306_buffer_layer1[x + (128 * y)] = ssd1306_buffer_layer1[x - 1 + (128 * y)];
-        }
-        ssd1306_buffer_layer1[128 * y] = 0;
+    }
+    break;
+  case SSD1306_SHIFT_LEFT :
+  case SSD1306_SHIFT_RIGHT :
+    if (height > SSD1306_DISPLAY_WIDTH) {
+      height = SSD1306_DISPLAY_WIDTH;
+    }
+    for (page = 0; page < SSD1306_DISPLAY_PAGES; page++) {
+      uint8_t *row = buffer + (page * SSD1306_DISPLAY_WIDTH);
+      if (direction == SSD1306_SHIFT_LEFT) {
+        memmove(row, row + height, SSD1306_DISPLAY_WIDTH - height);
+        memset(row + SSD1306_DISPLAY_WIDTH - height, 0x00, height);
+      } else {
+        memmove(row + height, row, SSD1306_DISPLAY_WIDTH - height);
+        memset(row, 0x00, height);
       }
-      break;
-    default:
-      return;
     }
-#if 0
-  height--;
+    break;
+  default:
+    return;
   }
-#endif /* 0 */
+
+  ssd1306_mark_dirty(0, 0, SSD1306_DISPLAY_HEIGHT, SSD1306_DISPLAY_WIDTH);
 }
 
 /**
- * @brief   Inserts time delay.
- * @details Need to handle blocking and non blocking both delays.
+ * @brief   Starts continuous horizontal hardware scrolling.
+ * @details Display controller scrolls pages without any bus traffic, until
+ *          @ref ssd1306_scroll_stop.
  *
- * @param[in] nCount    Delay count in ms.
+ * @param[in] right       Scroll right if true, left otherwise.
+ * @param[in] start_page  First page to scroll (0..7).
+ * @param[in] end_page    Last page to scroll (0..7).
+ * @param[in] interval    Scroll step interval @ref SSD1306_SCROLL_SPEC.
  * @return  None.
  */
-void ssd1306_delay(__IO uint32_t nCount)
+void ssd1306_scroll_horizontal(bool right, uint8_t start_page,
+                               uint8_t end_page, uint8_t interval)
 {
-  __IO uint32_t index = 0;
-  for (index = (100000 * nCount); index != 0; index--) {
-  }
+  ssd1306_cmd_batch_t batch;
+
+  ssd1306_cmd_begin(&batch);
+  ssd1306_cmd_add(&batch, SSD1306_DEACTIVATE_SCROLL);
+  ssd1306_cmd_add(&batch, right ? SSD1306_RIGHT_HORIZONTAL_SCROLL :
+                                  SSD1306_LEFT_HORIZONTAL_SCROLL);
+  ssd1306_cmd_add(&batch, 0x00);
+  ssd1306_cmd_add(&batch, start_page);
+  ssd1306_cmd_add(&batch, interval);
+  ssd1306_cmd_add(&batch, end_page);
+  ssd1306_cmd_add(&batch, 0x00);
+  ssd1306_cmd_add(&batch, 0xFF);
+  ssd1306_cmd_add(&batch, SSD1306_ACTIVATE_SCROLL);
+  ssd1306_cmd_send(&batch);
+}
+
+/**
+ * @brief   Starts continuous vertical and horizontal hardware scrolling.
+ * @details Rows in scroll area move up by @p offset rows every step, while
+ *          pages in page range also move horizontally.
+ *
+ * @param[in] right       Scroll right if true, left otherwise.
+ * @param[in] start_page  First page to scroll horizontally (0..7).
+ * @param[in] end_page    Last page to scroll horizontally (0..7).
+ * @param[in] interval    Scroll step interval @ref SSD1306_SCROLL_SPEC.
+ * @param[in] fixed_rows  Rows fixed at top of display.
+ * @param[in] rows        Rows in vertical scroll area.
+ * @param[in] offset      Vertical rows to scroll each step (1..63).
+ * @return  None.
+ */
+void ssd1306_scroll_diagonal(bool right, uint8_t start_page, uint8_t end_page,
+                             uint8_t interval, uint8_t fixed_rows,
+                             uint8_t rows, uint8_t offset)
+{
+  ssd1306_cmd_batch_t batch;
+
+  ssd1306_cmd_begin(&batch);
+  ssd1306_cmd_add(&batch, SSD1306_DEACTIVATE_SCROLL);
+  ssd1306_cmd_add(&batch, SSD1306_SET_VERTICAL_SCROLL_AREA);
+  ssd1306_cmd_add(&batch, fixed_rows);
+  ssd1306_cmd_add(&batch, rows);
+  ssd1306_cmd_add(&batch, right ?
+                  SSD1306_VERTICAL_AND_RIGHT_HORIZONTAL_SCROLL :
+                  SSD1306_VERTICAL_AND_LEFT_HORIZONTAL_SCROLL);
+  ssd1306_cmd_add(&batch, 0x00);
+  ssd1306_cmd_add(&batch, start_page);
+  ssd1306_cmd_add(&batch, interval);
+  ssd1306_cmd_add(&batch, end_page);
+  ssd1306_cmd_add(&batch, offset);
+  ssd1306_cmd_add(&batch, SSD1306_ACTIVATE_SCROLL);
+  ssd1306_cmd_send(&batch);
+}
+
+/**
+ * @brief   Stops hardware scrolling.
+ * @details Display RAM is undefined after scrolling, so the whole display
+ *          is sent again on next refresh.
+ *
+ * @return  None.
+ */
+void ssd1306_scroll_stop(void)
+{
+  ssd1306_cmd_batch_t batch;
+
+  ssd1306_cmd_begin(&batch);
+  ssd1306_cmd_add(&batch, SSD1306_DEACTIVATE_SCROLL);
+  ssd1306_cmd_send(&batch);
+  ssd1306_mark_dirty(0, 0, SSD1306_DISPLAY_HEIGHT, SSD1306_DISPLAY_WIDTH);
 }
 
 #if ( SSD1306_MULTILAYER_SUPPORT == I2_ENABLE )
 /**
  * @brief   Mixes both layers together.
- * @details Mixes both layers buffer together.
+ * @details Composes whole display into output buffer with current blend
+ *          mode, layers are kept intact. Refresh composes dirty regions by
+ *          itself, this is only needed after changing blend mode.
  *
  * @return  None.
  */
 void ssd1306_mix_frame_buffer(void)
 {
-  uint16_t i;
-  for (i=0; i<(SSD1306_DISPLAY_WIDTH * SSD1306_DISPLAY_HEIGHT / 8); i++) {
-    ssd1306_buffer_layer2[i] |= ssd1306_buffer_layer1[i];
+  uint8_t page;
+
+  for (page = 0; page < SSD1306_DISPLAY_PAGES; page++) {
+    ssd1306_compose(page, 0, SSD1306_DISPLAY_WIDTH - 1);
   }
 }
+
+/**
+ * @brief   Sets layer blend mode.
+ * @details Selects how layer 1 is blended over layer 2, whole display is
+ *          composed again on next refresh.
+ *
+ * @param[in] mode    Blend mode @ref SSD1306_BLEND_SPEC.
+ * @return  None.
+ */
+void ssd1306_set_blend_mode(uint8_t mode)
+{
+  ssd1306_blend_mode = mode;
+  ssd1306_mark_dirty(0, 0, SSD1306_DISPLAY_HEIGHT, SSD1306_DISPLAY_WIDTH);
+}
 #endif /* SSD1306_MULTILAYER_SUPPORT */
 
 /************************ (C) COPYRIGHT iota2 ***[i2]*****END OF FILE**********/
@@ -0,0 +1,400 @@
+/**
+ * @author      iota square [i2]
+ * <pre>
+ * ██╗ ██████╗ ████████╗ █████╗ ██████╗
+ * ██║██╔═══██╗╚══██╔══╝██╔══██╗╚════██╗
+ * ██║██║   ██║   ██║   ███████║ █████╔╝
+ * ██║██║   ██║   ██║   ██╔══██║██╔═══╝
+ * ██║╚██████╔╝   ██║   ██║  ██║███████╗
+ * ╚═╝ ╚═════╝    ╚═╝   ╚═╝  ╚═╝╚══════╝
+ * </pre>
+ *
+ * @date        17-10-2026
+ * @file        i2_oled_ssd1306_emu.c
+ * @brief       SSD1306 OLED display host emulator backend.
+ *
+ * @copyright   GNU GPU v3
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * Free Software, Hell Yeah!
+ *
+ **/
+
+/* Includes ------------------------------------------------------------------*/
+#include "i2_oled_ssd1306_emu.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define EMU_MODE_HORIZONTAL     ( 0x00 )  /**< Horizontal addressing mode */
+#define EMU_MODE_VERTICAL       ( 0x01 )  /**< Vertical addressing mode   */
+#define EMU_MODE_PAGE           ( 0x02 )  /**< Page addressing mode       */
+#define EMU_MAX_ARGS            ( 6 )     /**< Max arguments of a command */
+#define EMU_GDDRAM_RESET        ( 0x55 )  /**< GDDRAM content after reset */
+
+/* Private variables ---------------------------------------------------------*/
+/**
+ * @defgroup SSD1306_EMU_STATE_SPEC SSD1306 emulated controller state.
+ * GDDRAM, addressing and display state decoded from command stream.
+ *
+ * @{
+ */
+/** @brief Display data RAM, page by page */
+static uint8_t emu_gddram[SSD1306_DISPLAY_PAGES][SSD1306_DISPLAY_WIDTH];
+/** @brief Command being received, with its arguments */
+static uint8_t emu_cmd[1 + EMU_MAX_ARGS];
+/** @brief Bytes received of current command */
+static uint8_t emu_cmd_len;
+static uint8_t emu_mode;        /**< Memory addressing mode             */
+static uint8_t emu_col_start;   /**< Column window start                */
+static uint8_t emu_col_end;     /**< Column window end                  */
+static uint8_t emu_page_start;  /**< Page window start                  */
+static uint8_t emu_page_end;    /**< Page window end                    */
+static uint8_t emu_col;         /**< Column address pointer             */
+static uint8_t emu_page;        /**< Page address pointer               */
+static uint8_t emu_page_col;    /**< Page mode column start             */
+static bool    emu_display_on;  /**< Display on                         */
+static bool    emu_inverse;     /**< Inverse display                    */
+static bool    emu_all_on;      /**< Entire display on                  */
+/** @brief Traffic statistics */
+static ssd1306_emu_stats_t emu_stats;
+/** @} */ /* SSD1306_EMU_STATE_SPEC */
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief   Command arguments.
+ * @details Number of argument bytes following a command byte.
+ *
+ * @param[in] cmd     Command byte.
+ * @return  Number of arguments.
+ */
+static uint8_t emu_cmd_args(uint8_t cmd)
+{
+  switch (cmd) {
+  case SSD1306_RIGHT_HORIZONTAL_SCROLL :
+  case SSD1306_LEFT_HORIZONTAL_SCROLL :
+    return 6;
+  case SSD1306_VERTICAL_AND_RIGHT_HORIZONTAL_SCROLL :
+  case SSD1306_VERTICAL_AND_LEFT_HORIZONTAL_SCROLL :
+    return 5;
+  case SSD1306_CMD_SET_COLUMN_ADDR :
+  case SSD1306_CMD_SET_PAGE_ADDR :
+  case SSD1306_SET_VERTICAL_SCROLL_AREA :
+    return 2;
+  case SSD1306_CMD_MEMORY_ADDRESSING_MODE :
+  case SSD1306_CMD_SET_CONTRAST :
+  case SSD1306_CMD_CHARGE_PUMP :
+  case SSD1306_CMD_SET_MULTIPLEX :
+  case SSD1306_CMD_DISPLAY_SET_OFFSET :
+  case SSD1306_CMD_SET_CLOCK_DIV_AND_FREQ :
+  case SSD1306_CMD_SET_PRECHARGE :
+  case SSD1306_CMD_SET_COM_PINS :
+  case SSD1306_CMD_SET_VCOM_DETECT :
+    return 1;
+  default :
+    return 0;
+  }
+}
+
+/**
+ * @brief   Command execution.
+ * @details Applies a complete command to emulated controller state.
+ *
+ * @return  None.
+ */
+static void emu_cmd_run(void)
+{
+  uint8_t cmd = emu_cmd[0];
+
+  switch (cmd) {
+  case SSD1306_CMD_MEMORY_ADDRESSING_MODE :
+    emu_mode = emu_cmd[1] & 0x03;
+    break;
+  case SSD1306_CMD_SET_COLUMN_ADDR :
+    emu_col_start = emu_cmd[1] & 0x7F;
+    emu_col_end = emu_cmd[2] & 0x7F;
+    emu_col = emu_col_start;
+    break;
+  case SSD1306_CMD_SET_PAGE_ADDR :
+    emu_page_start = emu_cmd[1] & 0x07;
+    emu_page_end = emu_cmd[2] & 0x07;
+    emu_page = emu_page_start;
+    break;
+  case SSD1306_CMD_DISPLAY_ON :
+  case SSD1306_CMD_DISPLAY_OFF :
+    emu_display_on = (cmd == SSD1306_CMD_DISPLAY_ON);
+    break;
+  case SSD1306_CMD_DISPLAY_NORMAL :
+  case SSD1306_CMD_DISPLAY_INVERT :
+    emu_inverse = (cmd == SSD1306_CMD_DISPLAY_INVERT);
+    break;
+  case SSD1306_CMD_DISPLAY_ALLON_RESUME :
+  case SSD1306_CMD_DISPLAY_ALLON :
+    emu_all_on = (cmd == SSD1306_CMD_DISPLAY_ALLON);
+    break;
+  default :
+    if ((cmd >= 0xB0) && (cmd <= 0xB7)) {
+      emu_page = cmd & 0x07;
+    } else if (cmd <= 0x0F) {
+      emu_page_col = (emu_page_col & 0xF0) | cmd;
+      emu_col = emu_page_col;
+    } else if (cmd <= 0x1F) {
+      emu_page_col = ((cmd & 0x07) << 4) | (emu_page_col & 0x0F);
+      emu_col = emu_page_col;
+    }
+    break;
+  }
+}
+
+/**
+ * @brief   GDDRAM write.
+ * @details Stores a data byte and advances address pointers as the
+ *          controller does in current addressing mode.
+ *
+ * @param[in] data    GDDRAM byte.
+ * @return  None.
+ */
+static void emu_data(uint8_t data)
+{
+  emu_gddram[emu_page][emu_col] = data;
+
+  switch (emu_mode) {
+  case EMU_MODE_HORIZONTAL :
+    if (emu_col++ >= emu_col_end) {
+      emu_col = emu_col_start;
+      emu_page = (emu_page >= emu_page_end) ? emu_page_start : emu_page + 1;
+    }
+    break;
+  case EMU_MODE_VERTICAL :
+    if (emu_page++ >= emu_page_end) {
+      emu_page = emu_page_start;
+      emu_col = (emu_col >= emu_col_end) ? emu_col_start : emu_col + 1;
+    }
+    break;
+  default :
+    if (emu_col++ >= (SSD1306_DISPLAY_WIDTH - 1)) {
+      emu_col = emu_page_col;
+    }
+    break;
+  }
+}
+
+/**
+ * @brief   Emulator backend initialization.
+ * @details Nothing to set up, controller state is set by reset.
+ *
+ * @return  None.
+ */
+static void emu_init(void)
+{
+}
+
+/**
+ * @brief   Emulator backend reset.
+ * @details Puts controller in its reset state. GDDRAM is not cleared by a
+ *          real reset, it is filled with a pattern so that frames relying
+ *          on its old content show up.
+ *
+ * @param[in] asserted  Holds display in reset if true.
+ * @return  None.
+ */
+static void emu_reset(bool asserted)
+{
+  if (!asserted) {
+    return;
+  }
+
+  memset(emu_gddram, EMU_GDDRAM_RESET, sizeof(emu_gddram));
+  emu_cmd_len = 0;
+  emu_mode = EMU_MODE_PAGE;
+  emu_col_start = 0;
+  emu_col_end = SSD1306_DISPLAY_WIDTH - 1;
+  emu_page_start = 0;
+  emu_page_end = SSD1306_DISPLAY_PAGES - 1;
+  emu_col = 0;
+  emu_page = 0;
+  emu_page_col = 0;
+  emu_display_on = false;
+  emu_inverse = false;
+  emu_all_on = false;
+}
+
+/**
+ * @brief   Emulator backend command write.
+ * @details Decodes commands, arguments may follow in later writes.
+ *
+ * @param[in] cmd     Commands and their arguments.
+ * @param[in] size    Number of bytes.
+ * @return  None.
+ */
+static void emu_write_cmd(const uint8_t *cmd, uint16_t size)
+{
+  emu_stats.cmd_writes++;
+  emu_stats.cmd_bytes += size;
+
+  while (size--) {
+    emu_cmd[emu_cmd_len++] = *cmd++;
+    if (emu_cmd_len > emu_cmd_args(emu_cmd[0])) {
+      emu_cmd_run();
+      emu_cmd_len = 0;
+    }
+  }
+}
+
+/**
+ * @brief   Emulator backend data write.
+ * @details Writes all segments into GDDRAM.
+ *
+ * @param[in] segments  Data segments to write.
+ * @param[in] count     Number of segments.
+ * @return  None.
+ */
+static void emu_write_data(const ssd1306_segment_t *segments, uint8_t count)
+{
+  uint16_t i;
+
+  /* Data mode ends any partially received command */
+  emu_cmd_len = 0;
+  emu_stats.data_writes++;
+  while (count--) {
+    emu_stats.data_bytes += segments->size;
+    for (i = 0; i < segments->size; i++) {
+      emu_data(segments->data[i]);
+    }
+    segments++;
+  }
+}
+
+/**
+ * @brief   Emulator backend delay.
+ * @details Only accounted, host does not wait.
+ *
+ * @param[in] ms      Delay in ms.
+ * @return  None.
+ */
+static void emu_delay(uint32_t ms)
+{
+  emu_stats.delay_ms += ms;
+}
+
+/* Public variables ----------------------------------------------------------*/
+/** @brief Host display emulator backend */
+const ssd1306_backend_t ssd1306_emu_backend = {
+  emu_init,
+  emu_reset,
+  emu_write_cmd,
+  emu_write_data,
+  emu_delay,
+};
+
+/* Public functions ----------------------------------------------------------*/
+/**
+ * @brief   Emulated GDDRAM.
+ * @details Display data RAM as written by driver, page by page.
+ *
+ * @return  GDDRAM, SSD1306_DISPLAY_PAGES pages of SSD1306_DISPLAY_WIDTH bytes.
+ */
+const uint8_t* ssd1306_emu_gddram(void)
+{
+  return &emu_gddram[0][0];
+}
+
+/**
+ * @brief   Emulated panel pixel.
+ * @details Pixel as seen on panel, display on / off, inverse and entire
+ *          display on are applied. GDDRAM is shown in the orientation set
+ *          up by @ref ssd1306_init.
+ *
+ * @param[in] y       (y) coordinate of pixel.
+ * @param[in] x       (x) coordinate of pixel.
+ * @return  true if pixel is lit.
+ */
+bool ssd1306_emu_pixel(int16_t y, int16_t x)
+{
+  bool lit;
+
+  if ((x < 0) || (x >= SSD1306_DISPLAY_WIDTH) ||
+      (y < 0) || (y >= SSD1306_DISPLAY_HEIGHT) || !emu_display_on) {
+    return false;
+  }
+  if (emu_all_on) {
+    return true;
+  }
+
+  lit = (emu_gddram[y / 8][x] >> (y & 7)) & 0x1;
+  return lit != emu_inverse;
+}
+
+/**
+ * @brief   Emulator statistics.
+ * @details Copies traffic statistics since last reset.
+ *
+ * @param[out] stats    Statistics.
+ * @return  None.
+ */
+void ssd1306_emu_stats_get(ssd1306_emu_stats_t *stats)
+{
+  *stats = emu_stats;
+}
+
+/**
+ * @brief   Emulator statistics reset.
+ * @details Clears traffic statistics.
+ *
+ * @return  None.
+ */
+void ssd1306_emu_stats_reset(void)
+{
+  memset(&emu_stats, 0, sizeof(emu_stats));
+}
+
+/**
+ * @brief   Writes panel as PBM image.
+ * @details Binary (P4) portable bitmap of @ref ssd1306_emu_pixel, lit
+ *          pixels are white as on the panel.
+ *
+ * @param[in] path    Image file to write.
+ * @return  Execution error code @ref I2_ERROR.
+ */
+i2_error ssd1306_emu_write_pbm(const char *path)
+{
+  uint8_t row[SSD1306_DISPLAY_WIDTH / 8];
+  int16_t x, y;
+  FILE *file;
+  i2_error err = I2_SUCCESS;
+
+  file = fopen(path, "wb");
+  if (file == NULL) {
+    return I2_FAILURE;
+  }
+
+  fprintf(file, "P4\n%d %d\n", SSD1306_DISPLAY_WIDTH, SSD1306_DISPLAY_HEIGHT);
+  for (y = 0; y < SSD1306_DISPLAY_HEIGHT; y++) {
+    memset(row, 0, sizeof(row));
+    for (x = 0; x < SSD1306_DISPLAY_WIDTH; x++) {
+      /* PBM 1 is black */
+      if (!ssd1306_emu_pixel(y, x)) {
+        row[x / 8] |= 0x80 >> (x & 7);
+      }
+    }
+    if (fwrite(row, sizeof(row), 1, file) != 1) {
+      err = I2_FAILURE;
+      break;
+    }
+  }
+
+  if (fclose(file) != 0) {
+    err = I2_FAILURE;
+  }
+
+  return err;
+}
+
+/************************ (C) COPYRIGHT iota2 ***[i2]*****END OF FILE**********/
@@ -0,0 +1,274 @@
+/**
+ * @author      iota square [i2]
+ * <pre>
+ * ██╗ ██████╗ ████████╗ █████╗ ██████╗
+ * ██║██╔═══██╗╚══██╔══╝██╔══██╗╚════██╗
+ * ██║██║   ██║   ██║   ███████║ █████╔╝
+ * ██║██║   ██║   ██║   ██╔══██║██╔═══╝
+ * ██║╚██████╔╝   ██║   ██║  ██║███████╗
+ * ╚═╝ ╚═════╝    ╚═╝   ╚═╝  ╚═╝╚══════╝
+ * </pre>
+ *
+ * @date        17-10-2026
+ * @file        i2_oled_ssd1306_spi.c
+ * @brief       SSD1306 OLED display SPI backend.
+ *
+ * @copyright   GNU GPU v3
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * Free Software, Hell Yeah!
+ *
+ **/
+
+/* Includes ------------------------------------------------------------------*/
+#include "i2_oled_ssd1306_spi.h"
+
+#if defined ( ENABLE_RTOS_AWARE_HAL )
+#include <FreeRTOS.h>
+#include <task.h>
+#endif /* ENABLE_RTOS_AWARE_HAL */
+
+/**
+ * @defgroup SSD1306_HW_SPEC SSD1306 Hardware Pins Definition.
+ * Pin configurations of SSD1306 LCD module.
+ *
+ * @{
+ *
+ *    | PIN No. | SSD1306 PIN   | PIN ID    |  MCU  |
+ *    |---------|---------------|-----------|-------|
+ *    |    1    | GND           |  0 V      |  GND  |
+ *    |    2    | VCC           |  3.3 V    |  VCC  |
+ *    |    3    | CLOCK         |  C        |  SCK  |
+ *    |    4    | DATA          |  D        |  MOSI |
+ *    |    5    | RESET         |  ST       |  RST  |
+ *    |    6    | DATA/CMD      |  D/C      |  CMD  |
+ *    |    7    | CHIP SELECT   |  CS       |  NSS  |
+ */
+#define SSD1306_PIN_CS            GPIOG, GPIO_PIN_14  /**< Chip Select Pin    */
+#define SSD1306_PIN_DC            GPIOH, GPIO_PIN_2   /**< Data / CMD Pin     */
+#define SSD1306_PIN_RST           GPIOC, GPIO_PIN_7   /**< Display Reset Pin  */
+/** @} */ /* SSD1306_HW_SPEC */
+
+/**
+ * @defgroup SSD1306_SPI_SPEC SSD1306 SPI instance.
+ * SPI interface and Chip Select definition.
+ *
+ * @{
+ */
+/** @brief ssd1306 display control instance */
+static i2_spi_inst_t ssd1306 = {
+  "ssd1306", "SPI1", { "ssd1306_CS", SSD1306_PIN_CS }
+};
+/** @} */ /* SSD1306_SPI_SPEC */
+
+/**
+ * @defgroup SSD1306_PIN_SPEC SSD1306 GPIO pins definition.
+ * DC and RST Pins Definitions for SSD1306 Interface.
+ *
+ * @{
+ */
+/** @brief Display (DC) pin GPIO instance initialization */
+static i2_gpio_inst_t ssd1306_DC  = { "ssd1306_DC",   SSD1306_PIN_DC };
+/** @brief Display (RST) GPIO instance initialization */
+static i2_gpio_inst_t ssd1306_RST = { "ssd1306_RST",  SSD1306_PIN_RST };
+/** @brief Current level of DC pin, true in data mode */
+static bool ssd1306_dc_data;
+/** @} */ /* SSD1306_PIN_SPEC */
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief   SPI backend initialization.
+ * @details Configures DC and RST pins and SPI interface.
+ *
+ * @return  None.
+ */
+static void ssd1306_spi_init(void)
+{
+  if (i2_gpio_is_valid(&ssd1306_DC)) {
+    i2_gpio_config_out(&ssd1306_DC, false);
+  }
+  ssd1306_dc_data = false;
+
+  if (i2_gpio_is_valid(&ssd1306_RST)) {
+    i2_gpio_config_out(&ssd1306_RST, false);
+  }
+
+  /* Initialize SPI interface */
+  i2_spi_init(&ssd1306);
+  i2_spi_config_set(&ssd1306, I2_SPI_DATA_WIDTH_8BIT, I2_SPI_CLK_20_MHZ,
+                    I2_SPI_MODE_0, I2_SPI_MSBIT_FIRST);
+}
+
+/**
+ * @brief   SPI backend delay.
+ * @details Inserts time delay.
+ *
+ * @param[in] ms      Delay in ms.
+ * @return  None.
+ */
+static void ssd1306_spi_delay(uint32_t ms)
+{
+  ssd1306_delay(ms);
+}
+
+/**
+ * @brief   SPI backend reset.
+ * @details Drives RST pin, reset is active low.
+ *
+ * @param[in] asserted  Holds display in reset if true.
+ * @return  None.
+ */
+static void ssd1306_spi_reset(bool asserted)
+{
+  i2_gpio_set(&ssd1306_RST, asserted ? I2_LOW : I2_HIGH);
+}
+
+/**
+ * @brief   Selects SPI data or command mode.
+ * @details DC pin is only written when mode changes.
+ *
+ * @param[in] data    Data mode if true, command mode otherwise.
+ * @return  None.
+ */
+static inline void ssd1306_spi_dc(bool data)
+{
+  if (ssd1306_dc_data != data) {
+    i2_gpio_set(&ssd1306_DC, data ? I2_HIGH : I2_LOW);
+    ssd1306_dc_data = data;
+  }
+}
+
+/**
+ * @brief   SPI backend command write.
+ * @details Asserts DC pin in command mode and writes commands.
+ *
+ * @param[in] cmd     Commands and their arguments.
+ * @param[in] size    Number of bytes.
+ * @return  None.
+ */
+static void ssd1306_spi_write_cmd(const uint8_t *cmd, uint16_t size)
+{
+  ssd1306_spi_dc(false);
+  ssd1306_write_buffer((uint8_t *)cmd, size);
+}
+
+/**
+ * @brief   SPI backend data write.
+ * @details Asserts DC pin in data mode and writes all segments as a single
+ *          SPI transaction.
+ *
+ * @param[in] segments  Data segments to write.
+ * @param[in] count     Number of segments.
+ * @return  None.
+ */
+static void ssd1306_spi_write_data(const ssd1306_segment_t *segments,
+                                   uint8_t count)
+{
+  i2_spi_xfer_t xfers[SSD1306_DISPLAY_PAGES];
+  uint8_t i;
+
+  i2_assert(count <= SSD1306_DISPLAY_PAGES);
+  for (i = 0; i < count; i++) {
+    xfers[i].txbuf = segments[i].data;
+    xfers[i].rxbuf = NULL;
+    xfers[i].size  = segments[i].size;
+  }
+
+  ssd1306_spi_dc(true);
+  if (i2_spi_transaction(&ssd1306, xfers, count,
+      SSD1306_SPI_TIMEOUT) != I2_SUCCESS) {
+    i2_assert(0);
+  }
+}
+
+/* Public variables ----------------------------------------------------------*/
+/** @brief SPI and GPIO display backend */
+const ssd1306_backend_t ssd1306_spi_backend = {
+  ssd1306_spi_init,
+  ssd1306_spi_reset,
+  ssd1306_spi_write_cmd,
+  ssd1306_spi_write_data,
+  ssd1306_spi_delay,
+};
+
+/* Public functions ----------------------------------------------------------*/
+/**
+ * @brief   Inserts time delay.
+ * @details Blocks calling task only once scheduler is running, before that
+ *          waits on DWT cycle counter, which does not depend on SysTick.
+ *
+ * @param[in] ms    Delay in ms.
+ * @return  None.
+ */
+void ssd1306_delay(uint32_t ms)
+{
+  uint32_t start;
+  uint32_t cycles = SystemCoreClock / 1000;
+
+  if (ms == 0) {
+    return;
+  }
+
+#if defined ( ENABLE_RTOS_AWARE_HAL )
+  if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) {
+    /* One more tick, first one is partially elapsed already */
+    vTaskDelay(pdMS_TO_TICKS(ms) + 1);
+    return;
+  }
+#endif /* ENABLE_RTOS_AWARE_HAL */
+
+  if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  }
+
+  /* Per ms, so that cycle count never wraps within a wait */
+  while (ms--) {
+    start = DWT->CYCCNT;
+    while ((DWT->CYCCNT - start) < cycles) {
+    }
+  }
+}
+
+/**
+ * @brief   SPI write.
+ * @details Writes a single byte to SPI.
+ *
+ * @param[in] byte      data to send.
+ * @return  None.
+ */
+void ssd1306_write_byte(uint8_t byte)
+{
+  if (i2_spi_xfer(&ssd1306, &byte, NULL, 1,
+      SSD1306_SPI_TIMEOUT) != I2_SUCCESS) {
+    i2_assert(0);
+  }
+}
+
+/**
+ * @brief   SPI buffer write.
+ * @details Writes data buffer over SPI.
+ *
+ * @param[in] buff             Buffer to send.
+ * @param[in] bytes_to_write   Number of bytes.
+ * @return  None.
+ */
+void ssd1306_write_buffer(uint8_t* buff, uint16_t bytes_to_write)
+{
+  if (i2_spi_xfer(&ssd1306, buff, NULL, bytes_to_write,
+      SSD1306_SPI_TIMEOUT) != I2_SUCCESS) {
+    i2_assert(0);
+  }
+}
+
+/************************ (C) COPYRIGHT iota2 ***[i2]*****END OF FILE**********/
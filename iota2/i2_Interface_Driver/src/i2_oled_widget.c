@@ -0,0 +1,523 @@
+/**
+ * @author      iota square [i2]
+ * <pre>
+ * ██╗ ██████╗ ████████╗ █████╗ ██████╗
+ * ██║██╔═══██╗╚══██╔══╝██╔══██╗╚════██╗
+ * ██║██║   ██║   ██║   ███████║ █████╔╝
+ * ██║██║   ██║   ██║   ██╔══██║██╔═══╝
+ * ██║╚██████╔╝   ██║   ██║  ██║███████╗
+ * ╚═╝ ╚═════╝    ╚═╝   ╚═╝  ╚═╝╚══════╝
+ * </pre>
+ *
+ * @date        17-10-2026
+ * @file        i2_oled_widget.c
+ * @brief       OLED retained-mode widgets interface.
+ *
+ * @copyright   GNU GPU v3
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * Free Software, Hell Yeah!
+ *
+ **/
+
+
+/* Includes ------------------------------------------------------------------*/
+#include "i2_oled_widget.h"
+
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+/** @brief Horizontal advance of a character at text size */
+#define WIDGET_CHAR_ADVANCE(size)   ( 6 * (size) )
+/** @brief Height of a text line at text size */
+#define WIDGET_LINE_HEIGHT(size)    ( 8 * (size) )
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief   Common widget initialization.
+ * @details Sets bounds of widget and marks it for drawing.
+ *
+ * @param[in] widget  Widget to initialize.
+ * @param[in] type    Widget type @ref i2_widget_type_t.
+ * @param[in] y       (y) coordinate of widget.
+ * @param[in] x       (x) coordinate of widget.
+ * @param[in] h       Height of widget.
+ * @param[in] w       Width of widget.
+ * @return  None.
+ */
+static void widget_init(i2_widget_t *widget, i2_widget_type_t type,
+                        int16_t y, int16_t x, int16_t h, int16_t w)
+{
+  memset(widget, 0, sizeof(*widget));
+  widget->type  = type;
+  widget->y     = y;
+  widget->x     = x;
+  widget->h     = h;
+  widget->w     = w;
+  widget->size  = 1;
+  widget->dirty = true;
+}
+
+/**
+ * @brief   Clears widget area.
+ * @details Clears bounds of widget in frame buffer.
+ *
+ * @param[in] widget  Widget to clear.
+ * @return  None.
+ */
+static void widget_clear(i2_widget_t *widget)
+{
+  if ( (widget->h > 0) && (widget->w > 0) ) {
+    ssd1306_fill_rectangle(widget->y, widget->x, widget->h, widget->w,
+                           SSD1306_BLACK, SSD1306_LAYER1);
+  }
+}
+
+/**
+ * @brief   Hashes a label text.
+ * @details FNV-1a hash of text contents, lets a label notice changed
+ *          contents even when the same buffer is set again.
+ *
+ * @param[in] text    Text to hash, or NULL.
+ * @return  Hash of text.
+ */
+static uint32_t widget_text_hash(const char *text)
+{
+  uint32_t hash = 2166136261u;
+
+  while ( text && *text ) {
+    hash = (hash ^ (uint8_t)*text++) * 16777619u;
+  }
+  return hash;
+}
+
+/**
+ * @brief   Formats a value widget.
+ * @details Value is right aligned in its reserved digits, followed by unit.
+ *          A value which does not fit, sign included, is shown as '#'
+ *          characters instead of a truncated number.
+ *
+ * @param[in]  widget   Value widget.
+ * @param[out] text     Formatted text, at least I2_WIDGET_VALUE_CHARS + 1.
+ * @return  None.
+ */
+static void widget_value_format(i2_widget_t *widget, char *text)
+{
+  uint32_t value = (widget->u.value.value < 0) ?
+                   -(uint32_t)widget->u.value.value :
+                   (uint32_t)widget->u.value.value;
+  int32_t  i = widget->u.value.digits;
+
+  text[i] = '\0';
+  do {
+    text[--i] = '0' + (value % 10);
+    value /= 10;
+  } while ( value && (i > 0) );
+
+  if ( value || ((widget->u.value.value < 0) && (i == 0)) ) {
+    memset(text, '#', widget->u.value.digits);
+    return;
+  }
+
+  if ( widget->u.value.value < 0 ) {
+    text[--i] = '-';
+  }
+  while ( i > 0 ) {
+    text[--i] = ' ';
+  }
+}
+
+/**
+ * @brief   Draws a bar gauge.
+ * @details Outline is drawn once, afterwards only the difference between
+ *          displayed and new fill is drawn.
+ *
+ * @param[in] widget  Bar widget.
+ * @return  None.
+ */
+static void widget_bar_draw(i2_widget_t *widget)
+{
+  int16_t fill  = widget->u.bar.fill;
+  int16_t drawn = widget->u.bar.drawn;
+
+  if ( drawn < 0 ) {
+    widget_clear(widget);
+    ssd1306_draw_rectangle(widget->y, widget->x, widget->h, widget->w,
+                           SSD1306_WHITE, SSD1306_LAYER1);
+    drawn = 0;
+  }
+
+  if ( fill > drawn ) {
+    ssd1306_fill_rectangle(widget->y + 1, widget->x + 1 + drawn,
+                           widget->h - 2, fill - drawn,
+                           SSD1306_WHITE, SSD1306_LAYER1);
+  } else if ( fill < drawn ) {
+    ssd1306_fill_rectangle(widget->y + 1, widget->x + 1 + fill,
+                           widget->h - 2, drawn - fill,
+                           SSD1306_BLACK, SSD1306_LAYER1);
+  }
+  widget->u.bar.drawn = fill;
+}
+
+/**
+ * @brief   Draws a log widget.
+ * @details Lines are drawn oldest first from top of widget.
+ *
+ * @param[in] widget  Log widget.
+ * @return  None.
+ */
+static void widget_log_draw(i2_widget_t *widget)
+{
+  uint8_t i;
+  uint8_t line;
+
+  widget_clear(widget);
+  for ( i = 0; i < widget->u.log.count; i++ ) {
+    line = (widget->u.log.head + i) % widget->u.log.lines;
+    ssd1306_draw_text_run(widget->y + (i * WIDGET_LINE_HEIGHT(widget->size)),
+                          widget->x, widget->u.log.line[line], widget->size,
+                          SSD1306_WHITE, SSD1306_LAYER1);
+  }
+}
+
+/**
+ * @brief   Draws a widget.
+ * @details Draws widget into frame buffer, which marks its area dirty.
+ *
+ * @param[in] widget  Widget to draw.
+ * @return  None.
+ */
+static void widget_draw(i2_widget_t *widget)
+{
+  char text[I2_WIDGET_VALUE_CHARS + 1];
+
+  switch ( widget->type ) {
+  case I2_WIDGET_LABEL:
+    widget_clear(widget);
+    if ( widget->u.label.text ) {
+      ssd1306_draw_text_run(widget->y, widget->x, widget->u.label.text,
+                            widget->size, SSD1306_WHITE, SSD1306_LAYER1);
+    }
+    break;
+  case I2_WIDGET_VALUE:
+    widget_clear(widget);
+    widget_value_format(widget, text);
+    ssd1306_draw_text_run(widget->y, widget->x, text, widget->size,
+                          SSD1306_WHITE, SSD1306_LAYER1);
+    if ( widget->u.value.unit ) {
+      ssd1306_draw_text_run(widget->y, widget->x +
+                            (widget->u.value.digits *
+                             WIDGET_CHAR_ADVANCE(widget->size)),
+                            widget->u.value.unit, widget->size,
+                            SSD1306_WHITE, SSD1306_LAYER1);
+    }
+    break;
+  case I2_WIDGET_BAR:
+    widget_bar_draw(widget);
+    break;
+  case I2_WIDGET_ICON:
+    widget_clear(widget);
+    if ( widget->u.icon.visible && widget->u.icon.bitmap ) {
+      ssd1306_draw_bitmap(widget->y, widget->x, widget->u.icon.bitmap,
+                          widget->h, widget->w, SSD1306_WHITE, SSD1306_LAYER1);
+    }
+    break;
+  case I2_WIDGET_LOG:
+    widget_log_draw(widget);
+    break;
+  }
+}
+
+/* Public functions ----------------------------------------------------------*/
+/**
+ * @brief   Initializes a label widget.
+ * @details Label bounds follow its text.
+ *
+ * @param[in] widget  Widget to initialize.
+ * @param[in] y       (y) coordinate of widget.
+ * @param[in] x       (x) coordinate of widget.
+ * @param[in] size    Text size @ref SSD1306_TEXT_SPEC.
+ * @param[in] text    Text to display, kept by reference.
+ * @return  None.
+ */
+void i2_widget_label_init(i2_widget_t *widget, int16_t y, int16_t x,
+                          uint8_t size, const char *text)
+{
+  widget_init(widget, I2_WIDGET_LABEL, y, x, WIDGET_LINE_HEIGHT(size), 0);
+  widget->size = size;
+  i2_widget_label_set(widget, text);
+}
+
+/**
+ * @brief   Initializes a value widget.
+ * @details Value is displayed right aligned in @p digits characters,
+ *          followed by @p unit.
+ *
+ * @param[in] widget  Widget to initialize.
+ * @param[in] y       (y) coordinate of widget.
+ * @param[in] x       (x) coordinate of widget.
+ * @param[in] size    Text size @ref SSD1306_TEXT_SPEC.
+ * @param[in] digits  Characters reserved for value, sign included.
+ * @param[in] unit    Unit text, kept by reference, or NULL.
+ * @return  None.
+ */
+void i2_widget_value_init(i2_widget_t *widget, int16_t y, int16_t x,
+                          uint8_t size, uint8_t digits, const char *unit)
+{
+  int16_t chars;
+
+  digits = (digits > I2_WIDGET_VALUE_CHARS) ? I2_WIDGET_VALUE_CHARS : digits;
+  digits = (digits == 0) ? 1 : digits;
+  chars = digits + (unit ? strlen(unit) : 0);
+  widget_init(widget, I2_WIDGET_VALUE, y, x, WIDGET_LINE_HEIGHT(size),
+              chars * WIDGET_CHAR_ADVANCE(size));
+  widget->size = size;
+  widget->u.value.digits = digits;
+  widget->u.value.unit = unit;
+}
+
+/**
+ * @brief   Initializes a bar gauge widget.
+ * @details Bar is drawn as an outline filled proportional to its value.
+ *
+ * @param[in] widget  Widget to initialize.
+ * @param[in] y       (y) coordinate of widget.
+ * @param[in] x       (x) coordinate of widget.
+ * @param[in] h       Height of widget.
+ * @param[in] w       Width of widget.
+ * @param[in] min     Value of empty bar.
+ * @param[in] max     Value of full bar.
+ * @return  None.
+ */
+void i2_widget_bar_init(i2_widget_t *widget, int16_t y, int16_t x,
+                        int16_t h, int16_t w, int32_t min, int32_t max)
+{
+  widget_init(widget, I2_WIDGET_BAR, y, x, h, w);
+  widget->u.bar.min = min;
+  widget->u.bar.max = max;
+  widget->u.bar.drawn = -1;
+}
+
+/**
+ * @brief   Initializes an icon widget.
+ * @details Icon is hidden until shown by @ref i2_widget_icon_show.
+ *
+ * @param[in] widget  Widget to initialize.
+ * @param[in] y       (y) coordinate of widget.
+ * @param[in] x       (x) coordinate of widget.
+ * @param[in] h       Height of icon bitmap.
+ * @param[in] w       Width of icon bitmap.
+ * @param[in] bitmap  Icon bitmap, kept by reference.
+ * @return  None.
+ */
+void i2_widget_icon_init(i2_widget_t *widget, int16_t y, int16_t x,
+                         int16_t h, int16_t w, uint8_t *bitmap)
+{
+  widget_init(widget, I2_WIDGET_ICON, y, x, h, w);
+  widget->u.icon.bitmap = bitmap;
+}
+
+/**
+ * @brief   Initializes a log widget.
+ * @details Log spans full width of text lines, oldest line is dropped when
+ *          a new line does not fit.
+ *
+ * @param[in] widget  Widget to initialize.
+ * @param[in] y       (y) coordinate of widget.
+ * @param[in] x       (x) coordinate of widget.
+ * @param[in] size    Text size @ref SSD1306_TEXT_SPEC.
+ * @param[in] lines   Lines displayed (1..I2_WIDGET_LOG_LINES).
+ * @return  None.
+ */
+void i2_widget_log_init(i2_widget_t *widget, int16_t y, int16_t x,
+                        uint8_t size, uint8_t lines)
+{
+  lines = (lines > I2_WIDGET_LOG_LINES) ? I2_WIDGET_LOG_LINES : lines;
+  lines = (lines == 0) ? 1 : lines;
+  widget_init(widget, I2_WIDGET_LOG, y, x, lines * WIDGET_LINE_HEIGHT(size),
+              I2_WIDGET_LOG_LINE_CHARS * WIDGET_CHAR_ADVANCE(size));
+  widget->size = size;
+  widget->u.log.lines = lines;
+}
+
+/**
+ * @brief   Adds a widget to screen.
+ * @details Widget is drawn on next @ref i2_widget_update of screen.
+ *
+ * @param[in] screen  Screen to add widget to.
+ * @param[in] widget  Initialized widget.
+ * @return  None.
+ */
+void i2_widget_add(i2_widget_screen_t *screen, i2_widget_t *widget)
+{
+  widget->next = screen->first;
+  widget->dirty = true;
+  screen->first = widget;
+}
+
+/**
+ * @brief   Invalidates a widget.
+ * @details Forces complete redraw of widget on next update.
+ *
+ * @param[in] widget  Widget to redraw.
+ * @return  None.
+ */
+void i2_widget_invalidate(i2_widget_t *widget)
+{
+  if ( widget->type == I2_WIDGET_BAR ) {
+    widget->u.bar.drawn = -1;
+  }
+  widget->dirty = true;
+}
+
+/**
+ * @brief   Changes label text.
+ * @details Old text is cleared and bounds follow new text. Text contents
+ *          are compared, so a buffer edited in place and set again is
+ *          redrawn, while the same contents are not.
+ *
+ * @param[in] widget  Label widget.
+ * @param[in] text    Text to display, kept by reference.
+ * @return  None.
+ */
+void i2_widget_label_set(i2_widget_t *widget, const char *text)
+{
+  uint32_t hash = widget_text_hash(text);
+  int16_t  w = text ? (strlen(text) * WIDGET_CHAR_ADVANCE(widget->size)) : 0;
+
+  if ( (widget->u.label.hash == hash) && (widget->w == w) &&
+       !widget->dirty ) {
+    widget->u.label.text = text;
+    return;
+  }
+
+  widget_clear(widget);
+  widget->u.label.text = text;
+  widget->u.label.hash = hash;
+  widget->w = w;
+  widget->dirty = true;
+}
+
+/**
+ * @brief   Changes displayed value.
+ * @details Widget is redrawn only if value changes.
+ *
+ * @param[in] widget  Value widget.
+ * @param[in] value   Value to display.
+ * @return  None.
+ */
+void i2_widget_value_set(i2_widget_t *widget, int32_t value)
+{
+  if ( widget->u.value.value != value ) {
+    widget->u.value.value = value;
+    widget->dirty = true;
+  }
+}
+
+/**
+ * @brief   Changes bar gauge value.
+ * @details Widget is redrawn only if filled width changes.
+ *
+ * @param[in] widget  Bar widget.
+ * @param[in] value   Value to display, clamped to bar range.
+ * @return  None.
+ */
+void i2_widget_bar_set(i2_widget_t *widget, int32_t value)
+{
+  int32_t range = widget->u.bar.max - widget->u.bar.min;
+  int32_t inner = widget->w - 2;
+  int16_t fill;
+
+  if ( (range <= 0) || (inner <= 0) || (value <= widget->u.bar.min) ) {
+    fill = 0;
+  } else if ( value >= widget->u.bar.max ) {
+    fill = inner;
+  } else {
+    fill = (int16_t)(((int64_t)(value - widget->u.bar.min) * inner) / range);
+  }
+
+  if ( widget->u.bar.fill != fill ) {
+    widget->u.bar.fill = fill;
+    widget->dirty = true;
+  }
+}
+
+/**
+ * @brief   Shows or hides an icon.
+ * @details Widget is redrawn only if visibility changes.
+ *
+ * @param[in] widget  Icon widget.
+ * @param[in] visible Show icon if true, hide otherwise.
+ * @return  None.
+ */
+void i2_widget_icon_show(i2_widget_t *widget, bool visible)
+{
+  if ( widget->u.icon.visible != visible ) {
+    widget->u.icon.visible = visible;
+    widget->dirty = true;
+  }
+}
+
+/**
+ * @brief   Appends a line to log.
+ * @details Text longer than a line is truncated, oldest line is dropped
+ *          when log is full.
+ *
+ * @param[in] widget  Log widget.
+ * @param[in] text    Text of new line, copied.
+ * @return  None.
+ */
+void i2_widget_log_append(i2_widget_t *widget, const char *text)
+{
+  uint8_t line;
+
+  if ( widget->u.log.count < widget->u.log.lines ) {
+    line = (widget->u.log.head + widget->u.log.count) % widget->u.log.lines;
+    widget->u.log.count++;
+  } else {
+    line = widget->u.log.head;
+    widget->u.log.head = (widget->u.log.head + 1) % widget->u.log.lines;
+  }
+
+  strncpy(widget->u.log.line[line], text, I2_WIDGET_LOG_LINE_CHARS);
+  widget->u.log.line[line][I2_WIDGET_LOG_LINE_CHARS] = '\0';
+  widget->dirty = true;
+}
+
+/**
+ * @brief   Updates screen.
+ * @details Redraws only widgets whose content changed, then refreshes the
+ *          display once. Refresh sends only the areas of redrawn widgets.
+ *
+ * @param[in] screen  Screen to update.
+ * @return  true if any widget was redrawn.
+ */
+bool i2_widget_update(i2_widget_screen_t *screen)
+{
+  i2_widget_t *widget;
+  bool redrawn = false;
+
+  for ( widget = screen->first; widget; widget = widget->next ) {
+    if ( widget->dirty ) {
+      widget_draw(widget);
+      widget->dirty = false;
+      redrawn = true;
+    }
+  }
+
+  if ( redrawn ) {
+    ssd1306_refresh();
+  }
+  return redrawn;
+}
+
+/************************ (C) COPYRIGHT iota2 ***[i2]*****END OF FILE**********/
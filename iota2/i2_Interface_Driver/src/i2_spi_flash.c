@@ -0,0 +1,872 @@
+/**
+ * @author      iota square [i2]
+ * <pre>
+ * ██╗ ██████╗ ████████╗ █████╗ ██████╗
+ * ██║██╔═══██╗╚══██╔══╝██╔══██╗╚════██╗
+ * ██║██║   ██║   ██║   ███████║ █████╔╝
+ * ██║██║   ██║   ██║   ██╔══██║██╔═══╝
+ * ██║╚██████╔╝   ██║   ██║  ██║███████╗
+ * ╚═╝ ╚═════╝    ╚═╝   ╚═╝  ╚═╝╚══════╝
+ * </pre>
+ *
+ * @date        17-10-2026
+ * @file        i2_spi_flash.c
+ * @brief       JEDEC SPI NOR flash interface.
+ *
+ * @copyright   GNU GPU v3
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * Free Software, Hell Yeah!
+ *
+ **/
+
+/* Includes ------------------------------------------------------------------*/
+#include "i2_spi_flash.h"
+
+#include <string.h>
+#if defined ( ENABLE_RTOS_AWARE_HAL )
+#include <FreeRTOS.h>
+#include <task.h>
+#endif /* ENABLE_RTOS_AWARE_HAL */
+
+/* Private defines -----------------------------------------------------------*/
+/**
+ * @defgroup SPI_FLASH_CMD SPI NOR flash instructions.
+ * Standard JEDEC instructions, common among SPI NOR flash vendors.
+ *
+ * @{
+ */
+#define SPI_FLASH_CMD_WRITE_ENABLE    ( 0x06 )  /**< Set write enable latch   */
+#define SPI_FLASH_CMD_READ_STATUS     ( 0x05 )  /**< Read status register     */
+#define SPI_FLASH_CMD_READ_JEDEC_ID   ( 0x9F )  /**< Read JEDEC ID            */
+#define SPI_FLASH_CMD_READ_SFDP       ( 0x5A )  /**< Read SFDP tables         */
+#define SPI_FLASH_CMD_FAST_READ       ( 0x0B )  /**< Read with dummy cycles   */
+#define SPI_FLASH_CMD_PAGE_PROGRAM    ( 0x02 )  /**< Program up to one page   */
+#define SPI_FLASH_CMD_ERASE_4K        ( 0x20 )  /**< Erase 4KB sector         */
+#define SPI_FLASH_CMD_ERASE_32K       ( 0x52 )  /**< Erase 32KB block         */
+#define SPI_FLASH_CMD_ERASE_64K       ( 0xD8 )  /**< Erase 64KB block         */
+#define SPI_FLASH_CMD_SUSPEND         ( 0x75 )  /**< Suspend erase / program  */
+#define SPI_FLASH_CMD_RESUME          ( 0x7A )  /**< Resume erase / program   */
+#define SPI_FLASH_CMD_ENTER_4B_ADDR   ( 0xB7 )  /**< Enter 4 byte addressing  */
+/** @} */ /* SPI_FLASH_CMD */
+
+/**
+ * @defgroup SPI_FLASH_SR SPI NOR flash status register.
+ * Status register bits.
+ *
+ * @{
+ */
+#define SPI_FLASH_SR_WIP              ( 0x01 )  /**< Write in progress        */
+#define SPI_FLASH_SR_WEL              ( 0x02 )  /**< Write enable latch       */
+/** @} */ /* SPI_FLASH_SR */
+
+/**
+ * @defgroup SPI_FLASH_SFDP SPI NOR flash SFDP layout.
+ * JESD216 header and Basic Flash Parameter Table (BFPT) fields.
+ *
+ * @{
+ */
+#define SFDP_SIGNATURE                ( 0x50444653 )  /**< "SFDP"             */
+#define SFDP_BFPT_ID                  ( 0xFF00 )  /**< BFPT parameter ID      */
+#define SFDP_BFPT_MAX_DWORDS          ( 16 )      /**< DWORDs used from BFPT  */
+#define SFDP_DUMMY_BYTES              ( 1 )       /**< 8 dummy clocks         */
+#define BFPT_DW1_ADDR_BYTES(dw)       ( ((dw) >> 17) & 0x3 ) /**< Addressing  */
+#define BFPT_ADDR_3B_4B               ( 1 )       /**< 3 or 4 byte address    */
+#define BFPT_ADDR_4B                  ( 2 )       /**< 4 byte address only    */
+#define BFPT_DW2_DENSITY_POW2         ( 1UL << 31 ) /**< Density is 2^N bits  */
+#define BFPT_DW12_NO_SUSPEND          ( 1UL << 31 ) /**< Suspend unsupported  */
+/** @} */ /* SPI_FLASH_SFDP */
+
+#define SPI_FLASH_FAST_READ_DUMMY     ( 1 )     /**< 8 dummy clocks for 0x0B  */
+#define SPI_FLASH_MAX_HEADER          ( 6 )     /**< Opcode, address, dummy   */
+#define SPI_FLASH_PROGRAM_TIMEOUT     ( 10 )    /**< Page program timeout ms  */
+#define SPI_FLASH_ERASE_TIMEOUT       ( 4000 )  /**< Block erase timeout ms   */
+#define SPI_FLASH_SUSPEND_TIMEOUT     ( 2 )     /**< Suspend latency ms       */
+#define SPI_FLASH_3B_ADDR_LIMIT       ( 1UL << 24 ) /**< 3 byte address range */
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief   Current tick.
+ * @details Time base for flash busy polling, in milliseconds. Kernel tick
+ *          is frozen until scheduler starts, HAL tick is used until then.
+ *
+ * @return  Current tick count.
+ */
+static uint32_t spi_flash_tick(void)
+{
+#if defined ( ENABLE_RTOS_AWARE_HAL )
+  if ( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING ) {
+    return (uint32_t)xTaskGetTickCount();
+  }
+#endif /* ENABLE_RTOS_AWARE_HAL */
+  return HAL_GetTick();
+}
+
+/**
+ * @brief   Busy poll back-off.
+ * @details Gives CPU to other tasks while flash is busy.
+ *
+ * @param[in] sleep       Sleep for a tick instead of only yielding.
+ * @return  None.
+ */
+static void spi_flash_backoff(bool sleep)
+{
+#if defined ( ENABLE_RTOS_AWARE_HAL )
+  if ( xTaskGetSchedulerState() != taskSCHEDULER_RUNNING ) {
+    return;
+  }
+  if ( sleep ) {
+    vTaskDelay(1);
+  } else {
+    taskYIELD();
+  }
+#else
+  (void)sleep;
+#endif /* ENABLE_RTOS_AWARE_HAL */
+}
+
+/**
+ * @brief   Instruction header builder.
+ * @details Packs opcode and big endian address into a header buffer.
+ *
+ * @param[out] *hdr       Header buffer, @ref SPI_FLASH_MAX_HEADER bytes.
+ * @param[in] opcode      Flash instruction.
+ * @param[in] addr        Flash address.
+ * @param[in] addr_len    Address bytes to send, 0 for no address.
+ * @return  Header length in bytes.
+ */
+static int32_t spi_flash_header(uint8_t *hdr, uint8_t opcode, uint32_t addr,
+                                uint8_t addr_len)
+{
+  int32_t len = 0;
+
+  hdr[len++] = opcode;
+  while ( addr_len-- ) {
+    hdr[len++] = (uint8_t)(addr >> (8 * addr_len));
+  }
+
+  return len;
+}
+
+/**
+ * @brief   Flash instruction.
+ * @details Sends an instruction header, followed by an optional data phase,
+ *          under one CS assertion.
+ *
+ * @param[in] *flash      Flash device.
+ * @param[in] *hdr        Instruction header.
+ * @param[in] hdr_len     Header length.
+ * @param[in] *txbuf      Data to send, NULL if none.
+ * @param[out] *rxbuf     Data to receive, NULL if none.
+ * @param[in] size        Data phase length.
+ * @return  Execution error code @ref I2_ERROR.
+ */
+static i2_error spi_flash_cmd(i2_spi_flash_t *flash, const uint8_t *hdr,
+                              int32_t hdr_len, const uint8_t *txbuf,
+                              uint8_t *rxbuf, int32_t size)
+{
+  i2_spi_xfer_t xfers[2] = {
+    { hdr,    NULL,   hdr_len },
+    { txbuf,  rxbuf,  size    },
+  };
+
+  return i2_spi_transaction(flash->spi, xfers, (size > 0) ? 2 : 1,
+                            I2_SPI_FLASH_TIMEOUT);
+}
+
+/**
+ * @brief   Status read.
+ * @details Reads flash status register.
+ *
+ * @param[in] *flash      Flash device.
+ * @param[out] *status    Status register value.
+ * @return  Execution error code @ref I2_ERROR.
+ */
+static i2_error spi_flash_status(i2_spi_flash_t *flash, uint8_t *status)
+{
+  uint8_t cmd = SPI_FLASH_CMD_READ_STATUS;
+
+  return spi_flash_cmd(flash, &cmd, 1, NULL, status, 1);
+}
+
+/**
+ * @brief   Simple instruction.
+ * @details Sends an instruction without address or data.
+ *
+ * @param[in] *flash      Flash device.
+ * @param[in] opcode      Flash instruction.
+ * @return  Execution error code @ref I2_ERROR.
+ */
+static i2_error spi_flash_opcode(i2_spi_flash_t *flash, uint8_t opcode)
+{
+  return spi_flash_cmd(flash, &opcode, 1, NULL, NULL, 0);
+}
+
+/**
+ * @brief   Wait for flash.
+ * @details Polls status register until write in progress is cleared.
+ *
+ * @param[in] *flash      Flash device.
+ * @param[in] timeout     Timeout in ms.
+ * @param[in] sleep       Sleep between polls, for long operations.
+ * @return  Execution error code @ref I2_ERROR.
+ */
+static i2_error spi_flash_wait(i2_spi_flash_t *flash, uint32_t timeout,
+                               bool sleep)
+{
+  uint32_t start = spi_flash_tick();
+  uint8_t status;
+  i2_error err;
+
+  for ( ;; ) {
+    err = spi_flash_status(flash, &status);
+    if ( err != I2_SUCCESS ) {
+      return err;
+    }
+    if ( !(status & SPI_FLASH_SR_WIP) ) {
+      return I2_SUCCESS;
+    }
+    if ( (spi_flash_tick() - start) > timeout ) {
+      return I2_TIMEOUT;
+    }
+    spi_flash_backoff(sleep);
+  }
+}
+
+/**
+ * @brief   Write enable.
+ * @details Sets write enable latch, required before program and erase.
+ *
+ * @param[in] *flash      Flash device.
+ * @return  Execution error code @ref I2_ERROR.
+ */
+static i2_error spi_flash_write_enable(i2_spi_flash_t *flash)
+{
+  return spi_flash_opcode(flash, SPI_FLASH_CMD_WRITE_ENABLE);
+}
+
+/**
+ * @brief   SFDP read.
+ * @details Reads from SFDP address space, always 3 byte address and
+ *          8 dummy clocks.
+ *
+ * @param[in] *flash      Flash device.
+ * @param[in] addr        SFDP address.
+ * @param[out] *buf       Buffer to read in.
+ * @param[in] size        Bytes to read.
+ * @return  Execution error code @ref I2_ERROR.
+ */
+static i2_error spi_flash_sfdp_read(i2_spi_flash_t *flash, uint32_t addr,
+                                    uint8_t *buf, int32_t size)
+{
+  uint8_t hdr[SPI_FLASH_MAX_HEADER] = { 0 };
+  int32_t len;
+
+  len = spi_flash_header(hdr, SPI_FLASH_CMD_READ_SFDP, addr, 3);
+  len += SFDP_DUMMY_BYTES;
+
+  return spi_flash_cmd(flash, hdr, len, NULL, buf, size);
+}
+
+/**
+ * @brief   Little endian DWORD.
+ * @details Gets a DWORD from SFDP table bytes.
+ *
+ * @param[in] *p          SFDP table bytes.
+ * @param[in] idx         DWORD index, 0 based.
+ * @return  DWORD value.
+ */
+static inline uint32_t sfdp_dword(const uint8_t *p, int32_t idx)
+{
+  p += idx * 4;
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+         ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief   Erase type insert.
+ * @details Adds an erase type, keeping the list sorted by size.
+ *
+ * @param[in] *flash      Flash device.
+ * @param[in] size        Erase size in bytes.
+ * @param[in] opcode      Erase instruction.
+ * @return  None.
+ */
+static void spi_flash_erase_add(i2_spi_flash_t *flash, uint32_t size,
+                                uint8_t opcode)
+{
+  i2_spi_flash_erase_t *erase = flash->erase;
+  int32_t i;
+
+  for (i = 0; i < I2_SPI_FLASH_ERASE_TYPES; i++) {
+    if ( erase[i].size == size ) {
+      return;
+    }
+    if ( !erase[i].size || (erase[i].size > size) ) {
+      break;
+    }
+  }
+  if ( i == I2_SPI_FLASH_ERASE_TYPES ) {
+    return;
+  }
+
+  memmove(&erase[i + 1], &erase[i],
+          (I2_SPI_FLASH_ERASE_TYPES - i - 1) * sizeof(*erase));
+  erase[i].size = size;
+  erase[i].opcode = opcode;
+}
+
+/**
+ * @brief   SFDP probe.
+ * @details Reads density, addressing, page size, erase types and suspend
+ *          instructions from Basic Flash Parameter Table.
+ *
+ * @param[in] *flash      Flash device.
+ * @return  Execution error code @ref I2_ERROR.
+ */
+static i2_error spi_flash_sfdp_probe(i2_spi_flash_t *flash)
+{
+  uint8_t bfpt[SFDP_BFPT_MAX_DWORDS * 4] = { 0 };
+  uint8_t hdr[16];
+  uint32_t ptp, dw, bits;
+  int32_t dwords, i;
+  i2_error err;
+
+  /* SFDP header and first parameter header, always BFPT */
+  err = spi_flash_sfdp_read(flash, 0, hdr, sizeof(hdr));
+  if ( err != I2_SUCCESS ) {
+    return err;
+  }
+  if ( (sfdp_dword(hdr, 0) != SFDP_SIGNATURE) ||
+       ((((uint32_t)hdr[15] << 8) | hdr[8]) != SFDP_BFPT_ID) ) {
+    return I2_NOT_SUPPORTED;
+  }
+
+  dwords = hdr[11];
+  if ( dwords > SFDP_BFPT_MAX_DWORDS ) {
+    dwords = SFDP_BFPT_MAX_DWORDS;
+  }
+  if ( dwords < 9 ) {
+    return I2_NOT_SUPPORTED;
+  }
+  ptp = hdr[12] | ((uint32_t)hdr[13] << 8) | ((uint32_t)hdr[14] << 16);
+
+  err = spi_flash_sfdp_read(flash, ptp, bfpt, dwords * 4);
+  if ( err != I2_SUCCESS ) {
+    return err;
+  }
+
+  /* DWORD 2: density in bits */
+  dw = sfdp_dword(bfpt, 1);
+  if ( dw & BFPT_DW2_DENSITY_POW2 ) {
+    bits = dw & ~BFPT_DW2_DENSITY_POW2;
+    flash->size = (bits >= 35) ? 0 : (uint32_t)((1ULL << bits) / 8);
+  } else {
+    flash->size = (dw / 8) + 1;
+  }
+  if ( !flash->size ) {
+    return I2_NOT_SUPPORTED;
+  }
+
+  /* DWORD 1: address bytes */
+  dw = sfdp_dword(bfpt, 0);
+  if ( (BFPT_DW1_ADDR_BYTES(dw) == BFPT_ADDR_4B) ||
+       ((BFPT_DW1_ADDR_BYTES(dw) == BFPT_ADDR_3B_4B) &&
+        (flash->size > SPI_FLASH_3B_ADDR_LIMIT)) ) {
+    flash->addr_len = 4;
+  }
+
+  /* DWORD 8 and 9: erase types as <size exponent, opcode> */
+  memset(flash->erase, 0, sizeof(flash->erase));
+  for (i = 0; i < I2_SPI_FLASH_ERASE_TYPES; i++) {
+    dw = sfdp_dword(bfpt, 7 + (i / 2)) >> (16 * (i % 2));
+    if ( (dw & 0xFF) && ((dw & 0xFF) < 32) ) {
+      spi_flash_erase_add(flash, 1UL << (dw & 0xFF), (uint8_t)(dw >> 8));
+    }
+  }
+
+  /* DWORD 11: page size, JESD216A onwards */
+  if ( dwords >= 11 ) {
+    flash->page_size = 1UL << ((sfdp_dword(bfpt, 10) >> 4) & 0xF);
+  }
+
+  /* DWORD 12 and 13: erase suspend / resume instructions */
+  if ( dwords >= 13 ) {
+    if ( sfdp_dword(bfpt, 11) & BFPT_DW12_NO_SUSPEND ) {
+      flash->suspend_opcode = 0;
+      flash->resume_opcode = 0;
+    } else {
+      dw = sfdp_dword(bfpt, 12);
+      flash->suspend_opcode = (uint8_t)(dw >> 24);
+      flash->resume_opcode = (uint8_t)(dw >> 16);
+    }
+  }
+
+  flash->sfdp = true;
+
+  return I2_SUCCESS;
+}
+
+/**
+ * @brief   Erase type select.
+ * @details Picks largest erase type aligned to address and fitting in size.
+ *
+ * @param[in] *flash      Flash device.
+ * @param[in] addr        Erase address.
+ * @param[in] size        Bytes left to erase.
+ * @return  Erase type, NULL if none fits.
+ */
+static const i2_spi_flash_erase_t* spi_flash_erase_type(i2_spi_flash_t *flash,
+                                                        uint32_t addr,
+                                                        uint32_t size)
+{
+  int32_t i;
+
+  for (i = I2_SPI_FLASH_ERASE_TYPES - 1; i >= 0; i--) {
+    const i2_spi_flash_erase_t *erase = &flash->erase[i];
+
+    if ( erase->size && !(addr & (erase->size - 1)) && (size >= erase->size) ) {
+      return erase;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief   Area check.
+ * @details Checks that an area lies inside the flash, without address
+ *          wrap around.
+ *
+ * @param[in] *flash      Flash device.
+ * @param[in] addr        Area address.
+ * @param[in] size        Area size in bytes.
+ * @return  true if area is inside flash.
+ */
+static inline bool spi_flash_area_valid(i2_spi_flash_t *flash, uint32_t addr,
+                                        uint32_t size)
+{
+  return (addr < flash->size) && (size <= (flash->size - addr));
+}
+
+/**
+ * @brief   Erase block.
+ * @details Starts erase of one block, without waiting for completion.
+ *
+ * @param[in] *flash      Flash device.
+ * @param[in] *erase      Erase type.
+ * @param[in] addr        Block address.
+ * @return  Execution error code @ref I2_ERROR.
+ */
+static i2_error spi_flash_erase_block(i2_spi_flash_t *flash,
+                                      const i2_spi_flash_erase_t *erase,
+                                      uint32_t addr)
+{
+  uint8_t hdr[SPI_FLASH_MAX_HEADER];
+  int32_t len;
+  i2_error err;
+
+  err = spi_flash_write_enable(flash);
+  if ( err != I2_SUCCESS ) {
+    return err;
+  }
+
+  len = spi_flash_header(hdr, erase->opcode, addr, flash->addr_len);
+
+  return spi_flash_cmd(flash, hdr, len, NULL, NULL, 0);
+}
+
+/**
+ * @brief   Buffer page fill.
+ * @details Page fill callback for @ref i2_spi_flash_write, data is sent
+ *          directly from caller buffer.
+ *
+ * @param[in] *arg        Source buffer.
+ * @param[in] *page       Page buffer, unused.
+ * @param[in] offset      Offset of page data in source.
+ * @param[in] size        Page data length.
+ * @return  Page data.
+ */
+static const uint8_t* spi_flash_buffer_fill(void *arg, uint8_t *page,
+                                            uint32_t offset, int32_t size)
+{
+  (void)page;
+  (void)size;
+
+  return (const uint8_t *)arg + offset;
+}
+
+/* Public functions ----------------------------------------------------------*/
+/**
+ * @brief   SPI NOR flash initialization.
+ * @details Reads JEDEC ID and probes SFDP tables for flash geometry. Flash
+ *          without SFDP falls back to JEDEC capacity code and standard
+ *          4K / 32K / 64K erase instructions.
+ *
+ * @param[in] *flash      Flash device to initialize.
+ * @param[in] *spi        Initialized SPI instance of flash.
+ * @return  Initialization error code @ref I2_ERROR.
+ */
+i2_error i2_spi_flash_init(i2_spi_flash_t *flash, i2_spi_inst_t *spi)
+{
+  uint8_t cmd = SPI_FLASH_CMD_READ_JEDEC_ID;
+  i2_error err;
+
+  if ( !flash || !spi ) {
+    return I2_INVALID_PARAM;
+  }
+
+  memset(flash, 0, sizeof(*flash));
+  flash->spi = spi;
+  flash->addr_len = 3;
+  flash->page_size = I2_SPI_FLASH_MAX_PAGE_SIZE;
+  flash->suspend_opcode = SPI_FLASH_CMD_SUSPEND;
+  flash->resume_opcode = SPI_FLASH_CMD_RESUME;
+
+  err = i2_spi_config_set(spi, I2_SPI_DATA_WIDTH_8BIT, I2_SPI_CLK_20_MHZ,
+                          I2_SPI_MODE_0, I2_SPI_MSBIT_FIRST);
+  if ( err != I2_SUCCESS ) {
+    return err;
+  }
+
+  err = spi_flash_cmd(flash, &cmd, 1, NULL, flash->jedec_id,
+                      sizeof(flash->jedec_id));
+  if ( err != I2_SUCCESS ) {
+    return err;
+  }
+
+  /* No flash answering on bus */
+  if ( (flash->jedec_id[0] == 0x00) || (flash->jedec_id[0] == 0xFF) ) {
+    return I2_NOT_AVAILABLE;
+  }
+
+  if ( spi_flash_sfdp_probe(flash) != I2_SUCCESS ) {
+    /* Capacity code is log2 of size in bytes for most vendors */
+    if ( flash->jedec_id[2] >= 32 ) {
+      return I2_NOT_SUPPORTED;
+    }
+    flash->size = 1UL << flash->jedec_id[2];
+    flash->addr_len = (flash->size > SPI_FLASH_3B_ADDR_LIMIT) ? 4 : 3;
+    memset(flash->erase, 0, sizeof(flash->erase));
+    spi_flash_erase_add(flash, 4 * 1024, SPI_FLASH_CMD_ERASE_4K);
+    spi_flash_erase_add(flash, 32 * 1024, SPI_FLASH_CMD_ERASE_32K);
+    spi_flash_erase_add(flash, 64 * 1024, SPI_FLASH_CMD_ERASE_64K);
+  }
+
+  if ( (flash->page_size > I2_SPI_FLASH_MAX_PAGE_SIZE) ||
+       (flash->page_size & (flash->page_size - 1)) ) {
+    flash->page_size = I2_SPI_FLASH_MAX_PAGE_SIZE;
+  }
+
+  if ( flash->addr_len == 4 ) {
+    err = spi_flash_opcode(flash, SPI_FLASH_CMD_ENTER_4B_ADDR);
+  }
+
+  return err;
+}
+
+/**
+ * @brief   SPI NOR flash read.
+ * @details Reads flash with fast read instruction, dummy cycles give the
+ *          flash time to fetch first byte at full bus clock.
+ *
+ * @param[in] *flash      Flash device.
+ * @param[in] addr        Flash address to read from.
+ * @param[out] *buf       Buffer to read in.
+ * @param[in] size        Bytes to read.
+ * @return  Execution error code @ref I2_ERROR.
+ */
+i2_error i2_spi_flash_read(i2_spi_flash_t *flash, uint32_t addr,
+                           uint8_t *buf, int32_t size)
+{
+  uint8_t hdr[SPI_FLASH_MAX_HEADER] = { 0 };
+  int32_t len;
+
+  if ( !flash || !buf || (size <= 0) ||
+       !spi_flash_area_valid(flash, addr, (uint32_t)size) ) {
+    return I2_INVALID_PARAM;
+  }
+
+  len = spi_flash_header(hdr, SPI_FLASH_CMD_FAST_READ, addr, flash->addr_len);
+  len += SPI_FLASH_FAST_READ_DUMMY;
+
+  return spi_flash_cmd(flash, hdr, len, NULL, buf, size);
+}
+
+/**
+ * @brief   SPI NOR flash program.
+ * @details Programs flash page by page. Data for each next page is
+ *          requested from @p fill while the flash is busy programming the
+ *          previous one, so preparation overlaps with status polling.
+ *
+ * @param[in] *flash      Flash device.
+ * @param[in] addr        Flash address to program.
+ * @param[in] size        Bytes to program.
+ * @param[in] fill        Page data provider @ref i2_spi_flash_fill_cb_t.
+ * @param[in] *arg        Argument passed to @p fill.
+ * @return  Execution error code @ref I2_ERROR.
+ *
+ * @note    Target area must be erased.
+ */
+i2_error i2_spi_flash_program(i2_spi_flash_t *flash, uint32_t addr,
+                              int32_t size, i2_spi_flash_fill_cb_t fill,
+                              void *arg)
+{
+  uint8_t hdr[SPI_FLASH_MAX_HEADER];
+  const uint8_t *data;
+  uint32_t offset = 0;
+  int32_t chunk, next, len;
+  i2_error err;
+
+  if ( !flash || !fill || (size <= 0) ||
+       !spi_flash_area_valid(flash, addr, (uint32_t)size) ) {
+    return I2_INVALID_PARAM;
+  }
+
+  /* First chunk ends on page boundary */
+  chunk = flash->page_size - (addr & (flash->page_size - 1));
+  if ( chunk > size ) {
+    chunk = size;
+  }
+  data = fill(arg, flash->page, offset, chunk);
+
+  while ( chunk ) {
+    err = spi_flash_write_enable(flash);
+    if ( err != I2_SUCCESS ) {
+      return err;
+    }
+
+    len = spi_flash_header(hdr, SPI_FLASH_CMD_PAGE_PROGRAM, addr + offset,
+                           flash->addr_len);
+    err = spi_flash_cmd(flash, hdr, len, data, NULL, chunk);
+    if ( err != I2_SUCCESS ) {
+      return err;
+    }
+
+    /* Prepare next page while this one is being programmed */
+    offset += chunk;
+    size -= chunk;
+    next = (size > (int32_t)flash->page_size) ? (int32_t)flash->page_size : size;
+    if ( next ) {
+      data = fill(arg, flash->page, offset, next);
+    }
+
+    err = spi_flash_wait(flash, SPI_FLASH_PROGRAM_TIMEOUT, false);
+    if ( err != I2_SUCCESS ) {
+      return err;
+    }
+    chunk = next;
+  }
+
+  return I2_SUCCESS;
+}
+
+/**
+ * @brief   SPI NOR flash write.
+ * @details Programs a buffer to flash, see @ref i2_spi_flash_program.
+ *
+ * @param[in] *flash      Flash device.
+ * @param[in] addr        Flash address to program.
+ * @param[in] *buf        Data to program.
+ * @param[in] size        Bytes to program.
+ * @return  Execution error code @ref I2_ERROR.
+ *
+ * @note    Target area must be erased.
+ */
+i2_error i2_spi_flash_write(i2_spi_flash_t *flash, uint32_t addr,
+                            const uint8_t *buf, int32_t size)
+{
+  if ( !buf ) {
+    return I2_INVALID_PARAM;
+  }
+
+  return i2_spi_flash_program(flash, addr, size, spi_flash_buffer_fill,
+                              (void *)buf);
+}
+
+/**
+ * @brief   SPI NOR flash erase.
+ * @details Erases an area using largest fitting erase types, and waits for
+ *          completion. Area is validated up front, so an invalid request
+ *          erases nothing.
+ *
+ * @param[in] *flash      Flash device.
+ * @param[in] addr        Flash address, aligned to smallest erase size.
+ * @param[in] size        Bytes to erase, multiple of smallest erase size.
+ * @return  Execution error code @ref I2_ERROR.
+ */
+i2_error i2_spi_flash_erase(i2_spi_flash_t *flash, uint32_t addr,
+                            uint32_t size)
+{
+  const i2_spi_flash_erase_t *erase;
+  uint32_t unit;
+  i2_error err;
+
+  if ( !flash || !size || !spi_flash_area_valid(flash, addr, size) ) {
+    return I2_INVALID_PARAM;
+  }
+
+  /* Smallest erase type always fits an aligned remainder */
+  unit = flash->erase[0].size;
+  if ( !unit || (addr % unit) || (size % unit) ) {
+    return I2_INVALID_PARAM;
+  }
+
+  while ( size ) {
+    erase = spi_flash_erase_type(flash, addr, size);
+    if ( !erase ) {
+      return I2_INVALID_PARAM;
+    }
+
+    err = spi_flash_erase_block(flash, erase, addr);
+    if ( err != I2_SUCCESS ) {
+      return err;
+    }
+
+    err = spi_flash_wait(flash, SPI_FLASH_ERASE_TIMEOUT, true);
+    if ( err != I2_SUCCESS ) {
+      return err;
+    }
+
+    addr += erase->size;
+    size -= erase->size;
+  }
+
+  return I2_SUCCESS;
+}
+
+/**
+ * @brief   SPI NOR flash erase start.
+ * @details Starts erase of one block without waiting, so it can be
+ *          suspended for reads. Completion is checked with
+ *          @ref i2_spi_flash_is_busy or @ref i2_spi_flash_wait_ready.
+ *
+ * @param[in] *flash      Flash device.
+ * @param[in] addr        Block address, aligned to @p size.
+ * @param[in] size        Block size, one of supported erase sizes.
+ * @return  Execution error code @ref I2_ERROR.
+ */
+i2_error i2_spi_flash_erase_start(i2_spi_flash_t *flash, uint32_t addr,
+                                  uint32_t size)
+{
+  const i2_spi_flash_erase_t *erase;
+
+  if ( !flash || !size || !spi_flash_area_valid(flash, addr, size) ) {
+    return I2_INVALID_PARAM;
+  }
+
+  erase = spi_flash_erase_type(flash, addr, size);
+  if ( !erase || (erase->size != size) ) {
+    return I2_INVALID_PARAM;
+  }
+
+  return spi_flash_erase_block(flash, erase, addr);
+}
+
+/**
+ * @brief   SPI NOR flash busy check.
+ * @details Checks whether a program or erase is in progress.
+ *
+ * @param[in] *flash      Flash device.
+ * @param[out] *busy      Flash busy state.
+ * @return  Execution error code @ref I2_ERROR.
+ */
+i2_error i2_spi_flash_is_busy(i2_spi_flash_t *flash, bool *busy)
+{
+  uint8_t status;
+  i2_error err;
+
+  if ( !flash || !busy ) {
+    return I2_INVALID_PARAM;
+  }
+
+  err = spi_flash_status(flash, &status);
+  if ( err == I2_SUCCESS ) {
+    *busy = (status & SPI_FLASH_SR_WIP) ? true : false;
+  }
+
+  return err;
+}
+
+/**
+ * @brief   SPI NOR flash wait.
+ * @details Waits for a program or erase in progress to complete.
+ *
+ * @param[in] *flash      Flash device.
+ * @param[in] timeout     Timeout in ms.
+ * @return  Execution error code @ref I2_ERROR.
+ */
+i2_error i2_spi_flash_wait_ready(i2_spi_flash_t *flash, uint32_t timeout)
+{
+  if ( !flash ) {
+    return I2_INVALID_PARAM;
+  }
+
+  return spi_flash_wait(flash, timeout, true);
+}
+
+/**
+ * @brief   SPI NOR flash suspend.
+ * @details Suspends an erase in progress, flash can be read once this
+ *          returns. Nothing is done if flash is idle.
+ *
+ * @param[in] *flash      Flash device.
+ * @return  Execution error code @ref I2_ERROR.
+ */
+i2_error i2_spi_flash_suspend(i2_spi_flash_t *flash)
+{
+  bool busy;
+  i2_error err;
+
+  if ( !flash ) {
+    return I2_INVALID_PARAM;
+  }
+
+  if ( !flash->suspend_opcode ) {
+    return I2_NOT_SUPPORTED;
+  }
+
+  err = i2_spi_flash_is_busy(flash, &busy);
+  if ( (err != I2_SUCCESS) || !busy ) {
+    return err;
+  }
+
+  err = spi_flash_opcode(flash, flash->suspend_opcode);
+  if ( err != I2_SUCCESS ) {
+    return err;
+  }
+
+  /* Write in progress clears once suspend takes effect */
+  return spi_flash_wait(flash, SPI_FLASH_SUSPEND_TIMEOUT, false);
+}
+
+/**
+ * @brief   SPI NOR flash resume.
+ * @details Resumes a suspended erase.
+ *
+ * @param[in] *flash      Flash device.
+ * @return  Execution error code @ref I2_ERROR.
+ */
+i2_error i2_spi_flash_resume(i2_spi_flash_t *flash)
+{
+  if ( !flash ) {
+    return I2_INVALID_PARAM;
+  }
+
+  if ( !flash->resume_opcode ) {
+    return I2_NOT_SUPPORTED;
+  }
+
+  return spi_flash_opcode(flash, flash->resume_opcode);
+}
+
+/************************ (C) COPYRIGHT iota2 ***[i2]*****END OF FILE**********/
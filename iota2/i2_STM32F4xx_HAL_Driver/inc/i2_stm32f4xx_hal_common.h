@@ -33,9 +33,11 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include <stdint.h>
+#include <stddef.h>
 #include <string.h>
 #include <stdbool.h>
 
+#include <i2_common.h>
 #include <i2_error.h>
 #include <i2_assert.h>
 #include <stm32f4xx_hal.h>
@@ -81,16 +83,6 @@ typedef struct {
 #define I2_TRANSFER_ERROR           ( 2 ) /**< Transfer terminated with error */
 /** @} */ /* I2_TRANSFER_STATE */
 
-/**
- * @defgroup I2_DISABLE_ENABLE iota2 Enabling options.
- * Definitions For Enabling / Disabling Functionalities.
- *
- * @{
- */
-#define I2_DISABLE                  ( 0 ) /**< Defines to disable a feature   */
-#define I2_ENABLE                   ( 1 ) /**< Defines to enable a feature    */
-/** @} */ /* I2_DISABLE_ENABLE */
-
 /**
  * @defgroup I2_LOW_HIGH iota2 pin control settings.
  * Definitions For Pin HIGH / LOW Functionalities.
@@ -101,6 +93,14 @@ typedef struct {
 #define I2_HIGH                     ( 1 ) /**< Defines to set a pin   */
 /** @} */ /* I2_LOW_HIGH */
 
+/**
+ * @brief   Get the enclosing structure from a member pointer.
+ * @details Used by the drivers to map a HAL handle passed to a callback back
+ *          to its driver context without searching the context table.
+ */
+#define I2_CONTAINER_OF(ptr, type, member)                                    \
+  ( (type *)( (uint8_t *)(ptr) - offsetof(type, member) ) )
+
 /* Public functions ----------------------------------------------------------*/
 i2_error i2_get_hal_error(HAL_StatusTypeDef err);
 void i2_delay_tick(uint32_t tick);
@@ -54,6 +54,95 @@ typedef struct {
 } i2_gpio_inst_t;             /**< GPIO instance              */
 /** @} */ /* i2_gpio_inst_t */
 
+/**
+ * @defgroup i2_gpio_bus_t GPIO parallel bus.
+ * Adjacent pins of a port driven together as one value, bit 0 of value on
+ * first pin. Pins are configured through their own GPIO instances.
+ *
+ * @{
+ */
+/** @brief GPIO bus */
+typedef struct {
+  GPIO_TypeDef  *gpio_port;   /**< GPIO port of bus pins      */
+  uint8_t       first;        /**< Pin number of bus bit 0    */
+  uint8_t       width;        /**< Number of pins (1..16)     */
+} i2_gpio_bus_t;              /**< GPIO bus                   */
+/** @} */ /* i2_gpio_bus_t */
+
+/**
+ * @defgroup i2_gpio_edge_t GPIO captured edge.
+ * Edge recorded in EXTI handler by @ref i2_gpio_config_capture, timestamp
+ * is in CPU cycles (SystemCoreClock) and wraps around.
+ *
+ * @{
+ */
+/** @brief GPIO captured edge */
+typedef struct {
+  uint32_t      ts;           /**< DWT cycle count of edge    */
+  uint8_t       line;         /**< EXTI line (pin number)     */
+  bool          rising;       /**< Rising edge if true        */
+} i2_gpio_edge_t;             /**< GPIO captured edge         */
+/** @} */ /* i2_gpio_edge_t */
+
+/* Public inline functions -------------------------------------------------- */
+/**
+ * @brief   GPIO port masked write.
+ * @details Sets pins in @p mask to their bit in @p value with a single BSRR
+ *          store, other pins of port are not touched. Safe against
+ *          concurrent writes to other pins, no locking needed.
+ *
+ * @param[in] *gpio_port  GPIO port to write.
+ * @param[in] mask        Pins to update.
+ * @param[in] value       Pin levels, one bit per pin.
+ * @retval  None.
+ */
+static inline void i2_gpio_port_write_mask(GPIO_TypeDef *gpio_port,
+                                           uint16_t mask, uint16_t value)
+{
+  gpio_port->BSRR = ((uint32_t)(mask & ~value) << 16) | (mask & value);
+}
+
+/**
+ * @brief   GPIO port read.
+ * @details Reads input levels of all pins of a port with a single IDR load.
+ *
+ * @param[in] *gpio_port  GPIO port to read.
+ * @retval  Pin levels, one bit per pin.
+ */
+static inline uint16_t i2_gpio_port_read(GPIO_TypeDef *gpio_port)
+{
+  return (uint16_t)gpio_port->IDR;
+}
+
+/**
+ * @brief   GPIO bus write.
+ * @details Drives all bus pins at once, with a single BSRR store.
+ *
+ * @param[in] *bus        GPIO bus to write.
+ * @param[in] value       Bus value, bits above bus width are ignored.
+ * @retval  None.
+ */
+static inline void i2_gpio_bus_write(const i2_gpio_bus_t *bus, uint32_t value)
+{
+  uint16_t mask = (uint16_t)(((1UL << bus->width) - 1) << bus->first);
+
+  i2_gpio_port_write_mask(bus->gpio_port, mask,
+                          (uint16_t)(value << bus->first));
+}
+
+/**
+ * @brief   GPIO bus read.
+ * @details Samples all bus pins at once, with a single IDR load.
+ *
+ * @param[in] *bus        GPIO bus to read.
+ * @retval  Bus value.
+ */
+static inline uint32_t i2_gpio_bus_read(const i2_gpio_bus_t *bus)
+{
+  return ((uint32_t)i2_gpio_port_read(bus->gpio_port) >> bus->first) &
+         ((1UL << bus->width) - 1);
+}
+
 /* Public functions --------------------------------------------------------- */
 void i2_gpio_init(void);
 i2_gpio_inst_t* i2_gpio_ctx_get(char *name);
@@ -70,5 +159,17 @@ void i2_gpio_toggle(i2_gpio_inst_t *inst);
 i2_error i2_gpio_config_interrupt(i2_gpio_inst_t *inst, uint32_t mode,
                                   uint32_t pull,
                                   void (*cb)(void *arg), void *arg);
+i2_error i2_gpio_config_interrupt_deferred(i2_gpio_inst_t *inst,
+                                          uint32_t mode, uint32_t pull,
+                                          void (*cb)(void *arg), void *arg);
+i2_error i2_gpio_config_capture(i2_gpio_inst_t *inst, uint32_t mode,
+                                uint32_t pull,
+                                void (*cb)(void *arg), void *arg);
+int32_t i2_gpio_capture_read(i2_gpio_edge_t *edges, int32_t count);
+uint32_t i2_gpio_capture_lost(void);
+i2_error i2_gpio_config_debounce(i2_gpio_inst_t *inst, uint32_t pull,
+                                 void (*cb)(void *arg, bool level), void *arg);
+bool i2_gpio_debounce_get(i2_gpio_inst_t *inst);
+void i2_gpio_debounce_tick(void);
 
 /************************ (C) COPYRIGHT iota2 ***[i2]*****END OF FILE**********/
@@ -118,17 +118,47 @@ typedef enum {
  */
 /** @brief SPI instance */
 typedef struct {
-  const char      *inst_name;   /**< SPI instance name          */
-  const char      *ctx_name;    /**< SPI context  name          */
-  i2_gpio_inst_t  CS;           /**< Chip select GPIO instance  */
+  const char      *inst_name;   /**< SPI instance name            */
+  const char      *ctx_name;    /**< SPI context  name            */
+  i2_gpio_inst_t  CS;           /**< Chip select GPIO instance    */
+  void            *ctx;         /**< SPI context, cached on init  */
+  uint32_t        cr1;          /**< Device CR1 configuration     */
 } i2_spi_inst_t;
 /** @} */ /* i2_spi_inst_t */
 
+/**
+ * @defgroup i2_spi_xfer_t SPI transfer segment.
+ * Defines one phase of a SPI transaction, e.g. command, address or data.
+ * A list of segments is run back to back under one CS assertion.
+ *
+ * @{
+ */
+/** @brief SPI transfer segment */
+typedef struct {
+  const uint8_t   *txbuf;       /**< Data to send, NULL to only receive */
+  uint8_t         *rxbuf;       /**< Data to receive, NULL to only send */
+  int32_t         size;         /**< Amount of data in segment          */
+} i2_spi_xfer_t;
+/** @} */ /* i2_spi_xfer_t */
+
 /* Public functions --------------------------------------------------------- */
 i2_error i2_spi_init(i2_spi_inst_t *inst);
 
 i2_spi_inst_t* i2_spi_inst_get(char *inst_name);
 
+i2_error i2_spi_config_set(i2_spi_inst_t *inst, i2_spi_data_width_t data_width,
+                           i2_spi_clock_speed_t clk_speed,
+                           i2_spi_mode_t spi_mode, i2_spi_first_bit_t first_bit);
+
+i2_error i2_spi_xfer(i2_spi_inst_t *inst, uint8_t *txbuf, uint8_t *rxbuf,
+                     int32_t size, uint32_t timeout);
+
+i2_error i2_spi_xfer_raw(i2_spi_inst_t *inst, uint8_t *txbuf, uint8_t *rxbuf,
+                         int32_t size, uint32_t timeout);
+
+i2_error i2_spi_transaction(i2_spi_inst_t *inst, const i2_spi_xfer_t *xfers,
+                            int32_t count, uint32_t timeout);
+
 i2_error i2_spi_txrx(i2_spi_inst_t *inst, i2_spi_data_width_t data_witdh,
                      i2_spi_clock_speed_t clk_speed, i2_spi_mode_t spi_mode,
                      i2_spi_first_bit_t first_bit,
@@ -36,10 +36,12 @@
 #include "i2_fifo.h"
 
 /* Public MACROS ------------------------------------------------------------ */
-/** @brief Size of UART FIFO */
+/** @brief Size of UART FIFO, power of two as required by lock-free FIFO */
 #define I2_UART_FIFO_SIZE       ( 1024 )
 /** @brief Half of the UART FIFO */
 #define I2_UART_FIFO_HALF_SIZE  ( I2_UART_FIFO_SIZE / 2 )
+/** @brief Queued async TX descriptors per UART, power of two */
+#define I2_UART_TX_QUEUE_LEN    ( 8 )
 
 /* Public definitions --------------------------------------------------------*/
 /**
@@ -51,17 +53,26 @@
  */
 /** @brief UART instance */
 typedef struct {
-  const char *inst_name;          /**< UART instance name */
-  const char *ctx_name;           /**< UART context name  */
+  const char *inst_name;          /**< UART instance name             */
+  const char *ctx_name;           /**< UART context name              */
+  void       *ctx;                /**< UART context, cached on init   */
 } i2_uart_inst_t;
 /** @} */ /* i2_uart_inst_t */
 
+/** @brief UART asynchronous TX completion callback, invoked from ISR */
+typedef void (*i2_uart_tx_cb_t)(void *arg, i2_error status);
+
 /* Public functions --------------------------------------------------------- */
 i2_error i2_uart_init(i2_uart_inst_t *inst);
 i2_error i2_uart_reset(i2_uart_inst_t *inst);
 i2_uart_inst_t* i2_uart_inst_get(char *inst_name);
 i2_error i2_uart_tx(i2_uart_inst_t *inst, uint8_t *txbuf, int32_t size,
                     int32_t *num_bytes, uint32_t timeout);
+i2_error i2_uart_tx_async(i2_uart_inst_t *inst, const uint8_t *txbuf,
+                          int32_t size, i2_uart_tx_cb_t cb, void *arg);
+#if defined ( ENABLE_RTOS_AWARE_HAL )
+void i2_uart_tx_notify_cb(void *arg, i2_error status);
+#endif /* ENABLE_RTOS_AWARE_HAL */
 i2_error i2_uart_tx_polling(i2_uart_inst_t *inst, uint8_t *txbuf, int32_t size,
                             int32_t *num_bytes, uint32_t timeout);
 i2_error i2_uart_rx_buffering_start(i2_uart_inst_t *inst);
@@ -85,6 +85,45 @@ i2_error i2_get_hal_error(HAL_StatusTypeDef error)
   return I2_FAILURE;
 }
 
+/**
+ * @brief   HAL millisecond tick.
+ * @details Overrides HAL tick, SysTick belongs to the kernel and never calls
+ *          HAL_IncTick. Tick is derived from DWT cycle counter, so HAL
+ *          timeouts also expire before scheduler start, while kernel keeps
+ *          interrupts masked. Needs a call at least once per counter wrap,
+ *          about 25 s at 168 MHz, which busy wait loops always do.
+ *
+ * @return  Milliseconds since first call.
+ */
+uint32_t HAL_GetTick(void)
+{
+  static uint32_t tick_ms;
+  static uint32_t tick_cycles;
+  uint32_t cycles_per_ms = SystemCoreClock / 1000U;
+  uint32_t elapsed;
+  uint32_t primask;
+  uint32_t ms;
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+
+  if ( !(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) ) {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    tick_cycles = 0;
+  }
+
+  elapsed = (DWT->CYCCNT - tick_cycles) / cycles_per_ms;
+  tick_cycles += elapsed * cycles_per_ms;
+  tick_ms += elapsed;
+  ms = tick_ms;
+
+  __set_PRIMASK(primask);
+
+  return ms;
+}
+
 /**
  * @brief   Delay routine.
  * @details Introduces a blocking delay of specified ticks.
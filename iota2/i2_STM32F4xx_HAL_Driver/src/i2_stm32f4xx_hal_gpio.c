@@ -35,9 +35,12 @@
 #include <string.h>
 #if defined ( ENABLE_RTOS_AWARE_HAL )
 #include <FreeRTOS.h>
-#include <semphr.h>
+#include <task.h>
+#include <timers.h>
 #endif /* ENABLE_RTOS_AWARE_HAL */
 
+#include "i2_fifo.h"
+
 /* Private defines -----------------------------------------------------------*/
 #define MAX_NUM_IO                        ( 144 ) /**< Supported Pin Count    */
 #define NUM_GPIO_PORTS                    ( 9 )   /**< Available Ports count  */
@@ -45,15 +48,107 @@
 #define MAX_NUM_GPIO_INTERRUPTS           ( 16 )  /**< Interrupts in each port*/
 #define GPIO_EXTI_PREEMPTION_PRIORITY     ( 5 )   /**< EXTI Priority          */
 #define GPIO_EXTI_SUB_PRIORITY            ( 1 )   /**< EXTI SUB Priority      */
+#define GPIO_PORT_STRIDE    ( GPIOB_BASE - GPIOA_BASE ) /**< Port address gap */
+/** @brief Bit-band alias of port clock enable bit, GPIOxEN bits follow ports */
+#define GPIO_CLOCK_BB(index)  ( *(__IO uint32_t *)(PERIPH_BB_BASE +           \
+                                ((RCC_BASE + offsetof(RCC_TypeDef, AHB1ENR) - \
+                                  PERIPH_BASE) * 32) +                        \
+                                ((RCC_AHB1ENR_GPIOAEN_Pos + (index)) * 4)) )
+#define GPIO_EXTI_LINES_9_5               ( 0x03E0 ) /**< EXTI lines 5 to 9   */
+#define GPIO_EXTI_LINES_15_10             ( 0xFC00 ) /**< EXTI lines 10 to 15 */
+#define GPIO_EXTI_DEFERRED                ( 0x01 )   /**< Callback in task    */
+#define GPIO_EXTI_CAPTURE                 ( 0x02 )   /**< Timestamp edges     */
+#define GPIO_CAPTURE_QUEUE_SIZE           ( 64 )     /**< Edges (power of 2)  */
+#define GPIO_DEBOUNCE_PERIOD_MS           ( 5 )      /**< Debounce sampling   */
+#define GPIO_DEBOUNCE_MAX_INPUTS          ( 16 )     /**< Debounced inputs    */
+
+#if defined ( ENABLE_RTOS_AWARE_HAL )
+/**
+ * @defgroup GPIO_EXTI_DEFER_SPEC GPIO deferred interrupt handling.
+ * Deferred interrupt callbacks run in a handler task, EXTI handler only
+ * posts line events to a lock-free queue.
+ *
+ * @{
+ */
+#define GPIO_EXTI_QUEUE_SIZE        ( 32 )  /**< Pending events (power of 2) */
+#define GPIO_EXTI_TASK_PRIORITY     ( 3 )   /**< Handler task priority       */
+#define GPIO_EXTI_TASK_STACK        ( 256 ) /**< Handler task stack depth    */
+/** @} */ /* GPIO_EXTI_DEFER_SPEC */
+#endif /* ENABLE_RTOS_AWARE_HAL */
 
 /* Private variables ---------------------------------------------------------*/
 /** @brief GPIO pheripheral initialization check flag */
 static bool initialized = false;
-/** @brief GPIO instances mapping with all available GPIO pings */
-static i2_gpio_inst_t *gpio_inst[MAX_NUM_IO] = {0};
-/** @brief GPIO ISR monitoring table */
+/** @brief GPIO instances owning each pin, indexed by port and pin */
+static i2_gpio_inst_t * volatile gpio_inst[MAX_NUM_IO] = {0};
+/** @brief GPIO ISR monitoring table, indexed by EXTI line */
 static i2_handler_t gpio_isr_inst[MAX_NUM_GPIO_INTERRUPTS] = {{0}};
 
+I2_FIFO_TYPED_DEFINE(gpio_edge_fifo, i2_gpio_edge_t)
+
+/** @brief EXTI lines whose edges are timestamped */
+static volatile uint32_t gpio_exti_capture;
+/** @brief Port of each timestamped EXTI line */
+static GPIO_TypeDef *gpio_capture_port[MAX_NUM_GPIO_INTERRUPTS];
+/** @brief Timestamped edges */
+static gpio_edge_fifo_t gpio_capture_queue;
+/** @brief Timestamped edges storage */
+static i2_gpio_edge_t gpio_capture_buf[GPIO_CAPTURE_QUEUE_SIZE];
+/** @brief Timestamped edges lost on a full queue */
+static volatile uint32_t gpio_capture_overrun;
+
+/**
+ * @defgroup gpio_debounce_t GPIO debounce state.
+ * Debounce state of a port, one bit per pin. Two bit vertical counter of
+ * every pin counts samples differing from debounced state, debounced state
+ * follows after four of them in a row.
+ *
+ * @{
+ */
+/** @brief GPIO port debounce state */
+typedef struct {
+  uint16_t          mask;           /**< Debounced pins             */
+  uint16_t          state;          /**< Debounced levels           */
+  uint16_t          cnt0;           /**< Vertical counter bit 0     */
+  uint16_t          cnt1;           /**< Vertical counter bit 1     */
+} gpio_debounce_t;                  /** GPIO port debounce state    */
+
+/** @brief Debounced input edge handler */
+typedef struct {
+  int32_t           slot;           /**< Pin slot index             */
+  void (*cb)(void *arg, bool level);  /**< Edge callback            */
+  void              *arg;           /**< Argument of edge callback  */
+} gpio_debounce_input_t;            /** Debounced input             */
+/** @} */ /* gpio_debounce_t */
+
+/** @brief Debounce state of every port */
+static gpio_debounce_t gpio_debounce[NUM_GPIO_PORTS];
+/** @brief Debounced inputs */
+static gpio_debounce_input_t gpio_debounce_input[GPIO_DEBOUNCE_MAX_INPUTS];
+/** @brief Number of debounced inputs */
+static volatile int32_t gpio_debounce_inputs;
+/** @brief Ports with debounced inputs, one bit per port */
+static volatile uint32_t gpio_debounce_ports;
+#if defined ( ENABLE_RTOS_AWARE_HAL )
+/** @brief Debounce sampling timer */
+static TimerHandle_t gpio_debounce_timer;
+#endif /* ENABLE_RTOS_AWARE_HAL */
+
+#if defined ( ENABLE_RTOS_AWARE_HAL )
+I2_FIFO_TYPED_DEFINE(gpio_exti_fifo, uint8_t)
+
+/** @brief EXTI lines whose callback runs in handler task */
+static volatile uint32_t gpio_exti_deferred;
+/** @brief Deferred EXTI line events */
+static gpio_exti_fifo_t gpio_exti_queue;
+/** @brief Deferred EXTI line events storage */
+static uint8_t gpio_exti_queue_buf[GPIO_EXTI_QUEUE_SIZE];
+/** @brief Deferred EXTI line events lost on a full queue */
+static volatile uint32_t gpio_exti_overrun;
+/** @brief Deferred interrupt handler task */
+static TaskHandle_t gpio_exti_task;
+#endif /* ENABLE_RTOS_AWARE_HAL */
+
 /**
  * @defgroup i2_gpio_ctx_t GPIO port context.
  * Information on each GPIO port.
@@ -64,11 +159,7 @@ static i2_handler_t gpio_isr_inst[MAX_NUM_GPIO_INTERRUPTS] = {{0}};
 typedef struct {
   const char        *name;          /**< Context Name           */
   GPIO_TypeDef      *gpio_port;     /**< GPIO port              */
-  int32_t           refcount;       /**< Usage Reference count  */
-  bool              clk_on;         /**< Clock ON identifier    */
-#if defined( ENABLE_RTOS_AWARE_HAL )
-  SemaphoreHandle_t mutex;          /**< Mutex handler          */
-#endif /* ENABLE_RTOS_AWARE_HAL */
+  volatile int32_t  refcount;       /**< Usage Reference count  */
 } i2_gpio_ctx_t;                    /** GPIO Context            */
 /** @} */ /* i2_gpio_ctx_t */
 
@@ -80,263 +171,213 @@ typedef struct {
  */
 /** @brief GPIO Ports definitions */
 static i2_gpio_ctx_t GPIO_PORTS[NUM_GPIO_PORTS] = {
-  { "PORT_A", GPIOA, 0, false },      /**< GPIO Port A    */
-  { "PORT_B", GPIOB, 0, false },      /**< GPIO Port B    */
-  { "PORT_C", GPIOC, 0, false },      /**< GPIO Port C    */
-  { "PORT_D", GPIOD, 0, false },      /**< GPIO Port D    */
-  { "PORT_E", GPIOE, 0, false },      /**< GPIO Port E    */
-  { "PORT_F", GPIOF, 0, false },      /**< GPIO Port F    */
-  { "PORT_G", GPIOG, 0, false },      /**< GPIO Port G    */
-  { "PORT_H", GPIOH, 0, false },      /**< GPIO Port H    */
-  { "PORT_I", GPIOI, 0, false },      /**< GPIO Port I    */
+  { "PORT_A", GPIOA, 0 },             /**< GPIO Port A    */
+  { "PORT_B", GPIOB, 0 },             /**< GPIO Port B    */
+  { "PORT_C", GPIOC, 0 },             /**< GPIO Port C    */
+  { "PORT_D", GPIOD, 0 },             /**< GPIO Port D    */
+  { "PORT_E", GPIOE, 0 },             /**< GPIO Port E    */
+  { "PORT_F", GPIOF, 0 },             /**< GPIO Port F    */
+  { "PORT_G", GPIOG, 0 },             /**< GPIO Port G    */
+  { "PORT_H", GPIOH, 0 },             /**< GPIO Port H    */
+  { "PORT_I", GPIOI, 0 },             /**< GPIO Port I    */
 };
 /** @} */ /* GPIO_PORTS */
 
-/**
- * @defgroup GPIO_PINS GPIO pins list.
- * List of all available pins in each port.
- *
- * @{
- */
-/** @brief GPIO Pins definitions */
-static int16_t GPIO_PINS[NUM_GPIO_PER_PORT] = {
-  GPIO_PIN_0,   GPIO_PIN_1,   GPIO_PIN_2,   GPIO_PIN_3,
-  GPIO_PIN_4,   GPIO_PIN_5,   GPIO_PIN_6,   GPIO_PIN_7,
-  GPIO_PIN_8,   GPIO_PIN_9,   GPIO_PIN_10,  GPIO_PIN_11,
-  GPIO_PIN_12,  GPIO_PIN_13,  GPIO_PIN_14,  GPIO_PIN_15,
-};
-/** @} */ /* GPIO_PINS */
-
 /* Private functions ---------------------------------------------------------*/
 /**
  * @brief   Get port index.
- * @details Get index of GPIO port from the list.
+ * @details Get index of GPIO port from its base address, ports are placed
+ *          at a fixed stride starting from GPIOA.
  *
  * @param[in] *gpio_port    Port to index.
- * @return  Port index.
+ * @return  Port index, NUM_GPIO_PORTS for an invalid port.
  */
-static int32_t get_port_index(GPIO_TypeDef *gpio_port)
+static inline int32_t get_port_index(GPIO_TypeDef *gpio_port)
 {
-  int32_t i;
+  uint32_t offset = (uint32_t)((uintptr_t)gpio_port - GPIOA_BASE);
 
-  for (i = 0; i < NUM_GPIO_PORTS; i++) {
-    if (GPIO_PORTS[i].gpio_port == gpio_port) {
-      break;
-    }
+  if ( (offset % GPIO_PORT_STRIDE) ||
+       (offset >= (NUM_GPIO_PORTS * GPIO_PORT_STRIDE)) ) {
+    return NUM_GPIO_PORTS;
   }
 
-  return i;
+  return (int32_t)(offset / GPIO_PORT_STRIDE);
 }
 
 /**
  * @brief   Get pin index.
- * @details Get index of GPIO pin from the list.
+ * @details Get index of GPIO pin from its bitmask.
  *
  * @param[in] *gpio         Pin to index.
- * @return  Pin index.
+ * @return  Pin index, NUM_GPIO_PER_PORT if not exactly one pin is set.
  */
-static int32_t get_gpio_index(uint16_t gpio)
+static inline int32_t get_gpio_index(uint16_t gpio)
 {
-  int32_t i;
+  uint32_t mask = gpio;
 
-  for (i = 0; i < NUM_GPIO_PER_PORT; i++) {
-    if (GPIO_PINS[i] == gpio) {
-      break;
-    }
+  if ( !mask || (mask & (mask - 1)) ) {
+    return NUM_GPIO_PER_PORT;
   }
 
-  return i;
+  return (int32_t)__CLZ(__RBIT(mask));
 }
 
 /**
- * @brief   Get reference count.
- * @details Get usage reference count of GPIO port.
+ * @brief   Get pin slot.
+ * @details Get index of a pin in GPIO instances table.
  *
- * @param[in] *gpio_port    Port to evaluate.
- * @return  Reference count of Port.
+ * @param[in] *inst         GPIO instance.
+ * @return  Slot index, MAX_NUM_IO for an invalid pin.
  */
-static int32_t gpio_refcount_get(GPIO_TypeDef *gpio_port)
+static inline int32_t get_slot_index(i2_gpio_inst_t *inst)
 {
-  int32_t index = get_port_index(gpio_port);
+  int32_t port = get_port_index(inst->gpio_port);
+  int32_t pin = get_gpio_index((uint16_t)inst->gpio);
 
-  if (index >= NUM_GPIO_PORTS) {
-    return -1;
+  if ( (port >= NUM_GPIO_PORTS) || (pin >= NUM_GPIO_PER_PORT) ) {
+    return MAX_NUM_IO;
   }
-  return GPIO_PORTS[index].refcount;
+
+  return (port * NUM_GPIO_PER_PORT) + pin;
 }
 
 /**
- * @brief   Increments reference count.
- * @details Increments reference count of GPIO port.
+ * @brief   Atomically add to reference count.
+ * @details Exclusive load/store loop, monitor is cleared on exception entry
+ *          so a preempted update simply retries.
  *
- * @param[in] *gpio_port    Port to evaluate.
- * @return  None.
+ * @param[in] *refcount     Reference count to update.
+ * @param[in] value         Value to add.
+ * @return  Reference count after update.
  */
-static void gpio_refcount_up(GPIO_TypeDef *gpio_port)
+static inline int32_t gpio_atomic_add(volatile int32_t *refcount,
+                                      int32_t value)
 {
-  int32_t index = get_port_index(gpio_port);
+  int32_t count;
 
-  if (index >= NUM_GPIO_PORTS) {
-    return;
-  }
-  GPIO_PORTS[index].refcount++;
+  do {
+    count = (int32_t)__LDREXW((volatile uint32_t *)refcount) + value;
+  } while ( __STREXW((uint32_t)count, (volatile uint32_t *)refcount) );
+
+  return count;
 }
 
 /**
- * @brief   Decrements reference count.
- * @details Decrements reference count of GPIO port.
+ * @brief   Atomically claim or free a pin slot.
+ * @details Compare and swap of slot owner.
  *
- * @param[in] *gpio_port    Port to evaluate.
- * @return  None.
+ * @param[in] slot          Slot index.
+ * @param[in] *expected     Current owner expected in slot.
+ * @param[in] *owner        New owner of slot.
+ * @return  true if slot had expected owner and was updated.
  */
-static void gpio_refcount_down(GPIO_TypeDef *gpio_port)
+static inline bool gpio_slot_swap(int32_t slot, i2_gpio_inst_t *expected,
+                                  i2_gpio_inst_t *owner)
 {
-  int32_t index = get_port_index(gpio_port);
+  volatile uint32_t *addr = (volatile uint32_t *)&gpio_inst[slot];
 
-  if (index >= NUM_GPIO_PORTS) {
-    return;
-  }
-  GPIO_PORTS[index].refcount--;
+  do {
+    if ( __LDREXW(addr) != (uint32_t)(uintptr_t)expected ) {
+      __CLREX();
+      return false;
+    }
+  } while ( __STREXW((uint32_t)(uintptr_t)owner, addr) );
+
+  return true;
 }
 
 /**
- * @brief   Acquire GPIO mutex.
- * @details Acquire mutex for a GPIO port when RTOS is enabled.
+ * @brief   Lock GPIO port registers.
+ * @details Masks all interrupts around read-modify-write of shared port
+ *          registers, callable from task and ISR. PRIMASK is used instead
+ *          of RTOS syscall mask, pins may be configured from ISRs above
+ *          syscall priority. Sections are a few register writes long.
  *
- * @param[in] *gpio_port    Port to take mutex.
- * @return  None.
+ * @return  Previous interrupt mask.
  */
-static void gpio_mutex_acquire(GPIO_TypeDef *gpio_port)
+static inline uint32_t gpio_lock(void)
 {
-#if defined ( ENABLE_RTOS_AWARE_HAL )
-  int32_t index = get_port_index(gpio_port);
-
-  if (index >= NUM_GPIO_PORTS) {
-      return;
-  }
+  uint32_t primask = __get_PRIMASK();
 
-  xSemaphoreTake(GPIO_PORTS[index].mutex, portMAX_DELAY);
-#else
-  UNUSED_PARAMETER( gpio_port );
-#endif /* ENABLE_RTOS_AWARE_HAL */
+  __disable_irq();
+  return primask;
 }
 
 /**
- * @brief   Release GPIO mutex.
- * @details Release mutex for a GPIO port when RTOS is enabled.
+ * @brief   Unlock GPIO port registers.
+ * @details Counterpart of @ref gpio_lock.
  *
- * @param[in] *gpio_port    Port to release mutex.
+ * @param[in] mask          Interrupt mask returned by @ref gpio_lock.
  * @return  None.
  */
-static void gpio_mutex_release(GPIO_TypeDef *gpio_port)
+static inline void gpio_unlock(uint32_t mask)
 {
-#if defined ( ENABLE_RTOS_AWARE_HAL )
-  int32_t index = get_port_index(gpio_port);
-
-  if (index >= NUM_GPIO_PORTS) {
-      return;
-  }
-
-  xSemaphoreGive(GPIO_PORTS[index].mutex);
-#else
-  UNUSED_PARAMETER( gpio_port );
-#endif /* ENABLE_RTOS_AWARE_HAL */
+  __set_PRIMASK(mask);
 }
 
 /**
- * @brief   Enables port clock.
- * @details Enables clock on GPIO port.
+ * @brief   Takes a reference on port.
+ * @details Increments reference count and enables port clock. Clock enable
+ *          is a single bit-band store, it is repeated on every reference so
+ *          that a pin never waits on another context's 0 -> 1 transition.
  *
- * @param[in] *gpio_port    Port to enable clock.
+ * @param[in] index         Port index.
  * @return  None.
  */
-static void gpio_clock_enable(GPIO_TypeDef *gpio_port)
+static void gpio_port_get(int32_t index)
 {
-  int32_t index = get_port_index(gpio_port);
-
-  if (index >= NUM_GPIO_PORTS) {
-    return;
-  }
-
-  if (gpio_port == GPIOA) {
-    __HAL_RCC_GPIOA_CLK_ENABLE();
-  } else if (gpio_port == GPIOB) {
-    __HAL_RCC_GPIOB_CLK_ENABLE();
-  } else if (gpio_port == GPIOC) {
-    __HAL_RCC_GPIOC_CLK_ENABLE();
-  } else if (gpio_port == GPIOD) {
-    __HAL_RCC_GPIOD_CLK_ENABLE();
-  } else if (gpio_port == GPIOE) {
-    __HAL_RCC_GPIOE_CLK_ENABLE();
-  } else if (gpio_port == GPIOF) {
-    __HAL_RCC_GPIOF_CLK_ENABLE();
-  } else if (gpio_port == GPIOG) {
-    __HAL_RCC_GPIOG_CLK_ENABLE();
-  } else if (gpio_port == GPIOH) {
-    __HAL_RCC_GPIOH_CLK_ENABLE();
-  } else if (gpio_port == GPIOI) {
-    __HAL_RCC_GPIOI_CLK_ENABLE();
-  }
-  GPIO_PORTS[index].clk_on = true;
+  gpio_atomic_add(&GPIO_PORTS[index].refcount, 1);
+  GPIO_CLOCK_BB(index) = 1;
+  /* Delay after RCC peripheral clock enabling */
+  (void)RCC->AHB1ENR;
 }
 
 /**
- * @brief   Disables port clock.
- * @details Disables clock on GPIO port.
+ * @brief   Drops a reference on port.
+ * @details Decrements reference count, port clock is disabled on 1 -> 0
+ *          transition unless port got referenced again meanwhile. Recheck
+ *          and clock clear run under @ref gpio_lock, so no
+ *          @ref gpio_port_get can slip in between.
  *
- * @param[in] *gpio_port    Port to disable clock.
+ * @param[in] index         Port index.
  * @return  None.
  */
-static void gpio_clock_disable(GPIO_TypeDef *gpio_port)
+static void gpio_port_put(int32_t index)
 {
-  int32_t index = get_port_index(gpio_port);
-
-  if (index >= NUM_GPIO_PORTS) {
-    return;
-  }
+  uint32_t mask;
 
-  if (gpio_port == GPIOA) {
-    __HAL_RCC_GPIOA_CLK_DISABLE();
-  } else if (gpio_port == GPIOB) {
-    __HAL_RCC_GPIOB_CLK_DISABLE();
-  } else if (gpio_port == GPIOC) {
-    __HAL_RCC_GPIOC_CLK_DISABLE();
-  } else if (gpio_port == GPIOD) {
-    __HAL_RCC_GPIOD_CLK_DISABLE();
-  } else if (gpio_port == GPIOE) {
-    __HAL_RCC_GPIOE_CLK_DISABLE();
-  } else if (gpio_port == GPIOF) {
-    __HAL_RCC_GPIOF_CLK_DISABLE();
-  } else if (gpio_port == GPIOG) {
-    __HAL_RCC_GPIOG_CLK_DISABLE();
-  } else if (gpio_port == GPIOH) {
-    __HAL_RCC_GPIOH_CLK_DISABLE();
-  } else if (gpio_port == GPIOI) {
-    __HAL_RCC_GPIOI_CLK_DISABLE();
+  if ( gpio_atomic_add(&GPIO_PORTS[index].refcount, -1) == 0 ) {
+    mask = gpio_lock();
+    if ( GPIO_PORTS[index].refcount == 0 ) {
+      GPIO_CLOCK_BB(index) = 0;
+    }
+    gpio_unlock(mask);
   }
-  GPIO_PORTS[index].clk_on = false;
 }
 
 /**
- * @brief   GPIO availability check.
- * @details Checks for availability of a GPIO instance.
+ * @brief   GPIO Pin configuration.
+ * @details Writes configuration of instance to port registers, port clock
+ *          must be on.
  *
  * @param[in] *inst         GPIO instance.
- * @return  Return TRUE for an available GPIO instance else FALSE.
+ * @return  None.
  */
-static bool is_gpio_available(i2_gpio_inst_t *inst)
+static void gpio_apply(i2_gpio_inst_t *inst)
 {
-  int32_t i;
+  GPIO_InitTypeDef config;
+  uint32_t mask;
 
-  for (i = 0; i < MAX_NUM_IO; i++) {
-    if (gpio_inst[i] &&
-        gpio_inst[i]->gpio_port == inst->gpio_port &&
-        gpio_inst[i]->gpio == inst->gpio) {
-      return false;
-    }
-  }
+  config.Pin        = inst->gpio;
+  config.Pull       = inst->pull;
+  config.Mode       = inst->mode;
+  config.Alternate  = inst->alt;
+  config.Speed      = inst->speed;
 
-  return true;
+  /* Port registers are shared with other pins */
+  mask = gpio_lock();
+  HAL_GPIO_Init(inst->gpio_port, &config);
+  gpio_unlock(mask);
 }
 
 /**
@@ -348,24 +389,13 @@ static bool is_gpio_available(i2_gpio_inst_t *inst)
  */
 static void gpio_activate(i2_gpio_inst_t *inst)
 {
-  GPIO_InitTypeDef config;
-
   if (inst->active) {
     return;
   }
 
-  if ( gpio_refcount_get(inst->gpio_port) == 0 ) {
-    gpio_clock_enable(inst->gpio_port);
-  }
-
-  config.Pin        = inst->gpio;
-  config.Pull       = inst->pull;
-  config.Mode       = inst->mode;
-  config.Alternate  = inst->alt;
-  config.Speed      = inst->speed;
-  HAL_GPIO_Init(inst->gpio_port, &config);
+  gpio_port_get(get_port_index(inst->gpio_port));
+  gpio_apply(inst);
 
-  gpio_refcount_up(inst->gpio_port);
   inst->active = true;
 }
 
@@ -378,20 +408,50 @@ static void gpio_activate(i2_gpio_inst_t *inst)
  */
 static void gpio_deactivate(i2_gpio_inst_t *inst)
 {
+  uint32_t mask;
+
   if (!inst->active) {
     return;
   }
 
-  gpio_refcount_down(inst->gpio_port);
+  mask = gpio_lock();
   HAL_GPIO_DeInit(inst->gpio_port, inst->gpio);
+  gpio_unlock(mask);
 
-  if (gpio_refcount_get(inst->gpio_port) == 0) {
-    gpio_clock_disable(inst->gpio_port);
-  }
+  gpio_port_put(get_port_index(inst->gpio_port));
 
   inst->active = false;
 }
 
+/**
+ * @brief   GPIO pin claim.
+ * @details Claims slot of pin lock-free and activates pin with requested
+ *          configuration, callable from task or ISR.
+ *
+ * @param[in] *inst       GPIO instance to claim.
+ * @param[in] mode        GPIO mode configuration.
+ * @param[in] pull        GPIO pull / push configuration.
+ * @param[in] alt         GPIO alternate mode configuration.
+ * @return  true if pin was free and is now owned by @p inst.
+ */
+static bool gpio_claim(i2_gpio_inst_t *inst, uint32_t mode,
+                       uint32_t pull, uint32_t alt)
+{
+  int32_t slot = get_slot_index(inst);
+
+  if ( (slot >= MAX_NUM_IO) || !gpio_slot_swap(slot, NULL, inst) ) {
+    return false;
+  }
+
+  inst->speed  = GPIO_SPEED_FREQ_VERY_HIGH;
+  inst->pull   = pull;
+  inst->mode   = mode;
+  inst->alt    = alt;
+  gpio_activate( inst );
+
+  return true;
+}
+
 /* Public functions --------------------------------------------------------- */
 /**
  * @brief   GPIO instance initialization.
@@ -402,8 +462,6 @@ static void gpio_deactivate(i2_gpio_inst_t *inst)
 void i2_gpio_init(void)
 {
   if ( false == initialized ) {
-    int32_t i;
-
     /* Start with analog input, no pull */
     HAL_GPIO_DeInit(GPIOA, GPIO_PIN_All);
     HAL_GPIO_DeInit(GPIOB, GPIO_PIN_All);
@@ -426,11 +484,8 @@ void i2_gpio_init(void)
     __HAL_RCC_GPIOH_CLK_DISABLE();
     __HAL_RCC_GPIOI_CLK_DISABLE();
 
-#if defined ( ENABLE_RTOS_AWARE_HAL )
-    for (i = 0; i < NUM_GPIO_PORTS; i++) {
-      GPIO_PORTS[i].mutex = xSemaphoreCreateMutex();
-    }
-#endif /* ENABLE_RTOS_AWARE_HAL */
+    gpio_edge_fifo_init(&gpio_capture_queue, gpio_capture_buf,
+                        GPIO_CAPTURE_QUEUE_SIZE, I2_FIFO_MODE_MPSC);
 
     initialized = true;
   }
@@ -481,29 +536,19 @@ bool i2_gpio_is_valid(i2_gpio_inst_t *inst)
  */
 void i2_gpio_release(i2_gpio_inst_t *inst)
 {
-  int32_t i;
+  int32_t slot;
 
   if ( NULL == inst ) {
     return;
   }
 
-  gpio_mutex_acquire(inst->gpio_port);
-
-  if ( true == is_gpio_available(inst) ) {
-    goto err;
+  slot = get_slot_index(inst);
+  if ( (slot >= MAX_NUM_IO) || (gpio_inst[slot] != inst) ) {
+    return;
   }
 
   gpio_deactivate(inst);
-
-  for ( i = 0; i < MAX_NUM_IO; i++ ) {
-    if ( gpio_inst[i] == inst ) {
-      gpio_inst[i] = 0;
-      break;
-    }
-  }
-
-err:
-  gpio_mutex_release(inst->gpio_port);
+  gpio_slot_swap(slot, inst, NULL);
 }
 
 /**
@@ -551,7 +596,8 @@ void i2_gpio_config_in(i2_gpio_inst_t *inst, uint32_t pull)
 
 /**
  * @brief   GPIO configures in alternate mode.
- * @details Configures a GPIO pin in altenate use mode.
+ * @details Configures a GPIO pin in altenate use mode. Pin is claimed
+ *          lock-free, callable from task or ISR.
  *
  * @param[in] *inst       GPIO instance to configure.
  * @param[in] mode        GPIO mode configuration.
@@ -562,34 +608,13 @@ void i2_gpio_config_in(i2_gpio_inst_t *inst, uint32_t pull)
 void i2_gpio_config_alt(i2_gpio_inst_t *inst, uint32_t mode,
                         uint32_t pull, uint32_t alt)
 {
-  int32_t i;
-
   if ( NULL == inst ) {
     return;
   }
 
-  gpio_mutex_acquire(inst->gpio_port);
-
-  if ( !is_gpio_available( inst) ) {
+  if ( !gpio_claim(inst, mode, pull, alt) ) {
     i2_assert(0);
-    goto err;
-  }
-
-  inst->speed  = GPIO_SPEED_FREQ_VERY_HIGH;
-  inst->pull   = pull;
-  inst->mode   = mode;
-  inst->alt    = alt;
-  gpio_activate( inst );
-
-  for ( i = 0; i < MAX_NUM_IO; i++ ) {
-    if ( !gpio_inst[i] ) {
-      gpio_inst[i] = inst;
-      break;
-    }
   }
-
-err:
-  gpio_mutex_release(inst->gpio_port);
 }
 
 /**
@@ -601,16 +626,12 @@ err:
  */
 bool i2_gpio_get(i2_gpio_inst_t *inst)
 {
-  if (HAL_GPIO_ReadPin(inst->gpio_port, (uint16_t)inst->gpio) == GPIO_PIN_SET) {
-      return true;
-  }
-
-  return false;
+  return (i2_gpio_port_read(inst->gpio_port) & inst->gpio) != 0;
 }
 
 /**
  * @brief   GPIO set / reset API.
- * @details Sets a GPIO pin high or low.
+ * @details Sets a GPIO pin high or low with a single BSRR store.
  *
  * @param[in] *inst       GPIO instance to set.
  * @param[in] val         Bool specifing value to set or reset GPIO pin.
@@ -618,81 +639,551 @@ bool i2_gpio_get(i2_gpio_inst_t *inst)
  */
 void i2_gpio_set(i2_gpio_inst_t *inst, bool val)
 {
-  HAL_GPIO_WritePin(inst->gpio_port, (uint16_t)inst->gpio,
-                    (val ? GPIO_PIN_SET : GPIO_PIN_RESET));
+  inst->gpio_port->BSRR = val ? inst->gpio : (inst->gpio << 16);
 }
 
 /**
  * @brief   GPIO toggle.
- * @details Toggles the state of specified GPIO pin.
+ * @details Toggles the state of specified GPIO pin, with a BSRR store so
+ *          that concurrent writes to other pins of port are not lost.
  *
  * @param[in] *inst       GPIO instance to toggle.
  * @retval  None.
  */
 void i2_gpio_toggle(i2_gpio_inst_t *inst)
 {
-  HAL_GPIO_TogglePin(inst->gpio_port, (uint16_t)inst->gpio);
+  uint16_t pin = (uint16_t)inst->gpio;
+
+  i2_gpio_port_write_mask(inst->gpio_port, pin,
+                          (uint16_t)~inst->gpio_port->ODR);
 }
 
+#if defined ( ENABLE_RTOS_AWARE_HAL )
 /**
- * @brief   GPIO interrupt configuration.
- * @details Enables EXTI interrupt on a GPIO instance with specified callback.
+ * @brief   Deferred interrupt handler task.
+ * @details Runs callbacks of deferred EXTI lines in order of their events.
+ *
+ * @param[in] arg         Unused.
+ * @retval  None.
+ */
+static void gpio_exti_task_handler(void *arg)
+{
+  uint8_t line;
+
+  (void)arg;
+
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    while ( gpio_exti_fifo_get(&gpio_exti_queue, &line, false) >= 0 ) {
+      if ( gpio_isr_inst[line].cb ) {
+        gpio_isr_inst[line].cb(gpio_isr_inst[line].arg);
+      }
+    }
+  }
+}
+
+/**
+ * @brief   Starts deferred interrupt handling.
+ * @details Creates event queue and handler task on first use.
+ *
+ * @retval  I2_SUCCESS or I2_FAILURE when handler task can't be created.
+ */
+static i2_error gpio_exti_task_start(void)
+{
+  i2_error ret = I2_SUCCESS;
+
+  vTaskSuspendAll();
+  if ( gpio_exti_task == NULL ) {
+    gpio_exti_fifo_init(&gpio_exti_queue, gpio_exti_queue_buf,
+                        GPIO_EXTI_QUEUE_SIZE, I2_FIFO_MODE_MPSC);
+    if ( xTaskCreate(gpio_exti_task_handler, "gpio_exti",
+                     GPIO_EXTI_TASK_STACK, NULL, GPIO_EXTI_TASK_PRIORITY,
+                     &gpio_exti_task) != pdPASS ) {
+      gpio_exti_task = NULL;
+      ret = I2_FAILURE;
+    }
+  }
+  xTaskResumeAll();
+
+  return ret;
+}
+
+/**
+ * @brief   Posts deferred EXTI line events.
+ * @details Queues an event per pending line and wakes handler task.
+ *
+ * @param[in] lines       Pending deferred EXTI lines.
+ * @retval  None.
+ */
+static void gpio_exti_defer(uint32_t lines)
+{
+  BaseType_t woken = pdFALSE;
+  uint8_t line;
+
+  while ( lines ) {
+    line = (uint8_t)(31 - __CLZ(lines));
+    lines &= ~(1UL << line);
+    if ( gpio_exti_fifo_put(&gpio_exti_queue, &line, true) < 0 ) {
+      gpio_exti_overrun++;
+    }
+  }
+
+  vTaskNotifyGiveFromISR(gpio_exti_task, &woken);
+  portYIELD_FROM_ISR(woken);
+}
+#endif /* ENABLE_RTOS_AWARE_HAL */
+
+/**
+ * @brief   Stores timestamped edges.
+ * @details Edge direction comes from edge trigger configuration, or from
+ *          pin level when line triggers on both edges.
+ *
+ * @param[in] lines       Pending timestamped EXTI lines.
+ * @param[in] ts          DWT cycle count at EXTI handler entry.
+ * @retval  None.
+ */
+static void gpio_exti_capture_store(uint32_t lines, uint32_t ts)
+{
+  i2_gpio_edge_t edge;
+  uint32_t bit;
+
+  edge.ts = ts;
+  while ( lines ) {
+    edge.line = (uint8_t)(31 - __CLZ(lines));
+    bit = 1UL << edge.line;
+    lines &= ~bit;
+
+    if ( !(EXTI->FTSR & bit) ) {
+      edge.rising = true;
+    } else if ( !(EXTI->RTSR & bit) ) {
+      edge.rising = false;
+    } else {
+      edge.rising = (gpio_capture_port[edge.line]->IDR & bit) != 0;
+    }
+
+    if ( gpio_edge_fifo_put(&gpio_capture_queue, &edge, true) < 0 ) {
+      gpio_capture_overrun++;
+    }
+  }
+}
+
+/**
+ * @brief   Starts DWT cycle counter.
+ * @details Cycle counter is the timestamp of captured edges.
+ *
+ * @retval  None.
+ */
+static void gpio_capture_clock_start(void)
+{
+  if ( !(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) ) {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  }
+}
+
+/**
+ * @brief   GPIO interrupt registration.
+ * @details Claims pin, registers callback of its EXTI line and then
+ *          configures pin for interrupts. Line state is only touched once
+ *          pin is owned, and EXTI routing once line is owned.
  *
  * @param[in] *inst       GPIO instance to use.
  * @param[in] mode        GPIO mode configuration.
  * @param[in] pull        GPIO pull / push configuration.
  * @param[in] cb          Callback for GPIO interrupt handler.
  * @param[in] arg         Arguments to be passed with callback.
- * @retval  None.
+ * @param[in] flags       GPIO_EXTI_DEFERRED and GPIO_EXTI_CAPTURE options.
+ * @retval  I2_SUCCESS or failure reason.
  */
-i2_error i2_gpio_config_interrupt(i2_gpio_inst_t *inst, uint32_t mode,
-                               uint32_t pull, void (*cb)(void *arg), void *arg)
+static i2_error gpio_interrupt_register(i2_gpio_inst_t *inst, uint32_t mode,
+                                        uint32_t pull,
+                                        void (*cb)(void *arg), void *arg,
+                                        uint32_t flags)
 {
   int32_t index;
   IRQn_Type irqn;
+  uint32_t mask;
 
   index = get_gpio_index(inst->gpio);
 
-  /* Invalid gpio */
-  if ( index >= NUM_GPIO_PER_PORT ) {
+  /* Invalid gpio, callback is optional only for edge capture */
+  if ( (index >= NUM_GPIO_PER_PORT) ||
+       (!cb && !(flags & GPIO_EXTI_CAPTURE)) ) {
     return I2_INVALID_PARAM;
   }
 
   /* Interrupt already registered for this line */
-  if ( gpio_isr_inst[index].cb ) {
+  if ( gpio_isr_inst[index].cb || (gpio_exti_capture & (1UL << index)) ) {
     return I2_NOT_AVAILABLE;
   }
 
-  if ( index == 0 ) {
-    irqn = EXTI0_IRQn;
-  } else if ( index == 1 ) {
-    irqn = EXTI1_IRQn;
-  } else if ( index == 2 ) {
-    irqn = EXTI2_IRQn;
-  } else if ( index == 3 ) {
-    irqn = EXTI3_IRQn;
-  } else if ( index == 4 ) {
-    irqn = EXTI4_IRQn;
-  } else if ( index >= 5 && index <= 9 ) {
+  if ( index <= 4 ) {
+    irqn = (IRQn_Type)(EXTI0_IRQn + index);
+  } else if ( index <= 9 ) {
     irqn = EXTI9_5_IRQn;
-  } else if ( index >= 10 && index <= 15 ) {
-    irqn = EXTI15_10_IRQn;
   } else {
-    return I2_INVALID_PARAM;
+    irqn = EXTI15_10_IRQn;
+  }
+
+#if defined ( ENABLE_RTOS_AWARE_HAL )
+  if ( flags & GPIO_EXTI_DEFERRED ) {
+    if ( gpio_exti_task_start() != I2_SUCCESS ) {
+      return I2_FAILURE;
+    }
+  }
+#else
+  if ( flags & GPIO_EXTI_DEFERRED ) {
+    return I2_NOT_AVAILABLE;
+  }
+#endif /* ENABLE_RTOS_AWARE_HAL */
+
+  if ( flags & GPIO_EXTI_CAPTURE ) {
+    gpio_capture_clock_start();
+  }
+
+  /* Pin must be ours before any line state is published, EXTI routing is
+   * only set up once line is registered too */
+  if ( !gpio_claim(inst, GPIO_MODE_INPUT, pull, 0) ) {
+    return I2_NOT_AVAILABLE;
+  }
+
+  mask = gpio_lock();
+  if ( gpio_isr_inst[index].cb || (gpio_exti_capture & (1UL << index)) ) {
+    /* Line taken by another pin meanwhile */
+    gpio_unlock(mask);
+    i2_gpio_release(inst);
+    return I2_NOT_AVAILABLE;
+  }
+  gpio_isr_inst[index].arg = arg;
+  gpio_isr_inst[index].cb = cb;
+#if defined ( ENABLE_RTOS_AWARE_HAL )
+  if ( flags & GPIO_EXTI_DEFERRED ) {
+    gpio_exti_deferred |= (1UL << index);
+  }
+#endif /* ENABLE_RTOS_AWARE_HAL */
+  if ( flags & GPIO_EXTI_CAPTURE ) {
+    gpio_capture_port[index] = inst->gpio_port;
+    gpio_exti_capture |= (1UL << index);
   }
-  i2_gpio_config(inst, mode, pull);
+  gpio_unlock(mask);
+
+  inst->mode = mode;
+  gpio_apply(inst);
 
   HAL_NVIC_SetPriority(irqn,
                        GPIO_EXTI_PREEMPTION_PRIORITY,
                        GPIO_EXTI_SUB_PRIORITY);
   HAL_NVIC_EnableIRQ(irqn);
 
-  gpio_isr_inst[index].cb = cb;
-  gpio_isr_inst[index].arg = arg;
+  return I2_SUCCESS;
+}
+
+/**
+ * @brief   EXTI dispatcher.
+ * @details Reads pending register once, clears all pending lines of the
+ *          handler in a single write and calls registered callbacks straight
+ *          from line indexed table, deferred lines are queued instead.
+ *          Edges of capture lines are stamped with the cycle count taken on
+ *          handler entry.
+ *
+ * @param[in] lines       EXTI lines served by calling handler.
+ * @retval  None.
+ */
+static inline void gpio_exti_dispatch(uint32_t lines)
+{
+  uint32_t ts = DWT->CYCCNT;
+  uint32_t pending = EXTI->PR & lines;
+  uint32_t line;
+
+  EXTI->PR = pending;
+
+  if ( pending & gpio_exti_capture ) {
+    gpio_exti_capture_store(pending & gpio_exti_capture, ts);
+  }
+
+#if defined ( ENABLE_RTOS_AWARE_HAL )
+  if ( pending & gpio_exti_deferred ) {
+    gpio_exti_defer(pending & gpio_exti_deferred);
+    pending &= ~gpio_exti_deferred;
+  }
+#endif /* ENABLE_RTOS_AWARE_HAL */
+
+  while ( pending ) {
+    line = 31 - __CLZ(pending);
+    pending &= ~(1UL << line);
+    if ( gpio_isr_inst[line].cb ) {
+      gpio_isr_inst[line].cb(gpio_isr_inst[line].arg);
+    }
+  }
+}
+
+/**
+ * @brief   GPIO interrupt configuration.
+ * @details Enables EXTI interrupt on a GPIO instance with specified callback.
+ *
+ * @param[in] *inst       GPIO instance to use.
+ * @param[in] mode        GPIO mode configuration.
+ * @param[in] pull        GPIO pull / push configuration.
+ * @param[in] cb          Callback for GPIO interrupt handler.
+ * @param[in] arg         Arguments to be passed with callback.
+ * @retval  None.
+ */
+i2_error i2_gpio_config_interrupt(i2_gpio_inst_t *inst, uint32_t mode,
+                               uint32_t pull, void (*cb)(void *arg), void *arg)
+{
+  return gpio_interrupt_register(inst, mode, pull, cb, arg, 0);
+}
+
+/**
+ * @brief   GPIO deferred interrupt configuration.
+ * @details Enables EXTI interrupt on a GPIO instance, callback runs in GPIO
+ *          handler task, created on first use. EXTI handler only queues line
+ *          events, so bursts of edges don't keep interrupts busy.
+ *
+ * @param[in] *inst       GPIO instance to use.
+ * @param[in] mode        GPIO mode configuration.
+ * @param[in] pull        GPIO pull / push configuration.
+ * @param[in] cb          Callback, called from GPIO handler task.
+ * @param[in] arg         Arguments to be passed with callback.
+ * @retval  I2_SUCCESS or failure reason, I2_NOT_AVAILABLE without RTOS.
+ */
+i2_error i2_gpio_config_interrupt_deferred(i2_gpio_inst_t *inst,
+                                          uint32_t mode, uint32_t pull,
+                                          void (*cb)(void *arg), void *arg)
+{
+  return gpio_interrupt_register(inst, mode, pull, cb, arg,
+                                 GPIO_EXTI_DEFERRED);
+}
+
+/**
+ * @brief   GPIO edge capture configuration.
+ * @details Enables EXTI interrupt on a GPIO instance, every edge is recorded
+ *          with DWT cycle count taken in EXTI handler, records are drained
+ *          with @ref i2_gpio_capture_read. Optional callback is called from
+ *          ISR after edge is recorded, e.g. to wake up a draining task.
+ *
+ * @param[in] *inst       GPIO instance to use.
+ * @param[in] mode        GPIO interrupt mode (edge triggers).
+ * @param[in] pull        GPIO pull / push configuration.
+ * @param[in] cb          Callback for GPIO interrupt handler, or NULL.
+ * @param[in] arg         Arguments to be passed with callback.
+ * @retval  I2_SUCCESS or failure reason.
+ */
+i2_error i2_gpio_config_capture(i2_gpio_inst_t *inst, uint32_t mode,
+                                uint32_t pull,
+                                void (*cb)(void *arg), void *arg)
+{
+  return gpio_interrupt_register(inst, mode, pull, cb, arg,
+                                 GPIO_EXTI_CAPTURE);
+}
+
+/**
+ * @brief   Reads captured edges.
+ * @details Drains up to @p count oldest edge records, in capture order.
+ *          Single reader only.
+ *
+ * @param[out] *edges     Buffer for edge records.
+ * @param[in]  count      Maximum number of records to read.
+ * @retval  Number of records read.
+ */
+int32_t i2_gpio_capture_read(i2_gpio_edge_t *edges, int32_t count)
+{
+  int32_t read = gpio_edge_fifo_read(&gpio_capture_queue, edges, count,
+                                     (__get_IPSR() != 0));
+
+  return (read < 0) ? 0 : read;
+}
+
+/**
+ * @brief   Lost captured edges.
+ * @details Edges dropped because records were not drained in time.
+ *
+ * @retval  Number of edges lost since start.
+ */
+uint32_t i2_gpio_capture_lost(void)
+{
+  return gpio_capture_overrun;
+}
+
+/**
+ * @brief   Delivers debounced edges of a port.
+ * @details Calls edge callback of every pin in @p edges.
+ *
+ * @param[in] port        Port index.
+ * @param[in] edges       Pins whose debounced level changed.
+ * @param[in] state       Debounced levels of port.
+ * @retval  None.
+ */
+static void gpio_debounce_notify(int32_t port, uint32_t edges, uint16_t state)
+{
+  int32_t slot;
+  int32_t i;
+
+  for ( i = 0; edges && (i < gpio_debounce_inputs); i++ ) {
+    slot = gpio_debounce_input[i].slot;
+    if ( ((slot / NUM_GPIO_PER_PORT) != port) ||
+         !(edges & (1UL << (slot % NUM_GPIO_PER_PORT))) ) {
+      continue;
+    }
+    edges &= ~(1UL << (slot % NUM_GPIO_PER_PORT));
+    gpio_debounce_input[i].cb(gpio_debounce_input[i].arg,
+                              (state >> (slot % NUM_GPIO_PER_PORT)) & 1);
+  }
+}
+
+#if defined ( ENABLE_RTOS_AWARE_HAL )
+/**
+ * @brief   Debounce timer callback.
+ * @details Runs debounce tick in timer service task.
+ *
+ * @param[in] timer       Debounce timer.
+ * @retval  None.
+ */
+static void gpio_debounce_timer_cb(TimerHandle_t timer)
+{
+  (void)timer;
+  i2_gpio_debounce_tick();
+}
+#endif /* ENABLE_RTOS_AWARE_HAL */
+
+/**
+ * @brief   GPIO debounce tick.
+ * @details Samples every port with debounced inputs in one IDR load and
+ *          steps vertical counters of all its pins at once, then delivers
+ *          debounced edges. Cost doesn't depend on bouncing. Driven every
+ *          GPIO_DEBOUNCE_PERIOD_MS by a software timer with RTOS aware HAL,
+ *          otherwise application calls it periodically.
+ *
+ * @retval  None.
+ */
+void i2_gpio_debounce_tick(void)
+{
+  gpio_debounce_t *db;
+  uint32_t ports = gpio_debounce_ports;
+  uint32_t mask;
+  uint16_t delta;
+  int32_t port;
+
+  while ( ports ) {
+    port = 31 - __CLZ(ports);
+    ports &= ~(1UL << port);
+    db = &gpio_debounce[port];
+
+    mask = gpio_lock();
+    delta = (i2_gpio_port_read(GPIO_PORTS[port].gpio_port) ^ db->state) &
+            db->mask;
+    /* Counters run while sample differs, reset otherwise */
+    db->cnt0 = ~(db->cnt0 & delta);
+    db->cnt1 = db->cnt0 ^ (db->cnt1 & delta);
+    delta &= db->cnt0 & db->cnt1;
+    db->state ^= delta;
+    gpio_unlock(mask);
+
+    if ( delta ) {
+      gpio_debounce_notify(port, delta, db->state);
+    }
+  }
+}
+
+/**
+ * @brief   GPIO debounced input configuration.
+ * @details Configures pin as input and delivers its debounced edges, a level
+ *          is accepted after being sampled 4 times in a row, every
+ *          GPIO_DEBOUNCE_PERIOD_MS. Debounce timer is started on first use.
+ *          Pin is claimed before it is registered, a pin already in use or
+ *          a full debounce table fails without side effects.
+ *
+ * @param[in] *inst       GPIO instance to use.
+ * @param[in] pull        GPIO pull / push configuration.
+ * @param[in] cb          Edge callback with new debounced level, called
+ *                        from timer service task.
+ * @param[in] arg         Arguments to be passed with callback.
+ * @retval  I2_SUCCESS or failure reason.
+ */
+i2_error i2_gpio_config_debounce(i2_gpio_inst_t *inst, uint32_t pull,
+                                 void (*cb)(void *arg, bool level), void *arg)
+{
+  gpio_debounce_t *db;
+  int32_t slot;
+  int32_t port;
+  uint16_t bit;
+  uint32_t mask;
+
+  if ( (NULL == inst) || !cb ) {
+    return I2_INVALID_PARAM;
+  }
+
+  slot = get_slot_index(inst);
+  if ( slot >= MAX_NUM_IO ) {
+    return I2_INVALID_PARAM;
+  }
+
+  port = slot / NUM_GPIO_PER_PORT;
+  bit = (uint16_t)inst->gpio;
+  db = &gpio_debounce[port];
+
+  if ( !gpio_claim(inst, GPIO_MODE_INPUT, pull, 0) ) {
+    return I2_NOT_AVAILABLE;
+  }
+
+  mask = gpio_lock();
+  if ( (gpio_debounce_inputs >= GPIO_DEBOUNCE_MAX_INPUTS) ||
+       (db->mask & bit) ) {
+    gpio_unlock(mask);
+    i2_gpio_release(inst);
+    return I2_NOT_AVAILABLE;
+  }
+  gpio_debounce_input[gpio_debounce_inputs].slot = slot;
+  gpio_debounce_input[gpio_debounce_inputs].cb = cb;
+  gpio_debounce_input[gpio_debounce_inputs].arg = arg;
+  gpio_debounce_inputs++;
+
+  /* Start from current level, no edge reported for it */
+  db->state = (db->state & ~bit) | (i2_gpio_port_read(inst->gpio_port) & bit);
+  db->cnt0 |= bit;
+  db->cnt1 |= bit;
+  db->mask |= bit;
+  gpio_debounce_ports |= (1UL << port);
+  gpio_unlock(mask);
+
+#if defined ( ENABLE_RTOS_AWARE_HAL )
+  vTaskSuspendAll();
+  if ( gpio_debounce_timer == NULL ) {
+    gpio_debounce_timer = xTimerCreate("gpio_db",
+                                       pdMS_TO_TICKS(GPIO_DEBOUNCE_PERIOD_MS),
+                                       pdTRUE, NULL, gpio_debounce_timer_cb);
+  }
+  xTaskResumeAll();
+  if ( (gpio_debounce_timer == NULL) ||
+       (xTimerStart(gpio_debounce_timer, 0) != pdPASS) ) {
+    return I2_FAILURE;
+  }
+#endif /* ENABLE_RTOS_AWARE_HAL */
 
   return I2_SUCCESS;
 }
 
+/**
+ * @brief   GPIO debounced level.
+ * @details Reads debounced level of an input configured with
+ *          @ref i2_gpio_config_debounce.
+ *
+ * @param[in] *inst       GPIO instance to read.
+ * @retval  Debounced level of pin.
+ */
+bool i2_gpio_debounce_get(i2_gpio_inst_t *inst)
+{
+  int32_t port = get_port_index(inst->gpio_port);
+
+  if ( port >= NUM_GPIO_PORTS ) {
+    return false;
+  }
+
+  return (gpio_debounce[port].state & inst->gpio) != 0;
+}
+
 /**
  * @brief   EXTI line interrupt handler 0.
  * @details Generic GPIO external interrupt handler for EXTI lines 0.
@@ -701,7 +1192,7 @@ i2_error i2_gpio_config_interrupt(i2_gpio_inst_t *inst, uint32_t mode,
  */
 void EXTI0_IRQHandler(void)
 {
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_0);
+  gpio_exti_dispatch(GPIO_PIN_0);
 }
 
 /**
@@ -712,7 +1203,7 @@ void EXTI0_IRQHandler(void)
  */
 void EXTI1_IRQHandler(void)
 {
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_1);
+  gpio_exti_dispatch(GPIO_PIN_1);
 }
 
 /**
@@ -723,7 +1214,7 @@ void EXTI1_IRQHandler(void)
  */
 void EXTI2_IRQHandler(void)
 {
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_2);
+  gpio_exti_dispatch(GPIO_PIN_2);
 }
 
 /**
@@ -734,7 +1225,7 @@ void EXTI2_IRQHandler(void)
  */
 void EXTI3_IRQHandler(void)
 {
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_3);
+  gpio_exti_dispatch(GPIO_PIN_3);
 }
 
 /**
@@ -745,7 +1236,7 @@ void EXTI3_IRQHandler(void)
  */
 void EXTI4_IRQHandler(void)
 {
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_4);
+  gpio_exti_dispatch(GPIO_PIN_4);
 }
 
 /**
@@ -756,11 +1247,7 @@ void EXTI4_IRQHandler(void)
  */
 void EXTI9_5_IRQHandler(void)
 {
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_5);
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_6);
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_7);
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_8);
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_9);
+  gpio_exti_dispatch(GPIO_EXTI_LINES_9_5);
 }
 
 /**
@@ -771,36 +1258,7 @@ void EXTI9_5_IRQHandler(void)
  */
 void EXTI15_10_IRQHandler(void)
 {
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_10);
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_11);
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_12);
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_13);
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_14);
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_15);
-}
-
-/**
- * @brief   EXTI line detection callbacks.
- * @details Generic GPIO external callback.
- *
- * @param[in] gpio     Specifies the pins connected EXTI line.
- * @retval  None.
- */
-void HAL_GPIO_EXTI_Callback(uint16_t gpio)
-{
-  int32_t index = get_gpio_index(gpio);
-
-  /* Invalid gpio - shouldn't happen */
-  if (index >= NUM_GPIO_PER_PORT) {
-    return;
-  }
-
-  /* Call the registered isr */
-  if (gpio_isr_inst[index].cb) {
-    gpio_isr_inst[index].cb(gpio_isr_inst[index].arg);
-  }
-
-  return;
+  gpio_exti_dispatch(GPIO_EXTI_LINES_15_10);
 }
 
 /************************ (C) COPYRIGHT iota2 ***[i2]*****END OF FILE**********/
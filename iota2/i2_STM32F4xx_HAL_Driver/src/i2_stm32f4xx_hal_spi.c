@@ -35,6 +35,7 @@
 #if defined ( ENABLE_RTOS_AWARE_HAL )
 #include <FreeRTOS.h>
 #include <semphr.h>
+#include <task.h>
 #endif
 
 #include "stm32f4xx_hal_conf.h"
@@ -48,6 +49,16 @@
 #define SPI_DMA_PREEMPTION_PRIORITY   ( 5 ) /**< SPI DMA preemption priority  */
 #define SPI_DMA_SUB_PRIORITY          ( 1 ) /**< SPI DMA sub priority         */
 
+/** @brief CR1 bits carried by a configuration image */
+#define SPI_CR1_CONFIG_MASK       ( SPI_CR1_BR | SPI_CR1_CPOL | SPI_CR1_CPHA |\
+                                    SPI_CR1_DFF | SPI_CR1_LSBFIRST )
+/** @brief Marks a precomputed device image, outside of CR1 register bits */
+#define SPI_CR1_IMAGE_VALID       ( 1UL << 31 )
+/** @brief Shorter transfers are polled instead of using interrupt / DMA */
+#define SPI_ASYNC_MIN_XFER_SIZE   ( 16 )
+/** @brief Number of entries in a CR1 lookup table */
+#define SPI_TABLE_SIZE(t)         ( sizeof(t) / sizeof((t)[0]) )
+
 /**
  * @defgroup I2_SPI_CONFIG SPI configurations.
  * Defines available configurations for SPI peripheral  including GPIO and DMA.
@@ -270,6 +281,10 @@ typedef struct {
   SemaphoreHandle_t     sem;              /**< SPI context semaphore          */
 #endif /* ENABLE_RTOS_AWARE_HAL */
   __IO ITStatus         status;           /**< SPI interrupt status           */
+  uint32_t              cr1;              /**< Applied CR1 configuration bits */
+  const i2_spi_xfer_t*  xfers;            /**< Running transaction segments   */
+  int32_t               xfer_count;       /**< Running transaction length     */
+  __IO int32_t          xfer_index;       /**< Running transaction segment    */
 } i2_spi_ctx_t;
 /** @} */ /* i2_spi_ctx_t */
 
@@ -329,6 +344,34 @@ static SPI_HandleTypeDef *spi2 = NULL;              /**< SPI2 control handler */
 static SPI_HandleTypeDef *spi3 = NULL;              /**< SPI3 control handler */
 #endif /* I2_ENABLE_SPI3_CONTEXT */
 
+/**
+ * @defgroup I2_SPI_CR1_TABLES SPI CR1 configuration tables.
+ * CR1 bits for each SPI setting, indexed by the public enumerations.
+ *
+ * @{
+ */
+/** @brief CR1 bits for @ref i2_spi_data_width_t */
+static const uint16_t spi_cr1_width[] = {
+  SPI_DATASIZE_8BIT,          SPI_DATASIZE_16BIT,
+};
+/** @brief CR1 bits for @ref i2_spi_clock_speed_t */
+static const uint16_t spi_cr1_clock[] = {
+  SPI_BAUDRATEPRESCALER_2,    SPI_BAUDRATEPRESCALER_4,
+  SPI_BAUDRATEPRESCALER_8,    SPI_BAUDRATEPRESCALER_16,
+  SPI_BAUDRATEPRESCALER_32,   SPI_BAUDRATEPRESCALER_64,
+  SPI_BAUDRATEPRESCALER_128,  SPI_BAUDRATEPRESCALER_256,
+};
+/** @brief CR1 bits for @ref i2_spi_mode_t */
+static const uint16_t spi_cr1_mode[] = {
+  SPI_POLARITY_LOW  | SPI_PHASE_1EDGE,  SPI_POLARITY_LOW  | SPI_PHASE_2EDGE,
+  SPI_POLARITY_HIGH | SPI_PHASE_1EDGE,  SPI_POLARITY_HIGH | SPI_PHASE_2EDGE,
+};
+/** @brief CR1 bits for @ref i2_spi_first_bit_t */
+static const uint16_t spi_cr1_first_bit[] = {
+  SPI_FIRSTBIT_MSB,           SPI_FIRSTBIT_LSB,
+};
+/** @} */ /* I2_SPI_CR1_TABLES */
+
 /* Private functions ---------------------------------------------------------*/
 /**
  * @brief   SPI instance to context converter.
@@ -349,23 +392,39 @@ static i2_spi_ctx_t* spi_inst_to_ctx(const char *name)
   return NULL;
 }
 
+/**
+ * @brief   SPI instance to context converter.
+ * @details Returns the context cached in the instance by @ref i2_spi_init,
+ *          falling back to a name search for instances not yet initialized.
+ *
+ * @param[in] *inst       SPI instance.
+ * @return  SPI context object.
+ */
+static inline i2_spi_ctx_t* spi_get_ctx(i2_spi_inst_t *inst)
+{
+  if ( inst->ctx ) {
+    return (i2_spi_ctx_t *)inst->ctx;
+  }
+  return spi_inst_to_ctx(inst->ctx_name);
+}
+
 /**
  * @brief   SPI handle to context converter.
- * @details Get SPI context from corresponding HAL handle.
+ * @details HAL handle is embedded in the SPI context, so context is
+ *          recovered from the handle address directly.
  *
  * @param[in] *hspi       SPI HAL handle.
  * @return  SPI context object.
  */
-static i2_spi_ctx_t* spi_handle_to_ctx(SPI_HandleTypeDef *hspi)
+static inline i2_spi_ctx_t* spi_handle_to_ctx(SPI_HandleTypeDef *hspi)
 {
-  int32_t i;
+  i2_spi_ctx_t *ctx = I2_CONTAINER_OF(hspi, i2_spi_ctx_t, spi);
 
-  for (i = 0; i < I2_MAX_NUM_SPI_CONTEXT; i++) {
-    if (&i2_spi_ctx_table[i].spi == hspi) {
-      return &i2_spi_ctx_table[i];
-    }
+  if ( (ctx < &i2_spi_ctx_table[0]) ||
+       (ctx >= &i2_spi_ctx_table[I2_MAX_NUM_SPI_CONTEXT]) ) {
+    return NULL;
   }
-  return NULL;
+  return ctx;
 }
 
 /* Public functions ----------------------------------------------------------*/
@@ -396,6 +455,9 @@ i2_error i2_spi_init(i2_spi_inst_t *inst)
     return I2_INVALID_PARAM;
   }
 
+  /* Cache context, so that transfers avoid the name search */
+  inst->ctx = ctx;
+
 #if defined ( ENABLE_RTOS_AWARE_HAL )
   /* Create mutexes. */
   ctx->mutex = xSemaphoreCreateMutex();
@@ -557,6 +619,8 @@ i2_error i2_spi_init(i2_spi_inst_t *inst)
   if ( HAL_SPI_Init(hspi) != HAL_OK ) {
     retval = I2_FAILURE;
   } else {
+    /* Track the applied configuration for later transfers */
+    ctx->cr1 = base->CR1 & SPI_CR1_CONFIG_MASK;
     for (i = 0; i < I2_MAX_NUM_SPI_INSTANCE; i++) {
       if ( !i2_spi_inst_table[i] ) {
         i2_spi_inst_table[i] = inst;
@@ -587,7 +651,7 @@ i2_error i2_spi_deinit(i2_spi_inst_t *inst)
   }
 
   /* get SPI context from name */
-  ctx = spi_inst_to_ctx(inst->ctx_name);
+  ctx = spi_get_ctx(inst);
   if ( !ctx ) {
     return I2_INVALID_PARAM;
   }
@@ -657,119 +721,473 @@ i2_spi_inst_t* i2_spi_inst_get(char *inst_name)
 }
 
 /**
- * @brief   SPI setting configuration.
- * @details Configures various settings for SPI peripheral.
+ * @brief   SPI CR1 image builder.
+ * @details Translates SPI settings into the CR1 configuration bits, without
+ *          touching the peripheral.
  *
- * @param[in] *ctx        SPI context.
  * @param[in] data_width  Size of data bits for SPI @ref i2_spi_data_width_t.
  * @param[in] clk_speed   SPI clock speed @ref i2_spi_clock_speed_t.
  * @param[in] spi_mode    SPI communication mode @ref i2_spi_mode_t.
  * @param[in] first_bit   Communication start bit @ref i2_spi_first_bit_t.
+ * @param[out] *cr1       CR1 configuration image.
  * @return  Execution error code @ref I2_ERROR.
  */
-static i2_error spi_config(i2_spi_ctx_t *ctx, i2_spi_data_width_t data_width,
-                           i2_spi_clock_speed_t clk_speed,
-                           i2_spi_mode_t spi_mode, i2_spi_first_bit_t first_bit)
+static i2_error spi_cr1_image(i2_spi_data_width_t data_width,
+                              i2_spi_clock_speed_t clk_speed,
+                              i2_spi_mode_t spi_mode,
+                              i2_spi_first_bit_t first_bit, uint32_t *cr1)
+{
+  if ( ((uint32_t)data_width >= SPI_TABLE_SIZE(spi_cr1_width)) ||
+       ((uint32_t)clk_speed >= SPI_TABLE_SIZE(spi_cr1_clock)) ||
+       ((uint32_t)spi_mode >= SPI_TABLE_SIZE(spi_cr1_mode)) ||
+       ((uint32_t)first_bit >= SPI_TABLE_SIZE(spi_cr1_first_bit)) ) {
+    return I2_INVALID_PARAM;
+  }
+
+  *cr1 = spi_cr1_width[data_width] | spi_cr1_clock[clk_speed] |
+         spi_cr1_mode[spi_mode] | spi_cr1_first_bit[first_bit];
+
+  return I2_SUCCESS;
+}
+
+/**
+ * @brief   SPI DMA data width update.
+ * @details Matches DMA peripheral and memory data size with SPI frame size.
+ *          DMA streams are idle between transfers, so the stream registers
+ *          are updated in place instead of re-initializing DMA.
+ *
+ * @param[in] *ctx        SPI context.
+ * @param[in] dff         SPI_CR1_DFF bit of configuration image.
+ * @return  None.
+ */
+static void spi_dma_width_set(i2_spi_ctx_t *ctx, uint32_t dff)
+{
+  uint32_t psize = dff ? DMA_PDATAALIGN_HALFWORD : DMA_PDATAALIGN_BYTE;
+  uint32_t msize = dff ? DMA_MDATAALIGN_HALFWORD : DMA_MDATAALIGN_BYTE;
+
+  ctx->hdma_rx.Init.PeriphDataAlignment = psize;
+  ctx->hdma_rx.Init.MemDataAlignment    = msize;
+  ctx->hdma_tx.Init.PeriphDataAlignment = psize;
+  ctx->hdma_tx.Init.MemDataAlignment    = msize;
+
+  ctx->dma_rx_stream->CR = (ctx->dma_rx_stream->CR &
+                            ~(DMA_SxCR_PSIZE | DMA_SxCR_MSIZE)) | psize | msize;
+  ctx->dma_tx_stream->CR = (ctx->dma_tx_stream->CR &
+                            ~(DMA_SxCR_PSIZE | DMA_SxCR_MSIZE)) | psize | msize;
+}
+
+/**
+ * @brief   SPI CR1 image apply.
+ * @details Programs a CR1 configuration image on the SPI controller. Nothing
+ *          is written when the image matches the one already applied,
+ *          otherwise the peripheral is disabled and only the configuration
+ *          bits are updated. HAL enables the peripheral back on next
+ *          transfer.
+ *
+ * @param[in] *ctx        SPI context.
+ * @param[in] cr1         CR1 configuration image.
+ * @return  None.
+ */
+static void spi_cr1_apply(i2_spi_ctx_t *ctx, uint32_t cr1)
 {
-  i2_error retval = I2_SUCCESS;
   SPI_HandleTypeDef *hspi;
-  uint32_t prescaler;
+  SPI_TypeDef *base;
+  uint32_t reg;
 
-  if ( !ctx ) {
-    return I2_INVALID_PARAM;
+  cr1 &= SPI_CR1_CONFIG_MASK;
+  if ( ctx->cr1 == cr1 ) {
+    return;
+  }
+
+  hspi = &(ctx->spi);
+  base = hspi->Instance;
+
+  /* BR, CPOL, CPHA and DFF must not change while SPI is enabled */
+  reg = base->CR1;
+  if ( reg & SPI_CR1_SPE ) {
+    while ( base->SR & SPI_SR_BSY );
+    reg &= ~SPI_CR1_SPE;
+    base->CR1 = reg;
+  }
+  base->CR1 = (reg & ~SPI_CR1_CONFIG_MASK) | cr1;
+
+  /* DMA transfers follow SPI frame size */
+  if ( (ctx->hal_mode == DMA_MODE) && ((ctx->cr1 ^ cr1) & SPI_CR1_DFF) ) {
+    spi_dma_width_set(ctx, cr1 & SPI_CR1_DFF);
   }
 
+  /* Keep HAL view in sync, it is used to select 8 / 16 bit transfers */
+  hspi->Init.BaudRatePrescaler  = cr1 & SPI_CR1_BR;
+  hspi->Init.CLKPolarity        = cr1 & SPI_CR1_CPOL;
+  hspi->Init.CLKPhase           = cr1 & SPI_CR1_CPHA;
+  hspi->Init.DataSize           = cr1 & SPI_CR1_DFF;
+  hspi->Init.FirstBit           = cr1 & SPI_CR1_LSBFIRST;
+
+  ctx->cr1 = cr1;
+}
+
+/**
+ * @brief   SPI polled transfer.
+ * @details Runs one transfer segment in polling mode.
+ *
+ * @param[in] *ctx        SPI context.
+ * @param[in] *xfer       Transfer segment.
+ * @param[in] timeout     SPI bus HAL timeout.
+ * @return  HAL status.
+ */
+static HAL_StatusTypeDef spi_xfer_poll(i2_spi_ctx_t *ctx,
+                                       const i2_spi_xfer_t *xfer,
+                                       uint32_t timeout)
+{
+  if ( !xfer->rxbuf ) {
+    return HAL_SPI_Transmit(&ctx->spi, (uint8_t *)xfer->txbuf, xfer->size,
+                            (TickType_t) timeout);
+  } else if ( !xfer->txbuf ) {
+    return HAL_SPI_Receive(&ctx->spi, xfer->rxbuf, xfer->size,
+                           (TickType_t) timeout);
+  }
+  return HAL_SPI_TransmitReceive(&ctx->spi, (uint8_t *)xfer->txbuf,
+                                 xfer->rxbuf, xfer->size, (TickType_t) timeout);
+}
+
+/**
+ * @brief   SPI asynchronous transfer start.
+ * @details Starts one transfer segment in interrupt or DMA mode, completion
+ *          is reported through @ref spi_cplt_callback. Also called from
+ *          completion interrupt to chain transaction segments.
+ *
+ * @param[in] *ctx        SPI context.
+ * @param[in] *xfer       Transfer segment.
+ * @return  HAL status.
+ */
+static HAL_StatusTypeDef spi_xfer_start(i2_spi_ctx_t *ctx,
+                                        const i2_spi_xfer_t *xfer)
+{
+  uint8_t *txbuf = (uint8_t *)xfer->txbuf;
+
+  if ( ctx->hal_mode == DMA_MODE ) {
+    if ( !xfer->rxbuf ) {
+      return HAL_SPI_Transmit_DMA(&ctx->spi, txbuf, xfer->size);
+    } else if ( !txbuf ) {
+      return HAL_SPI_Receive_DMA(&ctx->spi, xfer->rxbuf, xfer->size);
+    }
+    return HAL_SPI_TransmitReceive_DMA(&ctx->spi, txbuf, xfer->rxbuf,
+                                       xfer->size);
+  }
+
+  if ( !xfer->rxbuf ) {
+    return HAL_SPI_Transmit_IT(&ctx->spi, txbuf, xfer->size);
+  } else if ( !txbuf ) {
+    return HAL_SPI_Receive_IT(&ctx->spi, xfer->rxbuf, xfer->size);
+  }
+  return HAL_SPI_TransmitReceive_IT(&ctx->spi, txbuf, xfer->rxbuf, xfer->size);
+}
+
+/**
+ * @brief   SPI asynchronous transaction.
+ * @details Runs transfer segments back to back in interrupt or DMA mode.
+ *          First segment is started here, rest are chained from completion
+ *          interrupt, and caller waits once for the whole list.
+ *
+ * @param[in] *ctx        SPI context.
+ * @param[in] *xfers      Transfer segments.
+ * @param[in] count       Number of transfer segments.
+ * @param[in] timeout     SPI bus HAL timeout.
+ * @return  Execution error code @ref I2_ERROR.
+ */
+static i2_error spi_xfer_async(i2_spi_ctx_t *ctx, const i2_spi_xfer_t *xfers,
+                               int32_t count, uint32_t timeout)
+{
+  const i2_spi_xfer_t *last = &xfers[count - 1];
+  HAL_StatusTypeDef retval;
+#if !defined ( ENABLE_RTOS_AWARE_HAL )
+  uint32_t start;
+#endif /* ENABLE_RTOS_AWARE_HAL */
+
+#if defined ( ENABLE_RTOS_AWARE_HAL )
+  /* Drop completion left over from an aborted transfer */
+  xSemaphoreTake(ctx->sem, 0);
+#endif /* ENABLE_RTOS_AWARE_HAL */
+
+  ctx->xfers = xfers;
+  ctx->xfer_count = count;
+  ctx->xfer_index = 0;
+  ctx->status = I2_TRANSFER_WAIT;
+
+  retval = spi_xfer_start(ctx, &xfers[0]);
+  if ( retval != HAL_OK ) {
+    ctx->xfer_count = 0;
+    ctx->status = I2_TRANSFER_DONE;
+    return i2_get_hal_error(retval);
+  }
+
+#if defined ( ENABLE_RTOS_AWARE_HAL )
+  xSemaphoreTake(ctx->sem, (TickType_t)timeout);
+#else
+  start = HAL_GetTick();
+  while ( (ctx->status == I2_TRANSFER_WAIT) &&
+          ((HAL_GetTick() - start) < timeout) );
+#endif /* ENABLE_RTOS_AWARE_HAL */
+
+  if ( ctx->status == I2_TRANSFER_WAIT ) {
+    /* Complete interrupt was not received, stop the chain */
+    ctx->xfer_count = 0;
+    HAL_SPI_Abort(&ctx->spi);
+    return I2_TIMEOUT;
+  }
+
+  /* Check for error interrupt */
+  if ( ctx->status == I2_TRANSFER_ERROR ) {
+    return I2_FAILURE;
+  } else if ( last->txbuf && ctx->spi.TxXferCount ) {
+    /* Check if the tx xfer is done */
+    return I2_FAILURE;
+  } else if ( last->rxbuf && ctx->spi.RxXferCount ) {
+    /* Check if the rx xfer is done */
+    return I2_FAILURE;
+  }
+
+  return I2_SUCCESS;
+}
+
+/**
+ * @brief   SPI asynchronous mode check.
+ * @details Interrupt and DMA completions need a running scheduler. Before
+ *          scheduler start, kernel objects created in init leave interrupts
+ *          up to syscall priority masked, so completion would never arrive.
+ *
+ * @param[in] *ctx        SPI context.
+ * @return  true if transfers may complete asynchronously.
+ */
+static inline bool spi_async_ready(i2_spi_ctx_t *ctx)
+{
+  if ( ctx->hal_mode == POLLING_MODE ) {
+    return false;
+  }
+#if defined ( ENABLE_RTOS_AWARE_HAL )
+  return (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING);
+#else
+  return true;
+#endif /* ENABLE_RTOS_AWARE_HAL */
+}
+
+/**
+ * @brief   SPI raw transfer.
+ * @details Applies the configuration image and runs a list of transfer
+ *          segments on SPI bus, with CS already asserted. Segments shorter
+ *          than @ref SPI_ASYNC_MIN_XFER_SIZE are polled, as interrupt or DMA
+ *          setup costs more than the transfer itself. From the first longer
+ *          segment onward, the list is completed asynchronously. Before
+ *          scheduler start every segment is polled.
+ *
+ * @param[in] *ctx        SPI context.
+ * @param[in] cr1         CR1 configuration image.
+ * @param[in] *xfers      Transfer segments.
+ * @param[in] count       Number of transfer segments.
+ * @param[in] timeout     SPI bus HAL timeout.
+ * @return  Execution error code @ref I2_ERROR.
+ */
+static i2_error spi_xfer_raw(i2_spi_ctx_t *ctx, uint32_t cr1,
+                             const i2_spi_xfer_t *xfers, int32_t count,
+                             uint32_t timeout)
+{
+  i2_error err;
+  bool async;
+  int32_t i;
+
   /* SPI controller needs to be initialized first */
   if ( !ctx->initialized ) {
     return I2_FAILURE;
   }
 
-  /* Get the pointer to the SPI hspi */
-  hspi = &(ctx->spi);
+  for (i = 0; i < count; i++) {
+    if ( (xfers[i].size <= 0) || (!xfers[i].txbuf && !xfers[i].rxbuf) ) {
+      return I2_INVALID_PARAM;
+    }
+  }
+
+  spi_cr1_apply(ctx, cr1);
+  async = spi_async_ready(ctx);
+
+  for (i = 0; i < count; i++) {
+    if ( async && (xfers[i].size >= SPI_ASYNC_MIN_XFER_SIZE) ) {
+      return spi_xfer_async(ctx, &xfers[i], count - i, timeout);
+    }
+
+    err = i2_get_hal_error(spi_xfer_poll(ctx, &xfers[i], timeout));
+    if ( err != I2_SUCCESS ) {
+      return err;
+    }
+  }
+
+  return I2_SUCCESS;
+}
+
+/**
+ * @brief   SPI transfer.
+ * @details Locks the SPI context and runs the transfer segments with CS
+ *          asserted.
+ *
+ * @param[in] *inst       SPI instance.
+ * @param[in] *ctx        SPI context of instance.
+ * @param[in] cr1         CR1 configuration image.
+ * @param[in] *xfers      Transfer segments.
+ * @param[in] count       Number of transfer segments.
+ * @param[in] timeout     SPI bus HAL timeout.
+ * @return  Execution error code @ref I2_ERROR.
+ */
+static i2_error spi_xfer(i2_spi_inst_t *inst, i2_spi_ctx_t *ctx, uint32_t cr1,
+                         const i2_spi_xfer_t *xfers, int32_t count,
+                         uint32_t timeout)
+{
+  i2_error err = I2_FAILURE;
+
+#if defined ( ENABLE_RTOS_AWARE_HAL )
+  if (xSemaphoreTake(ctx->mutex, (TickType_t)timeout) == pdFALSE) {
+    return I2_TIMEOUT;
+  }
+#endif /* ENABLE_RTOS_AWARE_HAL*/
+
+  /* assert CS */
+  if ( i2_gpio_is_valid(&inst->CS) ) {
+    i2_gpio_set(&inst->CS, I2_LOW);
+  }
+
+  err = spi_xfer_raw(ctx, cr1, xfers, count, timeout);
+
+  /* deassert CS */
+  i2_gpio_set(&inst->CS, I2_HIGH);
+
+#if defined ( ENABLE_RTOS_AWARE_HAL )
+  xSemaphoreGive(ctx->mutex);
+#endif /* ENABLE_RTOS_AWARE_HAL */
+
+  return err;
+}
+
+/**
+ * @brief   SPI device configuration.
+ * @details Precomputes the SPI controller settings of a device instance.
+ *          Devices sharing a bus switch between their settings on each
+ *          @ref i2_spi_xfer, only the differing CR1 bits get reprogrammed.
+ *
+ * @param[in] *inst       SPI instance.
+ * @param[in] data_width  Size of data bits for SPI @ref i2_spi_data_width_t.
+ * @param[in] clk_speed   SPI clock speed @ref i2_spi_clock_speed_t.
+ * @param[in] spi_mode    SPI communication mode @ref i2_spi_mode_t.
+ * @param[in] first_bit   Communication start bit @ref i2_spi_first_bit_t.
+ * @return  Execution error code @ref I2_ERROR.
+ */
+i2_error i2_spi_config_set(i2_spi_inst_t *inst, i2_spi_data_width_t data_width,
+                           i2_spi_clock_speed_t clk_speed,
+                           i2_spi_mode_t spi_mode, i2_spi_first_bit_t first_bit)
+{
+  i2_error err;
+  uint32_t cr1;
 
-  /* Set the SPI mode */
-  switch ( spi_mode ) {
-  case I2_SPI_MODE_0 :
-    hspi->Init.CLKPhase = SPI_PHASE_1EDGE;
-    hspi->Init.CLKPolarity = SPI_POLARITY_LOW;
-    break;
-  case I2_SPI_MODE_1 :
-    hspi->Init.CLKPhase = SPI_PHASE_2EDGE;
-    hspi->Init.CLKPolarity = SPI_POLARITY_LOW;
-    break;
-  case I2_SPI_MODE_2 :
-    hspi->Init.CLKPhase = SPI_PHASE_1EDGE;
-    hspi->Init.CLKPolarity = SPI_POLARITY_HIGH;
-    break;
-  case I2_SPI_MODE_3 :
-    hspi->Init.CLKPhase = SPI_PHASE_2EDGE;
-    hspi->Init.CLKPolarity = SPI_POLARITY_HIGH;
-    break;
-  default:
+  if ( !inst ) {
     return I2_INVALID_PARAM;
   }
 
-  /* Set the SPI clock */
-  switch ( clk_speed ) {
-  case I2_SPI_CLK_40_MHZ:
-    prescaler = SPI_BAUDRATEPRESCALER_2;
-    break;
-  case I2_SPI_CLK_20_MHZ:
-    prescaler = SPI_BAUDRATEPRESCALER_4;
-    break;
-  case I2_SPI_CLK_10_MHZ:
-    prescaler = SPI_BAUDRATEPRESCALER_8;
-    break;
-  case I2_SPI_CLK_5_MHZ:
-    prescaler = SPI_BAUDRATEPRESCALER_16;
-    break;
-  case I2_SPI_CLK_2500_KHZ:
-    prescaler = SPI_BAUDRATEPRESCALER_32;
-    break;
-  case I2_SPI_CLK_1250_KHZ:
-    prescaler = SPI_BAUDRATEPRESCALER_64;
-    break;
-  case I2_SPI_CLK_625_KHZ:
-    prescaler = SPI_BAUDRATEPRESCALER_128;
-    break;
-  case I2_SPI_CLK_313_KHZ:
-    prescaler = SPI_BAUDRATEPRESCALER_256;
-    break;
-  default:
+  err = spi_cr1_image(data_width, clk_speed, spi_mode, first_bit, &cr1);
+  if ( err != I2_SUCCESS ) {
+    return err;
+  }
+
+  inst->cr1 = cr1 | SPI_CR1_IMAGE_VALID;
+
+  return I2_SUCCESS;
+}
+
+/**
+ * @brief   SPI send / receive with device configuration.
+ * @details Transmits and receives data on SPI bus using the settings stored
+ *          by @ref i2_spi_config_set, with CS already asserted.
+ *
+ * @param[in] *inst       SPI instance.
+ * @param[in] *txbuf      Buffer to transmit, NULL to only receive.
+ * @param[out] *rxbuf     Buffer to receive, NULL to only transmit.
+ * @param[in] size        Amount of data to be transmitted / received.
+ * @param[in] timeout     SPI bus HAL timeout.
+ * @return  Execution error code @ref I2_ERROR.
+ */
+i2_error i2_spi_xfer_raw(i2_spi_inst_t *inst, uint8_t *txbuf, uint8_t *rxbuf,
+                         int32_t size, uint32_t timeout)
+{
+  i2_spi_ctx_t *ctx;
+  i2_spi_xfer_t xfer = { txbuf, rxbuf, size };
+
+  if ( !inst || !(inst->cr1 & SPI_CR1_IMAGE_VALID) ) {
     return I2_INVALID_PARAM;
   }
-  hspi->Init.BaudRatePrescaler = prescaler;
-
-  /* Set the SPI data width */
-  switch ( data_width ) {
-  case I2_SPI_DATA_WIDTH_8BIT:
-    hspi->Init.DataSize = SPI_DATASIZE_8BIT;
-    break;
-  case I2_SPI_DATA_WIDTH_16BIT:
-    hspi->Init.DataSize = SPI_DATASIZE_16BIT;
-    break;
-  default:
+
+  ctx = spi_get_ctx(inst);
+  if ( !ctx ) {
     return I2_INVALID_PARAM;
   }
 
-  /* Set first bit shift order */
-  switch ( first_bit ) {
-  case I2_SPI_MSBIT_FIRST:
-    hspi->Init.FirstBit = SPI_FIRSTBIT_MSB;
-    break;
-  case I2_SPI_LSBIT_FIRST:
-    hspi->Init.FirstBit = SPI_FIRSTBIT_LSB;
-    break;
-  default:
+  return spi_xfer_raw(ctx, inst->cr1, &xfer, 1, timeout);
+}
+
+/**
+ * @brief   SPI send / receive with device configuration.
+ * @details Transmits and receives data on SPI bus using the settings stored
+ *          by @ref i2_spi_config_set, This function will asserts and
+ *          deasserts the CS pin.
+ *
+ * @param[in] *inst       SPI instance.
+ * @param[in] *txbuf      Buffer to transmit, NULL to only receive.
+ * @param[out] *rxbuf     Buffer to receive, NULL to only transmit.
+ * @param[in] size        Amount of data to be transmitted / received.
+ * @param[in] timeout     SPI bus HAL timeout.
+ * @return  Execution error code @ref I2_ERROR.
+ */
+i2_error i2_spi_xfer(i2_spi_inst_t *inst, uint8_t *txbuf, uint8_t *rxbuf,
+                     int32_t size, uint32_t timeout)
+{
+  i2_spi_ctx_t *ctx;
+  i2_spi_xfer_t xfer = { txbuf, rxbuf, size };
+
+  if ( !inst || !(inst->cr1 & SPI_CR1_IMAGE_VALID) ) {
     return I2_INVALID_PARAM;
   }
 
-  /* This will re-init the SPI controller */
-  if ( HAL_SPI_Init(hspi) != HAL_OK ) {
-    retval = I2_FAILURE;
+  ctx = spi_get_ctx(inst);
+  if ( !ctx ) {
+    return I2_INVALID_PARAM;
   }
 
-  return retval;
+  return spi_xfer(inst, ctx, inst->cr1, &xfer, 1, timeout);
+}
+
+/**
+ * @brief   SPI transaction.
+ * @details Runs a list of transfer segments (e.g. command, address and data
+ *          phases) back to back under one CS assertion, using the settings
+ *          stored by @ref i2_spi_config_set.
+ *
+ * @param[in] *inst       SPI instance.
+ * @param[in] *xfers      Transfer segments, must stay valid until return.
+ * @param[in] count       Number of transfer segments.
+ * @param[in] timeout     SPI bus HAL timeout.
+ * @return  Execution error code @ref I2_ERROR.
+ */
+i2_error i2_spi_transaction(i2_spi_inst_t *inst, const i2_spi_xfer_t *xfers,
+                            int32_t count, uint32_t timeout)
+{
+  i2_spi_ctx_t *ctx;
+
+  if ( !inst || !xfers || (count <= 0) ||
+       !(inst->cr1 & SPI_CR1_IMAGE_VALID) ) {
+    return I2_INVALID_PARAM;
+  }
+
+  ctx = spi_get_ctx(inst);
+  if ( !ctx ) {
+    return I2_INVALID_PARAM;
+  }
+
+  return spi_xfer(inst, ctx, inst->cr1, xfers, count, timeout);
 }
 
 /**
@@ -801,77 +1219,26 @@ i2_error i2_spi_txrx_raw( i2_spi_inst_t *inst, i2_spi_data_width_t data_width,
                           uint8_t *txbuf, uint8_t *rxbuf,
                           int32_t size, uint32_t timeout)
 {
-  i2_error err = I2_FAILURE;
-  HAL_StatusTypeDef retval;
+  i2_error err;
   i2_spi_ctx_t *ctx;
+  i2_spi_xfer_t xfer = { txbuf, rxbuf, size };
+  uint32_t cr1;
 
   if ( !inst ) {
     return I2_INVALID_PARAM;
   }
 
-  ctx = spi_inst_to_ctx(inst->ctx_name);
+  ctx = spi_get_ctx(inst);
   if ( !ctx ) {
     return I2_INVALID_PARAM;
   }
 
-  err = spi_config(ctx, data_width, clk_speed, spi_mode, first_bit);
+  err = spi_cr1_image(data_width, clk_speed, spi_mode, first_bit, &cr1);
   if ( err != I2_SUCCESS ) {
     return err;
   }
 
-  if ( ctx->hal_mode != POLLING_MODE ) {
-    ctx->status = I2_TRANSFER_WAIT;
-  }
-
-  if (ctx->hal_mode == INTERRUPT_MODE) {
-    if ( !rxbuf ) {
-      retval = HAL_SPI_Transmit_IT(&ctx->spi, txbuf, size);
-    } else if ( !txbuf ) {
-      retval = HAL_SPI_Receive_IT(&ctx->spi, rxbuf, size);
-    } else {
-      retval = HAL_SPI_TransmitReceive_IT(&ctx->spi, txbuf, rxbuf, size);
-    }
-  } else if (ctx->hal_mode == DMA_MODE) {
-    if ( !rxbuf ) {
-      retval = HAL_SPI_Transmit_DMA(&ctx->spi, txbuf, size);
-    } else if ( !txbuf ) {
-      retval = HAL_SPI_Receive_DMA(&ctx->spi, rxbuf, size);
-    } else {
-      retval = HAL_SPI_TransmitReceive_DMA(&ctx->spi, txbuf, rxbuf, size);
-    }
-    return I2_NOT_IMPLEMENTED;
-  } else {
-    retval = HAL_SPI_TransmitReceive(&ctx->spi, txbuf, rxbuf, size,
-                                      (TickType_t) timeout);
-  }
-
-  if ( ctx->hal_mode != POLLING_MODE ) {
-#if defined ( ENABLE_RTOS_AWARE_HAL )
-    if (xSemaphoreTake(ctx->sem, (TickType_t)timeout) == pdFALSE) {
-      retval = HAL_TIMEOUT;
-    }
-#else
-    while (ctx->status == I2_TRANSFER_WAIT);
-#endif /* ENABLE_RTOS_AWARE_HAL */
-  }
-
-  err = i2_get_hal_error(retval);
-
-  /* Check for error interrupt */
-  if ( ctx->status == I2_TRANSFER_ERROR ) {
-    err = I2_FAILURE;
-  } else if ( ctx->status == I2_TRANSFER_WAIT ) {
-    /* Complete interrupt was not received */
-    err = I2_TIMEOUT;
-  }  else if ( txbuf && ctx->spi.TxXferCount ) {
-    /* Check if the tx xfer is done */
-    err = I2_FAILURE;
-  } else if ( rxbuf && ctx->spi.RxXferCount ) {
-    /* Check if the rx xfer is done */
-    err = I2_FAILURE;
-  }
-
-  return err;
+  return spi_xfer_raw(ctx, cr1, &xfer, 1, timeout);
 }
 
 /**
@@ -904,40 +1271,26 @@ i2_error i2_spi_txrx( i2_spi_inst_t *inst, i2_spi_data_width_t data_width,
                       uint8_t *txbuf, uint8_t *rxbuf,
                       int32_t size, uint32_t timeout)
 {
-  i2_error err = I2_FAILURE;
+  i2_error err;
   i2_spi_ctx_t *ctx;
+  i2_spi_xfer_t xfer = { txbuf, rxbuf, size };
+  uint32_t cr1;
 
   if ( !inst ) {
     return I2_INVALID_PARAM;
   }
 
-  ctx = spi_inst_to_ctx(inst->ctx_name);
+  ctx = spi_get_ctx(inst);
   if ( !ctx ) {
     return I2_INVALID_PARAM;
   }
 
-#if defined ( ENABLE_RTOS_AWARE_HAL )
-  if (xSemaphoreTake(ctx->mutex, (TickType_t)timeout) == pdFALSE) {
-    return I2_TIMEOUT;
-  }
-#endif /* ENABLE_RTOS_AWARE_HAL*/
-
-  /* assert CS */
-  if ( i2_gpio_is_valid(&inst->CS) ) {
-    i2_gpio_set(&inst->CS, I2_LOW);
+  err = spi_cr1_image(data_width, clk_speed, spi_mode, first_bit, &cr1);
+  if ( err != I2_SUCCESS ) {
+    return err;
   }
 
-  err = i2_spi_txrx_raw(inst, data_width, clk_speed, spi_mode,
-                        first_bit, txbuf, rxbuf, size, timeout);
-
-  /* deassert CS */
-  i2_gpio_set(&inst->CS, I2_HIGH);
-
-#if defined ( ENABLE_RTOS_AWARE_HAL )
-  xSemaphoreGive(ctx->mutex);
-#endif /* ENABLE_RTOS_AWARE_HAL */
-
-  return err;
+  return spi_xfer(inst, ctx, cr1, &xfer, 1, timeout);
 }
 
 /**
@@ -1052,7 +1405,7 @@ i2_error i2_spi_cs_assert(i2_spi_inst_t *inst, uint32_t timeout)
     return I2_INVALID_PARAM;
   }
 
-  ctx = spi_inst_to_ctx(inst->ctx_name);
+  ctx = spi_get_ctx(inst);
   if ( !ctx ) {
     return I2_INVALID_PARAM;
   }
@@ -1086,7 +1439,7 @@ i2_error i2_spi_cs_deassert(i2_spi_inst_t *inst)
     return I2_INVALID_PARAM;
   }
 
-  ctx = spi_inst_to_ctx(inst->ctx_name);
+  ctx = spi_get_ctx(inst);
   if ( !ctx ) {
     return I2_INVALID_PARAM;
   }
@@ -1211,6 +1564,8 @@ void SPI3_DMA_TX_IRQHandler(void)
 /**
  * @brief   SPI completion callback.
  * @details System callback for SPI transmission and reception completion.
+ *          Starts next segment of a running transaction, and wakes up the
+ *          waiting task once all segments are done.
  *
  * @param[in] *hspi     SPI handler.
  * @return  None.
@@ -1218,17 +1573,29 @@ void SPI3_DMA_TX_IRQHandler(void)
 static void spi_cplt_callback(SPI_HandleTypeDef *hspi)
 {
 #if defined ( ENABLE_RTOS_AWARE_HAL )
-  static BaseType_t xHigherPriorityTaskWoken;
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 #endif /* ENABLE_RTOS_AWARE_HAL */
   i2_spi_ctx_t *ctx = spi_handle_to_ctx(hspi);
 
-  if (ctx) {
-#if defined ( ENABLE_RTOS_AWARE_HAL )
-    xSemaphoreGiveFromISR(ctx->sem, &xHigherPriorityTaskWoken);
-    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
-#endif /* ENABLE_RTOS_AWARE_HAL */
+  if ( !ctx ) {
+    return;
+  }
+
+  /* Chain next segment of transaction */
+  if ( ++ctx->xfer_index < ctx->xfer_count ) {
+    if ( spi_xfer_start(ctx, &ctx->xfers[ctx->xfer_index]) == HAL_OK ) {
+      return;
+    }
+    ctx->status = I2_TRANSFER_ERROR;
+  } else {
     ctx->status = I2_TRANSFER_DONE;
   }
+  ctx->xfer_count = 0;
+
+#if defined ( ENABLE_RTOS_AWARE_HAL )
+  xSemaphoreGiveFromISR(ctx->sem, &xHigherPriorityTaskWoken);
+  portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+#endif /* ENABLE_RTOS_AWARE_HAL */
 }
 
 /**
@@ -1277,16 +1644,17 @@ void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi)
 void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
 {
 #if defined ( ENABLE_RTOS_AWARE_HAL )
-  static BaseType_t xHigherPriorityTaskWoken;
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 #endif /* ENABLE_RTOS_AWARE_HAL */
   i2_spi_ctx_t *ctx = spi_handle_to_ctx(hspi);
 
   if ( ctx ) {
+    ctx->xfer_count = 0;
+    ctx->status = I2_TRANSFER_ERROR;
 #if defined ( ENABLE_RTOS_AWARE_HAL )
     xSemaphoreGiveFromISR(ctx->sem, &xHigherPriorityTaskWoken);
     portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 #endif /* ENABLE_RTOS_AWARE_HAL */
-    ctx->status = I2_TRANSFER_ERROR;
   }
 }
 
@@ -42,6 +42,7 @@
 #if defined ( ENABLE_RTOS_AWARE_HAL )
 #include <FreeRTOS.h>
 #include <semphr.h>
+#include <task.h>
 #endif /* ENABLE_RTOS_AWARE_HAL */
 
 /* Private defines -----------------------------------------------------------*/
@@ -51,6 +52,9 @@
 #define UART_DMA_PREEMPTION_PRIORITY  ( 5 ) /**< UART DMA Preemption priority */
 #define UART_DMA_SUB_PRIORITY         ( 1 ) /**< UART DMA Sub priority        */
 
+/** @brief HAL operation mode selected by a DMA enable configuration */
+#define UART_HAL_MODE(dma)  ( ((dma) == I2_ENABLE) ? DMA_MODE : INTERRUPT_MODE )
+
 /**
  * @defgroup I2_UART_CONFIG UART configurations.
  * Defines available configurations for UART peripheral including GPIO and DMA.
@@ -126,7 +130,8 @@
  *
  * @{
  */
-#define UART1_DMA_ENABLE          I2_DISABLE    /**< UART1 DMA Configuration  */
+#define UART1_RX_DMA_ENABLE       I2_ENABLE   /**< UART1 RX DMA Configuration */
+#define UART1_TX_DMA_ENABLE       I2_ENABLE   /**< UART1 TX DMA Configuration */
 #define UART1_RX_DMA_CONFIG       DMA_CHANNEL_4, DMA2_Stream5 /**< UART1 DMArx*/
 #define UART1_TX_DMA_CONFIG       DMA_CHANNEL_4, DMA2_Stream7 /**< UART1 DMAtx*/
 /** @} */ /* I2_UART1_DMA */
@@ -168,7 +173,8 @@
  *
  * @{
  */
-#define UART2_DMA_ENABLE          I2_DISABLE    /**< UART2 DMA Configuration  */
+#define UART2_RX_DMA_ENABLE       I2_ENABLE   /**< UART2 RX DMA Configuration */
+#define UART2_TX_DMA_ENABLE       I2_ENABLE   /**< UART2 TX DMA Configuration */
 #define UART2_RX_DMA_CONFIG       DMA_CHANNEL_4, DMA1_Stream5 /**< UART2 DMArx*/
 #define UART2_TX_DMA_CONFIG       DMA_CHANNEL_4, DMA1_Stream6 /**< UART2 DMAtx*/
 /** @} */ /* I2_UART2_DMA */
@@ -210,7 +216,9 @@
  *
  * @{
  */
-#define UART3_DMA_ENABLE          I2_DISABLE    /**< UART3 DMA Configuration  */
+/* DMA1 Stream3 is shared with SPI2 RX, UART3 TX runs on interrupts */
+#define UART3_RX_DMA_ENABLE       I2_ENABLE   /**< UART3 RX DMA Configuration */
+#define UART3_TX_DMA_ENABLE       I2_DISABLE  /**< UART3 TX DMA Configuration */
 #define UART3_RX_DMA_CONFIG       DMA_CHANNEL_4, DMA1_Stream1 /**< UART3 DMArx*/
 #define UART3_TX_DMA_CONFIG       DMA_CHANNEL_4, DMA1_Stream3 /**< UART3 DMAtx*/
 /** @} */ /* I2_UART3_DMA */
@@ -252,7 +260,9 @@
  *
  * @{
  */
-#define UART4_DMA_ENABLE          I2_DISABLE    /**< UART4 DMA Configuration  */
+/* DMA1 Stream2/4 are shared with SPI3 RX/SPI2 TX, UART4 runs on interrupts */
+#define UART4_RX_DMA_ENABLE       I2_DISABLE  /**< UART4 RX DMA Configuration */
+#define UART4_TX_DMA_ENABLE       I2_DISABLE  /**< UART4 TX DMA Configuration */
 #define UART4_RX_DMA_CONFIG       DMA_CHANNEL_4, DMA1_Stream2 /**< UART4 DMArx*/
 #define UART4_TX_DMA_CONFIG       DMA_CHANNEL_4, DMA1_Stream4 /**< UART4 DMAtx*/
 /** @} */ /* I2_UART4_DMA */
@@ -294,7 +304,9 @@
  *
  * @{
  */
-#define UART5_DMA_ENABLE          I2_DISABLE    /**< UART5 DMA Configuration  */
+/* DMA1 Stream7 is shared with SPI3 TX, UART5 TX runs on interrupts */
+#define UART5_RX_DMA_ENABLE       I2_ENABLE   /**< UART5 RX DMA Configuration */
+#define UART5_TX_DMA_ENABLE       I2_DISABLE  /**< UART5 TX DMA Configuration */
 #define UART5_RX_DMA_CONFIG       DMA_CHANNEL_4, DMA1_Stream0 /**< UART5 DMArx*/
 #define UART5_TX_DMA_CONFIG       DMA_CHANNEL_4, DMA1_Stream7 /**< UART5 DMAtx*/
 /** @} */ /* I2_UART5_DMA */
@@ -336,9 +348,10 @@
  *
  * @{
  */
-#define UART6_DMA_ENABLE          I2_DISABLE    /**< UART6 DMA Configuration  */
+#define UART6_RX_DMA_ENABLE       I2_ENABLE   /**< UART6 RX DMA Configuration */
+#define UART6_TX_DMA_ENABLE       I2_ENABLE   /**< UART6 TX DMA Configuration */
 #define UART6_RX_DMA_CONFIG       DMA_CHANNEL_5, DMA2_Stream1 /**< UART6 DMArx*/
-#define UART6_TX_DMA_CONFIG       DMA_CHANNEL_5, DMA2_Stream2 /**< UART6 DMAtx*/
+#define UART6_TX_DMA_CONFIG       DMA_CHANNEL_5, DMA2_Stream6 /**< UART6 DMAtx*/
 /** @} */ /* I2_UART6_DMA */
 /**
  * @defgroup I2_UART6_DMA_IRQn UART6 interrupt configurations.
@@ -347,14 +360,29 @@
  * @{
  */
 #define UART6_DMA_RX_IRQn         DMA2_Stream1_IRQn   /**< UART6 DMA RX IRQn  */
-#define UART6_DMA_TX_IRQn         DMA2_Stream2_IRQn   /**< UART6 DMA TX IRQn  */
+#define UART6_DMA_TX_IRQn         DMA2_Stream6_IRQn   /**< UART6 DMA TX IRQn  */
 #define UART6_DMA_RX_IRQHandler   DMA2_Stream1_IRQHandler /**< DMA RX handler */
-#define UART6_DMA_TX_IRQHandler   DMA2_Stream2_IRQHandler /**< DMA TX handler */
+#define UART6_DMA_TX_IRQHandler   DMA2_Stream6_IRQHandler /**< DMA TX handler */
 /** @} */ /* I2_UART6_DMA_IRQn */
 /** @} */ /* I2_UART6_CONFIG */
 #endif    /* I2_ENABLE_UART6_CONTEXT */
 /******************************************************************************/
 
+/**
+ * @defgroup uart_tx_desc_t UART asynchronous TX descriptor.
+ * Queued transfer request for @ref i2_uart_tx_async.
+ *
+ * @{
+ */
+/** @brief UART TX descriptor */
+typedef struct {
+  const uint8_t         *buf;             /**< Buffer to transmit             */
+  int32_t               size;             /**< Number of bytes to transmit    */
+  i2_uart_tx_cb_t       cb;               /**< Completion callback            */
+  void                  *arg;             /**< Completion callback argument   */
+} uart_tx_desc_t;
+/** @} */ /* uart_tx_desc_t */
+
 /**
  * @defgroup i2_uart_ctx_t UART peripheral context.
  * This defines the attributes of UART hardware controller.
@@ -393,10 +421,15 @@ typedef struct {
   __IO ITStatus         rx_status;        /**< UART RX interrupt status       */
   __IO ITStatus         tx_status;        /**< UART TX interrupt status       */
   i2_fifo_t             rx_fifo;          /**< FIFO object for UART RX mode   */
+  uint32_t              rx_dma_pos;       /**< Last seen DMA RX buffer offset */
   uint8_t               buff[I2_UART_FIFO_SIZE];  /**< UART Buffer            */
   int32_t               rx_water_mark;    /**< UART buffer water marking      */
   int32_t               rx_trigger_level; /**< UART buffer triggering level   */
   bool                  rx_buffering_on;  /**< UART buffering flag            */
+  i2_fifo_t             tx_queue;         /**< Async TX descriptor queue      */
+  uart_tx_desc_t        tx_desc[I2_UART_TX_QUEUE_LEN];  /**< TX descriptors   */
+  __IO bool             tx_busy;          /**< UART TX owned by a transfer    */
+  __IO bool             tx_async;         /**< Ongoing TX is an async one     */
 } i2_uart_ctx_t;
 /** @} */ /* i2_uart_ctx_t */
 
@@ -408,7 +441,9 @@ static i2_uart_ctx_t i2_uart_ctx_table[I2_MAX_NUM_UART_CONTEXT] = {
     { "usart1_rx",  UART1_RX_GPIO_CONFIG },
     { "usart1_tx",  UART1_TX_GPIO_CONFIG },
     { 0, 0, 0 }, { 0, 0, 0 },
-    115200,   INTERRUPT_MODE, POLLING_MODE, false,  USART1,
+    115200,
+    UART_HAL_MODE(UART1_RX_DMA_ENABLE), UART_HAL_MODE(UART1_TX_DMA_ENABLE),
+    false,    USART1,
     UART1_RX_DMA_CONFIG, DMA_PRIORITY_HIGH,     UART1_DMA_RX_IRQn,
     UART1_TX_DMA_CONFIG, DMA_PRIORITY_MEDIUM,   UART1_DMA_TX_IRQn,
   },
@@ -419,7 +454,9 @@ static i2_uart_ctx_t i2_uart_ctx_table[I2_MAX_NUM_UART_CONTEXT] = {
     { "usart2_rx",  UART2_RX_GPIO_CONFIG },
     { "usart2_tx",  UART2_TX_GPIO_CONFIG },
     { 0, 0, 0 }, { 0, 0, 0 },
-    115200,   INTERRUPT_MODE, POLLING_MODE, false,  USART2,
+    115200,
+    UART_HAL_MODE(UART2_RX_DMA_ENABLE), UART_HAL_MODE(UART2_TX_DMA_ENABLE),
+    false,    USART2,
     UART2_RX_DMA_CONFIG, DMA_PRIORITY_HIGH,     UART2_DMA_RX_IRQn,
     UART2_TX_DMA_CONFIG, DMA_PRIORITY_MEDIUM,   UART2_DMA_TX_IRQn,
   },
@@ -430,7 +467,9 @@ static i2_uart_ctx_t i2_uart_ctx_table[I2_MAX_NUM_UART_CONTEXT] = {
     { "usart3_rx",  UART3_RX_GPIO_CONFIG },
     { "usart3_tx",  UART3_TX_GPIO_CONFIG },
     { 0, 0, 0 }, { 0, 0, 0 },
-    115200,   INTERRUPT_MODE, POLLING_MODE, false,  USART3,
+    115200,
+    UART_HAL_MODE(UART3_RX_DMA_ENABLE), UART_HAL_MODE(UART3_TX_DMA_ENABLE),
+    false,    USART3,
     UART3_RX_DMA_CONFIG, DMA_PRIORITY_HIGH,     UART3_DMA_RX_IRQn,
     UART3_TX_DMA_CONFIG, DMA_PRIORITY_MEDIUM,   UART3_DMA_TX_IRQn,
   },
@@ -441,7 +480,9 @@ static i2_uart_ctx_t i2_uart_ctx_table[I2_MAX_NUM_UART_CONTEXT] = {
     { "uart4_rx",   UART4_RX_GPIO_CONFIG },
     { "uart4_tx",   UART4_TX_GPIO_CONFIG },
     { 0, 0, 0 }, { 0, 0, 0 },
-    115200,   INTERRUPT_MODE, POLLING_MODE, false,  UART4,
+    115200,
+    UART_HAL_MODE(UART4_RX_DMA_ENABLE), UART_HAL_MODE(UART4_TX_DMA_ENABLE),
+    false,    UART4,
     UART4_RX_DMA_CONFIG, DMA_PRIORITY_HIGH,     UART4_DMA_RX_IRQn,
     UART4_TX_DMA_CONFIG, DMA_PRIORITY_MEDIUM,   UART4_DMA_TX_IRQn,
   },
@@ -452,7 +493,9 @@ static i2_uart_ctx_t i2_uart_ctx_table[I2_MAX_NUM_UART_CONTEXT] = {
     { "uart5_rx",   UART5_RX_GPIO_CONFIG },
     { "uart5_tx",   UART5_TX_GPIO_CONFIG },
     { 0, 0, 0 }, { 0, 0, 0 },
-    115200,   INTERRUPT_MODE, POLLING_MODE, false,  UART5,
+    115200,
+    UART_HAL_MODE(UART5_RX_DMA_ENABLE), UART_HAL_MODE(UART5_TX_DMA_ENABLE),
+    false,    UART5,
     UART5_RX_DMA_CONFIG, DMA_PRIORITY_HIGH,     UART5_DMA_RX_IRQn,
     UART5_TX_DMA_CONFIG, DMA_PRIORITY_MEDIUM,   UART5_DMA_TX_IRQn,
   },
@@ -463,7 +506,9 @@ static i2_uart_ctx_t i2_uart_ctx_table[I2_MAX_NUM_UART_CONTEXT] = {
     { "uart6_rx",   UART6_RX_GPIO_CONFIG },
     { "uart6_tx",   UART6_TX_GPIO_CONFIG },
     { 0, 0, 0 }, { 0, 0, 0 },
-    115200,   INTERRUPT_MODE, POLLING_MODE, false,  USART6,
+    115200,
+    UART_HAL_MODE(UART6_RX_DMA_ENABLE), UART_HAL_MODE(UART6_TX_DMA_ENABLE),
+    false,    USART6,
     UART6_RX_DMA_CONFIG, DMA_PRIORITY_HIGH,     UART6_DMA_RX_IRQn,
     UART6_TX_DMA_CONFIG, DMA_PRIORITY_MEDIUM,   UART6_DMA_TX_IRQn,
   }
@@ -513,23 +558,351 @@ static i2_uart_ctx_t* uart_get_ctx_from_name(const char *name)
   return NULL;
 }
 
+/**
+ * @brief   Get UART context from instance.
+ * @details Returns the context cached in the instance by @ref i2_uart_init,
+ *          falling back to a name search for instances not yet initialized.
+ *
+ * @param[in] *inst         UART instance.
+ * @return  UART context object.
+ */
+static inline i2_uart_ctx_t* uart_get_ctx_from_inst(i2_uart_inst_t *inst)
+{
+  if ( inst->ctx ) {
+    return (i2_uart_ctx_t *)inst->ctx;
+  }
+  return uart_get_ctx_from_name(inst->ctx_name);
+}
+
 /**
  * @brief   Get UART context from handle.
- * @details Searches for UART handle in context table, and return context.
+ * @details HAL handle is embedded in the UART context, so context is
+ *          recovered from the handle address directly.
  *
  * @param[in] *huart        UART hadle to search.
  * @return  UART context object.
  */
-static i2_uart_ctx_t* uart_get_ctx_from_handle(UART_HandleTypeDef *huart)
+static inline i2_uart_ctx_t* uart_get_ctx_from_handle(UART_HandleTypeDef *huart)
 {
-  int32_t i;
+  i2_uart_ctx_t *ctx = I2_CONTAINER_OF(huart, i2_uart_ctx_t, uart);
 
-  for (i = 0; i < I2_MAX_NUM_UART_CONTEXT; i++) {
-    if (&i2_uart_ctx_table[i].uart == huart) {
-      return &i2_uart_ctx_table[i];
+  if ( (ctx < &i2_uart_ctx_table[0]) ||
+       (ctx >= &i2_uart_ctx_table[I2_MAX_NUM_UART_CONTEXT]) ) {
+    return NULL;
+  }
+  return ctx;
+}
+
+/**
+ * @brief   Signal UART RX reader.
+ * @details Updates the water mark and releases a task blocked in
+ *          i2_uart_rx(), if any is waiting for data.
+ *
+ * @param[in] *ctx        UART context.
+ * @param[in] count       Current RX FIFO count.
+ * @return  None.
+ */
+static void uart_rx_signal(i2_uart_ctx_t *ctx, int32_t count)
+{
+#if defined ( ENABLE_RTOS_AWARE_HAL )
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+#endif /* ENABLE_RTOS_AWARE_HAL */
+
+  /* Update the water mark */
+  if (ctx->rx_water_mark < count) {
+    ctx->rx_water_mark = count;
+  }
+
+  if ( (count <= 0) || (ctx->rx_status != I2_TRANSFER_WAIT) ) {
+    return;
+  }
+
+  ctx->rx_status = I2_TRANSFER_DONE;
+#if defined ( ENABLE_RTOS_AWARE_HAL )
+  xSemaphoreGiveFromISR(ctx->sem_rx, &xHigherPriorityTaskWoken);
+  portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+#endif /* ENABLE_RTOS_AWARE_HAL */
+}
+
+/**
+ * @brief   Synchronize RX FIFO with circular DMA.
+ * @details DMA writes straight into FIFO buffer, so only the write index has
+ *          to follow the DMA position derived from NDTR. Called from DMA half
+ *          / full complete and USART IDLE interrupts, which share priority.
+ *
+ * @param[in] *ctx        UART context.
+ * @return  Current RX FIFO count.
+ */
+static int32_t uart_rx_dma_sync(i2_uart_ctx_t *ctx)
+{
+  uint32_t pos;
+  uint32_t delta;
+
+  pos = I2_UART_FIFO_SIZE - __HAL_DMA_GET_COUNTER(&ctx->hdma_rx);
+  pos &= (I2_UART_FIFO_SIZE - 1);
+
+  delta = (pos - ctx->rx_dma_pos) & (I2_UART_FIFO_SIZE - 1);
+  ctx->rx_dma_pos = pos;
+
+  if ( delta ) {
+    __DMB();
+    ctx->rx_fifo.wr_index += delta;
+  }
+
+  return i2_fifo_count(&ctx->rx_fifo, true);
+}
+
+/**
+ * @brief   UART receive interrupt.
+ * @details Moves received byte into RX FIFO when buffering in interrupt mode.
+ *
+ * @param[in] *ctx        UART context.
+ * @return  None.
+ */
+static void uart_rx_byte_isr(i2_uart_ctx_t *ctx)
+{
+  uint8_t data;
+  int32_t count;
+
+  /* Reading DR will clear the RXNE */
+  data = (uint8_t)READ_REG(ctx->uart.Instance->DR);
+
+  count = i2_fifo_write(&ctx->rx_fifo, data, true);
+
+  /* Signal uart_rx that the FIFO is at the trigger level */
+  if ( count >= ctx->rx_trigger_level ) {
+    uart_rx_signal(ctx, count);
+  } else if (ctx->rx_water_mark < count) {
+    ctx->rx_water_mark = count;
+  }
+}
+
+/**
+ * @brief   UART idle interrupt.
+ * @details RX line went idle after a burst, publish whatever DMA has received
+ *          so far and signal uart_rx without waiting for trigger level.
+ *
+ * @param[in] *ctx        UART context.
+ * @return  None.
+ */
+static void uart_rx_idle_isr(i2_uart_ctx_t *ctx)
+{
+  int32_t count;
+
+  if (ctx->rx_hal_mode == DMA_MODE) {
+    count = uart_rx_dma_sync(ctx);
+  } else {
+    count = i2_fifo_count(&ctx->rx_fifo, true);
+  }
+
+  uart_rx_signal(ctx, count);
+}
+
+/**
+ * @brief   Lock UART TX ownership.
+ * @details Masks UART and DMA interrupts, callable from task and ISR.
+ *
+ * @return  Previous interrupt mask.
+ */
+static inline uint32_t uart_tx_lock(void)
+{
+#if defined ( ENABLE_RTOS_AWARE_HAL )
+  return portSET_INTERRUPT_MASK_FROM_ISR();
+#else
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  return primask;
+#endif /* ENABLE_RTOS_AWARE_HAL */
+}
+
+/**
+ * @brief   Unlock UART TX ownership.
+ * @details Counterpart of @ref uart_tx_lock.
+ *
+ * @param[in] mask        Interrupt mask returned by @ref uart_tx_lock.
+ * @return  None.
+ */
+static inline void uart_tx_unlock(uint32_t mask)
+{
+#if defined ( ENABLE_RTOS_AWARE_HAL )
+  portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+#else
+  __set_PRIMASK(mask);
+#endif /* ENABLE_RTOS_AWARE_HAL */
+}
+
+/**
+ * @brief   Start UART transmission.
+ * @details Kicks HAL transmission in configured TX mode.
+ *
+ * @param[in] *ctx        UART context.
+ * @param[in] *buf        Buffer to transmit.
+ * @param[in] size        Number of bytes to transmit.
+ * @return  HAL status.
+ */
+static HAL_StatusTypeDef uart_tx_start(i2_uart_ctx_t *ctx, const uint8_t *buf,
+                                       int32_t size)
+{
+  if (ctx->tx_hal_mode == DMA_MODE) {
+    return HAL_UART_Transmit_DMA(&ctx->uart, (uint8_t *)buf, size);
+  } else if (ctx->tx_hal_mode == INTERRUPT_MODE) {
+    return HAL_UART_Transmit_IT(&ctx->uart, (uint8_t *)buf, size);
+  }
+  return HAL_ERROR;
+}
+
+/**
+ * @brief   Complete head of async TX queue.
+ * @details Releases head descriptor and TX ownership, then reports status.
+ *
+ * @param[in] *ctx        UART context.
+ * @param[in] status      Transfer status to report.
+ * @return  None.
+ */
+static void uart_tx_async_done(i2_uart_ctx_t *ctx, i2_error status)
+{
+  uart_tx_desc_t desc;
+
+  if ( i2_fifo_get(&ctx->tx_queue, &desc, true) < 0 ) {
+    return;
+  }
+
+  ctx->tx_async = false;
+  ctx->tx_busy = false;
+
+  if ( desc.cb ) {
+    desc.cb(desc.arg, status);
+  }
+}
+
+/**
+ * @brief   Start next async TX descriptor.
+ * @details Takes TX ownership if line is free and a descriptor is queued.
+ *          Owner of TX is the only consumer of the descriptor queue.
+ *
+ * @param[in] *ctx        UART context.
+ * @return  None.
+ */
+static void uart_tx_async_next(i2_uart_ctx_t *ctx)
+{
+  uart_tx_desc_t *desc;
+  uint8_t *head;
+  uint32_t mask;
+  bool start;
+
+  for (;;) {
+    start = false;
+
+    mask = uart_tx_lock();
+    if ( !ctx->tx_busy &&
+         (i2_fifo_peek_linear(&ctx->tx_queue, &head, true) > 0) ) {
+      ctx->tx_busy = true;
+      ctx->tx_async = true;
+      start = true;
     }
+    uart_tx_unlock(mask);
+
+    if ( !start ) {
+      return;
+    }
+
+    desc = (uart_tx_desc_t *)head;
+    if ( uart_tx_start(ctx, desc->buf, desc->size) == HAL_OK ) {
+      return;
+    }
+
+    /* Could not start, report and move on to next descriptor */
+    uart_tx_async_done(ctx, I2_FAILURE);
   }
-  return NULL;
+}
+
+/**
+ * @brief   Claim UART TX for a blocking transfer.
+ * @details Waits for asynchronous transfers owning the line to finish, up to
+ *          the caller timeout. Time spent waiting is taken off the timeout,
+ *          so the whole blocking call stays within it.
+ *
+ * @param[in]     *ctx      UART context.
+ * @param[in,out] *timeout  Caller timeout in ms, updated with time left.
+ * @return  True if TX ownership was taken.
+ */
+static bool uart_tx_claim(i2_uart_ctx_t *ctx, uint32_t *timeout)
+{
+  uint32_t start = HAL_GetTick();
+  uint32_t elapsed;
+  uint32_t mask;
+  bool claimed;
+
+  for (;;) {
+    mask = uart_tx_lock();
+    claimed = !ctx->tx_busy;
+    if ( claimed ) {
+      ctx->tx_busy = true;
+    }
+    uart_tx_unlock(mask);
+
+    elapsed = HAL_GetTick() - start;
+    if ( claimed ) {
+      if ( *timeout != HAL_MAX_DELAY ) {
+        *timeout = (elapsed < *timeout) ? (*timeout - elapsed) : 0;
+      }
+      return true;
+    }
+    if ( (*timeout != HAL_MAX_DELAY) && (elapsed >= *timeout) ) {
+      return false;
+    }
+
+#if defined ( ENABLE_RTOS_AWARE_HAL )
+    if ( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING ) {
+      vTaskDelay(1);
+    }
+#endif /* ENABLE_RTOS_AWARE_HAL */
+  }
+}
+
+/**
+ * @brief   Release UART TX after a blocking transfer.
+ * @details Resumes any async descriptors queued meanwhile.
+ *
+ * @param[in] *ctx        UART context.
+ * @return  None.
+ */
+static void uart_tx_release(i2_uart_ctx_t *ctx)
+{
+  ctx->tx_busy = false;
+  uart_tx_async_next(ctx);
+}
+
+/**
+ * @brief   UART interrupt dispatcher.
+ * @details Handles RX buffering (RXNE & IDLE) before handing over to HAL for
+ *          transmission and error processing.
+ *
+ * @param[in] *huart      UART handler.
+ * @return  None.
+ */
+static void uart_irq_handler(UART_HandleTypeDef *huart)
+{
+  i2_uart_ctx_t *ctx = uart_get_ctx_from_handle(huart);
+  uint32_t sr = READ_REG(huart->Instance->SR);
+  uint32_t cr1 = READ_REG(huart->Instance->CR1);
+
+  if ( ctx && ctx->rx_buffering_on ) {
+    if ( (sr & USART_SR_RXNE) && (cr1 & USART_CR1_RXNEIE) &&
+         (ctx->rx_hal_mode == INTERRUPT_MODE) ) {
+      /* SR read followed by DR read also clears IDLE */
+      uart_rx_byte_isr(ctx);
+    } else if ( sr & USART_SR_IDLE ) {
+      __HAL_UART_CLEAR_IDLEFLAG(huart);
+    }
+
+    if ( (sr & USART_SR_IDLE) && (cr1 & USART_CR1_IDLEIE) ) {
+      uart_rx_idle_isr(ctx);
+    }
+  }
+
+  HAL_UART_IRQHandler(huart);
 }
 
 /* Public functions ----------------------------------------------------------*/
@@ -562,6 +935,9 @@ i2_error i2_uart_init(i2_uart_inst_t *inst)
     return I2_INVALID_PARAM;
   }
 
+  /* Cache context, so that later calls avoid the name search */
+  inst->ctx = ctx;
+
   /* Prevent re-init */
   if ( ctx->initialized ) {
     return I2_NOT_AVAILABLE;
@@ -780,7 +1156,15 @@ i2_error i2_uart_init(i2_uart_inst_t *inst)
     }
   }
 
-  i2_fifo_init(&ctx->rx_fifo, ctx->buff, I2_UART_FIFO_SIZE);
+  /* Single producer (RX ISR or DMA) and single consumer (i2_uart_rx) */
+  i2_fifo_init_spsc(&ctx->rx_fifo, ctx->buff, I2_UART_FIFO_SIZE);
+  ctx->rx_dma_pos         = 0;
+
+  /* Many producers (tasks & ISRs), TX owner consumes */
+  i2_fifo_init_elem(&ctx->tx_queue, ctx->tx_desc, I2_UART_TX_QUEUE_LEN,
+                    sizeof(uart_tx_desc_t), I2_FIFO_MODE_MPSC);
+  ctx->tx_busy            = false;
+  ctx->tx_async           = false;
 
   ctx->initialized        = true;
   ctx->rx_trigger_level   = I2_UART_FIFO_HALF_SIZE;
@@ -808,7 +1192,7 @@ i2_error i2_uart_reset(i2_uart_inst_t *inst)
     return I2_INVALID_PARAM;
   }
 
-  ctx = uart_get_ctx_from_name(inst->ctx_name);
+  ctx = uart_get_ctx_from_inst(inst);
   if ( !ctx ) {
     return I2_INVALID_PARAM;
   }
@@ -868,7 +1252,8 @@ i2_uart_inst_t* i2_uart_inst_get(char *inst_name)
  * @param[in]   *timeout    UART peripheral HAL timeput.
  * @return  Execution error code @ref I2_ERROR.
  *
- * @note    It will block until the UART TX is finished.
+ * @note    It will block until the UART TX is finished. Async transfers
+ *          owning the line are waited for within the same timeout.
  */
 i2_error i2_uart_tx(i2_uart_inst_t *inst, uint8_t *txbuf, int32_t size,
                     int32_t *num_bytes, uint32_t timeout)
@@ -882,7 +1267,7 @@ i2_error i2_uart_tx(i2_uart_inst_t *inst, uint8_t *txbuf, int32_t size,
     return I2_INVALID_PARAM;
   }
 
-  ctx = uart_get_ctx_from_name(inst->ctx_name);
+  ctx = uart_get_ctx_from_inst(inst);
   if ( !ctx ) {
     return I2_INVALID_PARAM;
   }
@@ -899,15 +1284,23 @@ i2_error i2_uart_tx(i2_uart_inst_t *inst, uint8_t *txbuf, int32_t size,
   /* Get the pointer to the UART handle */
   huart = &(ctx->uart);
 
+  /* Wait for async transfers owning the line */
+  if ( !uart_tx_claim(ctx, &timeout) ) {
+    err = I2_TIMEOUT;
+    if ( num_bytes ) {
+      *num_bytes = 0;
+    }
+    goto err;
+  }
+
   ctx->tx_status = I2_TRANSFER_WAIT;
 
-  if (ctx->tx_hal_mode == INTERRUPT_MODE) {
-    retval = HAL_UART_Transmit_IT(huart, txbuf, size);
-  } else if (ctx->tx_hal_mode == DMA_MODE) {
-    retval = HAL_UART_Transmit_DMA(huart, txbuf, size);
+  if ( (ctx->tx_hal_mode == INTERRUPT_MODE) ||
+       (ctx->tx_hal_mode == DMA_MODE) ) {
+    retval = uart_tx_start(ctx, txbuf, size);
   } else {
     err = I2_NOT_SUPPORTED;
-    goto err;
+    goto out;
   }
 
 #if defined ( ENABLE_RTOS_AWARE_HAL )
@@ -941,6 +1334,9 @@ i2_error i2_uart_tx(i2_uart_inst_t *inst, uint8_t *txbuf, int32_t size,
     HAL_UART_AbortTransmit(huart);
   }
 
+out:
+  uart_tx_release(ctx);
+
 err:
 #if defined ( ENABLE_RTOS_AWARE_HAL )
   xSemaphoreGive(ctx->mutex_tx);
@@ -949,6 +1345,80 @@ err:
   return err;
 }
 
+/**
+ * @brief   UART asynchronous transmission function.
+ * @details Queues a transmit descriptor and returns right away. Descriptors
+ *          are sent back to back in queue order, next one is started from
+ *          the TX complete interrupt of the previous one. Can be called from
+ *          any number of tasks and ISRs.
+ *
+ * @param[in] *inst       UART instance to use.
+ * @param[in] *txbuf      Buffer to transmit, must stay valid until completion.
+ * @param[in] size        Number of bytes to send.
+ * @param[in] cb          Completion callback, invoked from ISR, can be NULL.
+ * @param[in] *arg        Completion callback argument.
+ * @return  Execution error code @ref I2_ERROR, I2_BUSY if queue is full.
+ *
+ * @note    Use @ref i2_uart_tx_notify_cb as callback, with a task handle as
+ *          argument, to get completion as a task notification.
+ */
+i2_error i2_uart_tx_async(i2_uart_inst_t *inst, const uint8_t *txbuf,
+                          int32_t size, i2_uart_tx_cb_t cb, void *arg)
+{
+  i2_uart_ctx_t *ctx;
+  uart_tx_desc_t desc;
+
+  if ( !inst || !txbuf || (size <= 0) ) {
+    return I2_INVALID_PARAM;
+  }
+
+  ctx = uart_get_ctx_from_inst(inst);
+  if ( !ctx || !ctx->initialized ) {
+    return I2_INVALID_PARAM;
+  }
+
+  if ( (ctx->tx_hal_mode != DMA_MODE) &&
+       (ctx->tx_hal_mode != INTERRUPT_MODE) ) {
+    return I2_NOT_SUPPORTED;
+  }
+
+  desc.buf = txbuf;
+  desc.size = size;
+  desc.cb = cb;
+  desc.arg = arg;
+
+  if ( i2_fifo_put(&ctx->tx_queue, &desc, (__get_IPSR() != 0)) < 0 ) {
+    return I2_BUSY;
+  }
+
+  uart_tx_async_next(ctx);
+
+  return I2_SUCCESS;
+}
+
+#if defined ( ENABLE_RTOS_AWARE_HAL )
+/**
+ * @brief   Task notification completion callback.
+ * @details Ready made @ref i2_uart_tx_cb_t that gives a notification to the
+ *          task passed as argument, to be taken with ulTaskNotifyTake().
+ *
+ * @param[in] *arg        Task handle (TaskHandle_t) to notify.
+ * @param[in] status      Transfer status.
+ * @return  None.
+ */
+void i2_uart_tx_notify_cb(void *arg, i2_error status)
+{
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+  (void)status;
+
+  if ( arg ) {
+    vTaskNotifyGiveFromISR((TaskHandle_t)arg, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+  }
+}
+#endif /* ENABLE_RTOS_AWARE_HAL */
+
 /**
  * @brief   UART polling transmission API.
  * @details Polling based UART transmission API.
@@ -960,8 +1430,8 @@ err:
  * @param[in]   *timeout    UART peripheral HAL timeput.
  * @return  Execution error code @ref I2_ERROR.
  *
- * @note    It can be used along with interrupt/DMA based i2_uart_tx() API
- *          without any special precaution.
+ * @note    Takes TX ownership like @ref i2_uart_tx, so it waits for queued
+ *          @ref i2_uart_tx_async transfers to finish, within the timeout.
  */
 i2_error i2_uart_tx_polling(i2_uart_inst_t *inst, uint8_t *txbuf, int32_t size,
                             int32_t *num_bytes, uint32_t timeout)
@@ -975,7 +1445,7 @@ i2_error i2_uart_tx_polling(i2_uart_inst_t *inst, uint8_t *txbuf, int32_t size,
     return I2_INVALID_PARAM;
   }
 
-  ctx = uart_get_ctx_from_name(inst->ctx_name);
+  ctx = uart_get_ctx_from_inst(inst);
   if ( !ctx ) {
     return I2_INVALID_PARAM;
   }
@@ -992,6 +1462,15 @@ i2_error i2_uart_tx_polling(i2_uart_inst_t *inst, uint8_t *txbuf, int32_t size,
   /* Get the pointer to the UART handle */
   huart = &(ctx->uart);
 
+  /* Wait for async transfers owning the line, never abort them */
+  if ( !uart_tx_claim(ctx, &timeout) ) {
+    err = I2_TIMEOUT;
+    if ( num_bytes ) {
+      *num_bytes = 0;
+    }
+    goto err;
+  }
+
   retval = HAL_UART_Transmit(huart, txbuf, size, (TickType_t)timeout);
   err = i2_get_hal_error(retval);
 
@@ -1005,9 +1484,13 @@ i2_error i2_uart_tx_polling(i2_uart_inst_t *inst, uint8_t *txbuf, int32_t size,
   }
 
   if ( err != I2_SUCCESS ) {
+    /* Only stops transfer started here, line is owned */
     HAL_UART_AbortTransmit(huart);
   }
 
+  uart_tx_release(ctx);
+
+err:
 #if defined ( ENABLE_RTOS_AWARE_HAL )
   xSemaphoreGive(ctx->mutex_tx);
 #endif /* ENABLE_RTOS_AWARE_HAL */
@@ -1037,7 +1520,7 @@ i2_error i2_uart_rx_buffering_start(i2_uart_inst_t *inst)
     return I2_INVALID_PARAM;
   }
 
-  ctx = uart_get_ctx_from_name(inst->ctx_name);
+  ctx = uart_get_ctx_from_inst(inst);
   if ( !ctx ) {
     return I2_INVALID_PARAM;
   }
@@ -1045,10 +1528,22 @@ i2_error i2_uart_rx_buffering_start(i2_uart_inst_t *inst)
   /* Get the pointer to the UART handle */
   huart = &(ctx->uart);
 
+  i2_fifo_reset(&ctx->rx_fifo);
+  ctx->rx_dma_pos = 0;
+
   if ( ctx->rx_hal_mode == INTERRUPT_MODE ) {
-    retval = HAL_UART_Receive_IT(huart, (uint8_t*)ctx->buff, I2_UART_FIFO_SIZE);
+    /* Bytes are moved to FIFO by uart_irq_handler, not by HAL */
+    ctx->rx_buffering_on = true;
+    __HAL_UART_ENABLE_IT(huart, UART_IT_RXNE);
+    retval = HAL_OK;
   } else if ( ctx->rx_hal_mode == DMA_MODE ) {
+    /* Circular DMA writes straight into the FIFO buffer */
     retval = HAL_UART_Receive_DMA(huart, (uint8_t*)ctx->buff, I2_UART_FIFO_SIZE);
+    if ( retval == HAL_OK ) {
+      /* Keep line errors from aborting the circular stream */
+      CLEAR_BIT(huart->Instance->CR3, USART_CR3_EIE);
+      ctx->rx_buffering_on = true;
+    }
   } else {
     err = I2_NOT_SUPPORTED;
   }
@@ -1056,7 +1551,9 @@ i2_error i2_uart_rx_buffering_start(i2_uart_inst_t *inst)
   if ( err == I2_SUCCESS ) {
     err = i2_get_hal_error(retval);
     if ( err == I2_SUCCESS ) {
-      ctx->rx_buffering_on = true;
+      /* Flush stale IDLE, then report end of every burst */
+      __HAL_UART_CLEAR_IDLEFLAG(huart);
+      __HAL_UART_ENABLE_IT(huart, UART_IT_IDLE);
     }
   }
 
@@ -1083,7 +1580,7 @@ i2_error i2_uart_rx_buffering_stop(i2_uart_inst_t *inst)
     return I2_INVALID_PARAM;
   }
 
-  ctx = uart_get_ctx_from_name(inst->ctx_name);
+  ctx = uart_get_ctx_from_inst(inst);
   if ( !ctx ) {
     return I2_INVALID_PARAM;
   }
@@ -1091,8 +1588,13 @@ i2_error i2_uart_rx_buffering_stop(i2_uart_inst_t *inst)
   /* Get the pointer to the UART handle */
   huart = &(ctx->uart);
 
+  __HAL_UART_DISABLE_IT(huart, UART_IT_IDLE);
+  __HAL_UART_DISABLE_IT(huart, UART_IT_RXNE);
+  ctx->rx_buffering_on = false;
+
   retval = HAL_UART_AbortReceive(huart);
   i2_fifo_reset(&ctx->rx_fifo);
+  ctx->rx_dma_pos = 0;
 
 #if defined ( ENABLE_RTOS_AWARE_HAL )
   /* Reset the semaphore back to 0 */
@@ -1102,9 +1604,6 @@ i2_error i2_uart_rx_buffering_stop(i2_uart_inst_t *inst)
   ctx->rx_water_mark = 0;
 
   err = i2_get_hal_error(retval);
-  if (err == I2_SUCCESS) {
-    ctx->rx_buffering_on = false;
-  }
 
   return err;
 }
@@ -1157,7 +1656,7 @@ i2_error i2_uart_rx(i2_uart_inst_t *inst, uint8_t *rxbuf, int32_t size,
     return I2_INVALID_PARAM;
   }
 
-  ctx = uart_get_ctx_from_name(inst->ctx_name);
+  ctx = uart_get_ctx_from_inst(inst);
   if ( !ctx ) {
     return I2_INVALID_PARAM;
   }
@@ -1175,10 +1674,16 @@ i2_error i2_uart_rx(i2_uart_inst_t *inst, uint8_t *rxbuf, int32_t size,
   /* desired read size */
   _size = size;
 
+  /* Announce reader before checking FIFO, so no RX event can be missed */
+  ctx->rx_status = I2_TRANSFER_WAIT;
+#if defined ( ENABLE_RTOS_AWARE_HAL )
+  /* Drop stale signal left from a previous call */
+  xSemaphoreTake(ctx->sem_rx, (TickType_t)0);
+#endif /* ENABLE_RTOS_AWARE_HAL */
+
   /* If the FIFO is empty, wait for signal */
   if ( !i2_fifo_count(&ctx->rx_fifo, false) ) {
-      ctx->rx_status = I2_TRANSFER_WAIT;
- #if defined ( ENABLE_RTOS_AWARE_HAL)
+#if defined ( ENABLE_RTOS_AWARE_HAL )
       if (xSemaphoreTake(ctx->sem_rx, (TickType_t)timeout) == pdFALSE) {
         err = I2_TIMEOUT;
       }
@@ -1186,6 +1691,13 @@ i2_error i2_uart_rx(i2_uart_inst_t *inst, uint8_t *rxbuf, int32_t size,
       while (ctx->rx_status == I2_TRANSFER_WAIT);
 #endif
   }
+  ctx->rx_status = I2_TRANSFER_DONE;
+
+  /* Reader fell behind by more than a full FIFO, DMA has overwritten the
+   * oldest data, resume from the oldest byte still in buffer */
+  if ( i2_fifo_count(&ctx->rx_fifo, false) > I2_UART_FIFO_SIZE ) {
+    ctx->rx_fifo.rd_index = ctx->rx_fifo.wr_index - I2_UART_FIFO_SIZE;
+  }
 
   /* RX ISR says the FIFO is at least half full or rx line is idle */
   if ( err != I2_TIMEOUT ) {
@@ -1238,7 +1750,7 @@ i2_error i2_uart_rx_polling(i2_uart_inst_t *inst, uint8_t *rxbuf, int32_t size,
     return I2_INVALID_PARAM;
   }
 
-  ctx = uart_get_ctx_from_name(inst->ctx_name);
+  ctx = uart_get_ctx_from_inst(inst);
   if ( !ctx ) {
     return I2_INVALID_PARAM;
   }
@@ -1288,9 +1800,9 @@ i2_error i2_uart_rx_polling(i2_uart_inst_t *inst, uint8_t *rxbuf, int32_t size,
  */
 void USART1_IRQHandler(void)
 {
-  HAL_UART_IRQHandler(usart1);
+  uart_irq_handler(usart1);
 }
-#if ( UART1_DMA_ENABLE == I2_ENABLE )
+#if ( UART1_RX_DMA_ENABLE == I2_ENABLE )
 /**
  * @brief   UART1 DMA receive interrupt Handler.
  * @details DMA receive interrupt handler for UART1.
@@ -1301,7 +1813,9 @@ void UART1_DMA_RX_IRQHandler(void)
 {
   HAL_DMA_IRQHandler(usart1->hdmarx);
 }
+#endif /* UART1_RX_DMA_ENABLE */
 
+#if ( UART1_TX_DMA_ENABLE == I2_ENABLE )
 /**
  * @brief   UART1 DMA transmit interrupt Handler.
  * @details DMA transmit interrupt handler for UART1.
@@ -1312,7 +1826,7 @@ void UART1_DMA_TX_IRQHandler(void)
 {
   HAL_DMA_IRQHandler(usart1->hdmatx);
 }
-#endif /* UART1_DMA_ENABLE */
+#endif /* UART1_TX_DMA_ENABLE */
 #endif /* I2_ENABLE_UART1_CONTEXT */
 
 #if defined ( I2_ENABLE_UART2_CONTEXT )
@@ -1324,9 +1838,9 @@ void UART1_DMA_TX_IRQHandler(void)
  */
 void USART2_IRQHandler(void)
 {
-  HAL_UART_IRQHandler(usart2);
+  uart_irq_handler(usart2);
 }
-#if ( UART2_DMA_ENABLE == I2_ENABLE )
+#if ( UART2_RX_DMA_ENABLE == I2_ENABLE )
 /**
  * @brief   UART2 DMA receive interrupt Handler.
  * @details DMA receive interrupt handler for UART2.
@@ -1337,7 +1851,9 @@ void UART2_DMA_RX_IRQHandler(void)
 {
   HAL_DMA_IRQHandler(usart2->hdmarx);
 }
+#endif /* UART2_RX_DMA_ENABLE */
 
+#if ( UART2_TX_DMA_ENABLE == I2_ENABLE )
 /**
  * @brief   UART2 DMA transmit interrupt Handler.
  * @details DMA transmit interrupt handler for UART2.
@@ -1348,7 +1864,7 @@ void UART2_DMA_TX_IRQHandler(void)
 {
   HAL_DMA_IRQHandler(usart2->hdmatx);
 }
-#endif /* UART2_DMA_ENABLE */
+#endif /* UART2_TX_DMA_ENABLE */
 #endif /* I2_ENABLE_UART2_CONTEXT */
 
 #if defined ( I2_ENABLE_UART3_CONTEXT )
@@ -1360,9 +1876,9 @@ void UART2_DMA_TX_IRQHandler(void)
  */
 void USART3_IRQHandler(void)
 {
-  HAL_UART_IRQHandler(usart3);
+  uart_irq_handler(usart3);
 }
-#if ( UART3_DMA_ENABLE == I2_ENABLE )
+#if ( UART3_RX_DMA_ENABLE == I2_ENABLE )
 /**
  * @brief   UART3 DMA receive interrupt Handler.
  * @details DMA receive interrupt handler for UART3.
@@ -1373,7 +1889,9 @@ void UART3_DMA_RX_IRQHandler(void)
 {
   HAL_DMA_IRQHandler(usart3->hdmarx);
 }
+#endif /* UART3_RX_DMA_ENABLE */
 
+#if ( UART3_TX_DMA_ENABLE == I2_ENABLE )
 /**
  * @brief   UART3 DMA transmit interrupt Handler.
  * @details DMA transmit interrupt handler for UART3.
@@ -1384,7 +1902,7 @@ void UART3_DMA_TX_IRQHandler(void)
 {
   HAL_DMA_IRQHandler(usart3->hdmatx);
 }
-#endif /* UART3_DMA_ENABLE */
+#endif /* UART3_TX_DMA_ENABLE */
 #endif /* I2_ENABLE_UART3_CONTEXT */
 
 #if defined ( I2_ENABLE_UART4_CONTEXT )
@@ -1396,9 +1914,9 @@ void UART3_DMA_TX_IRQHandler(void)
  */
 void UART4_IRQHandler(void)
 {
-  HAL_UART_IRQHandler(uart4);
+  uart_irq_handler(uart4);
 }
-#if ( UART4_DMA_ENABLE == I2_ENABLE )
+#if ( UART4_RX_DMA_ENABLE == I2_ENABLE )
 /**
  * @brief   UART4 DMA receive interrupt Handler.
  * @details DMA receive interrupt handler for UART4.
@@ -1409,7 +1927,9 @@ void UART4_DMA_RX_IRQHandler(void)
 {
   HAL_DMA_IRQHandler(uart4->hdmarx);
 }
+#endif /* UART4_RX_DMA_ENABLE */
 
+#if ( UART4_TX_DMA_ENABLE == I2_ENABLE )
 /**
  * @brief   UART4 DMA transmit interrupt Handler.
  * @details DMA transmit interrupt handler for UART4.
@@ -1420,7 +1940,7 @@ void UART4_DMA_TX_IRQHandler(void)
 {
   HAL_DMA_IRQHandler(uart4->hdmatx);
 }
-#endif /* UART4_DMA_ENABLE */
+#endif /* UART4_TX_DMA_ENABLE */
 #endif /* I2_ENABLE_UART4_CONTEXT */
 
 #if defined ( I2_ENABLE_UART5_CONTEXT )
@@ -1432,9 +1952,9 @@ void UART4_DMA_TX_IRQHandler(void)
  */
 void UART5_IRQHandler(void)
 {
-  HAL_UART_IRQHandler(uart5);
+  uart_irq_handler(uart5);
 }
-#if ( UART5_DMA_ENABLE == I2_ENABLE )
+#if ( UART5_RX_DMA_ENABLE == I2_ENABLE )
 /**
  * @brief   UART5 DMA receive interrupt Handler.
  * @details DMA receive interrupt handler for UART5.
@@ -1445,7 +1965,9 @@ void UART5_DMA_RX_IRQHandler(void)
 {
   HAL_DMA_IRQHandler(uart5->hdmarx);
 }
+#endif /* UART5_RX_DMA_ENABLE */
 
+#if ( UART5_TX_DMA_ENABLE == I2_ENABLE )
 /**
  * @brief   UART5 DMA transmit interrupt Handler.
  * @details DMA transmit interrupt handler for UART5.
@@ -1456,7 +1978,7 @@ void UART5_DMA_TX_IRQHandler(void)
 {
   HAL_DMA_IRQHandler(uart5->hdmatx);
 }
-#endif /* UART5_DMA_ENABLE */
+#endif /* UART5_TX_DMA_ENABLE */
 #endif /* I2_ENABLE_UART5_CONTEXT */
 
 #if defined ( I2_ENABLE_UART6_CONTEXT )
@@ -1468,9 +1990,9 @@ void UART5_DMA_TX_IRQHandler(void)
  */
 void USART6_IRQHandler(void)
 {
-  HAL_UART_IRQHandler(usart6);
+  uart_irq_handler(usart6);
 }
-#if ( UART6_DMA_ENABLE == I2_ENABLE )
+#if ( UART6_RX_DMA_ENABLE == I2_ENABLE )
 /**
  * @brief   UART6 DMA receive interrupt Handler.
  * @details DMA receive interrupt handler for UART6.
@@ -1481,7 +2003,9 @@ void UART6_DMA_RX_IRQHandler(void)
 {
   HAL_DMA_IRQHandler(usart6->hdmarx);
 }
+#endif /* UART6_RX_DMA_ENABLE */
 
+#if ( UART6_TX_DMA_ENABLE == I2_ENABLE )
 /**
  * @brief   UART6 DMA transmit interrupt Handler.
  * @details DMA transmit interrupt handler for UART6.
@@ -1492,163 +2016,88 @@ void UART6_DMA_TX_IRQHandler(void)
 {
   HAL_DMA_IRQHandler(usart6->hdmatx);
 }
-#endif /* UART6_DMA_ENABLE */
+#endif /* UART6_TX_DMA_ENABLE */
 #endif /* I2_ENABLE_UART6_CONTEXT */
 
-#if 0
 /**
- * @brief   UART receive interrupt.
- * @details Genaric interrupt for UART receive.
+ * @brief   UART DMA receive half compete callback.
+ * @details System callback for DMA reception half completion.
  *
  * @param[in] *huart      UART handler.
  * @return  None.
  */
-void UART_Receive_IT(UART_HandleTypeDef *huart)
+void HAL_UART_RxHalfCpltCallback(UART_HandleTypeDef *huart)
 {
-#if defined ( ENABLE_RTOS_AWARE_HAL )
-  static BaseType_t xHigherPriorityTaskWoken;
-#endif /* ENABLE_RTOS_AWARE_HAL */
-  uint16_t uhdata;
   i2_uart_ctx_t *ctx = uart_get_ctx_from_handle(huart);
-  int32_t count;
 
-  /* Check that a Rx process is ongoing */
-  if (huart->RxState == HAL_UART_STATE_BUSY_RX) {
-    /* Reading RDR will clear the RXNE */
-    uhdata = (uint16_t)READ_REG(huart->Instance->DR);
-
-    if ( !ctx ) {
-      return;
-    }
-
-    /* Read the RX byte */
-    count = i2_fifo_write(&ctx->rx_fifo, (uint8_t) uhdata, true);
-
-    /* Signal uart_rx that the FIFO is at the trigger level */
-    if (count == ctx->rx_trigger_level) {
-#if defined ( ENABLE_RTOS_AWARE_HAL )
-      xSemaphoreGiveFromISR(ctx->sem_rx, &xHigherPriorityTaskWoken);
-      portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
-#endif /* ENABLE_RTOS_AWARE_HAL */
-      ctx->rx_status = I2_TRANSFER_DONE;
-    }
-
-    /* Update the water mark */
-    if (ctx->rx_water_mark < count) {
-      ctx->rx_water_mark = count;
-    }
-  } else {
-    /* Clear RXNE interrupt flag */
-    __HAL_UART_SEND_REQ(huart, UART_RXDATA_FLUSH_REQUEST);
+  if ( ctx && (ctx->rx_hal_mode == DMA_MODE) ) {
+    uart_rx_signal(ctx, uart_rx_dma_sync(ctx));
   }
-
-  return;
 }
 
 /**
- * @brief   UART idle interrupt.
- * @details Genaric interrupt for idle UART bus.
+ * @brief   UART DMA receive compete callback.
+ * @details System callback for DMA reception completion.
  *
  * @param[in] *huart      UART handler.
  * @return  None.
  */
-void UART_Idle_IT(UART_HandleTypeDef *huart)
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
 {
-#if defined ( ENABLE_RTOS_AWARE_HAL )
-    static BaseType_t xHigherPriorityTaskWoken;
-#endif /* ENABLE_RTOS_AWARE_HAL */
-    struct i2_uart_ctx_t *ctx = uart_get_ctx_from_handle(huart);
-
-    /* If RX line idle is detected, signal uart_rx */
-    __HAL_UART_CLEAR_IT(huart, UART_CLEAR_IDLEF);
-
-    if (!ctx)
-        return;
-
-    if (ctx->rx_hal_mode == DMA_MODE) {
-        ctx->rxfifo.wr_index = (I2_UART_FIFO_SIZE - ctx->hdma_rx.Instance->CNDTR);
-    }
-
-    if (fifo_count(&ctx->rxfifo, true)) {
-#if defined ( ENABLE_RTOS_AWARE_HAL )
-        xSemaphoreGiveFromISR(ctx->sem_rx, &xHigherPriorityTaskWoken);
-        portYIELD_FROM_ISR(xHigherPriorityTaskWoken)
-#endif /* ENABLE_RTOS_AWARE_HAL */
-        ctx->rx_status = I2_TRANSFER_DONE;
-    }
+  i2_uart_ctx_t *ctx = uart_get_ctx_from_handle(huart);
 
-    return;
+  if ( ctx && (ctx->rx_hal_mode == DMA_MODE) ) {
+    uart_rx_signal(ctx, uart_rx_dma_sync(ctx));
+  }
 }
-#endif /* 0 */
 
 /**
- * @brief   UART DMA receive half compete callback.
- * @details System callback for DMA reception half completion.
+ * @brief   UART DMA transmit compete callback.
+ * @details System callback for DMA transmission completion.
  *
  * @param[in] *huart      UART handler.
  * @return  None.
  */
-void HAL_UART_RxHalfCpltCallback(UART_HandleTypeDef *huart)
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
 {
 #if defined ( ENABLE_RTOS_AWARE_HAL )
-  BaseType_t xHigherPriorityTaskWoken;
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 #endif /* ENABLE_RTOS_AWARE_HAL */
   i2_uart_ctx_t *ctx = uart_get_ctx_from_handle(huart);
 
-  if ( ctx ) {
-#if defined ( ENABLE_RTOS_AWARE_HAL )
-    xSemaphoreGiveFromISR(ctx->sem_rx, &xHigherPriorityTaskWoken);
-    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
-#endif /* ENABLE_RTOS_AWARE_HAL */
-    ctx->rx_status = I2_TRANSFER_DONE;
-    ctx->rx_fifo.wr_index = (I2_UART_FIFO_SIZE - ctx->hdma_rx.Instance->NDTR);
+  if ( !ctx ) {
+    return;
   }
-}
 
-/**
- * @brief   UART DMA receive compete callback.
- * @details System callback for DMA reception completion.
- *
- * @param[in] *huart      UART handler.
- * @return  None.
- */
-void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
-{
-#if defined ( ENABLE_RTOS_AWARE_HAL )
-  static BaseType_t xHigherPriorityTaskWoken;
-#endif /* ENABLE_RTOS_AWARE_HAL */
-  i2_uart_ctx_t *ctx = uart_get_ctx_from_handle(huart);
+  /* Chain next queued descriptor straight away */
+  if ( ctx->tx_async ) {
+    uart_tx_async_done(ctx, I2_SUCCESS);
+    uart_tx_async_next(ctx);
+    return;
+  }
 
-  if (ctx) {
+  ctx->tx_status = I2_TRANSFER_DONE;
 #if defined ( ENABLE_RTOS_AWARE_HAL )
-    xSemaphoreGiveFromISR(ctx->sem_rx, &xHigherPriorityTaskWoken);
-    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+  xSemaphoreGiveFromISR(ctx->sem_tx, &xHigherPriorityTaskWoken);
+  portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 #endif /* ENABLE_RTOS_AWARE_HAL */
-    ctx->rx_status = I2_TRANSFER_DONE;
-    ctx->rx_fifo.wr_index = (I2_UART_FIFO_SIZE - ctx->hdma_rx.Instance->NDTR);
-  }
 }
 
 /**
- * @brief   UART DMA transmit compete callback.
- * @details System callback for DMA transmission completion.
+ * @brief   UART error callback.
+ * @details System callback for UART errors, an aborted async TX descriptor
+ *          is reported as failed so the queue keeps moving.
  *
  * @param[in] *huart      UART handler.
  * @return  None.
  */
-void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
 {
-#if defined ( ENABLE_RTOS_AWARE_HAL )
-  static BaseType_t xHigherPriorityTaskWoken;
-#endif /* ENABLE_RTOS_AWARE_HAL */
   i2_uart_ctx_t *ctx = uart_get_ctx_from_handle(huart);
 
-  if (ctx) {
-#if defined ( ENABLE_RTOS_AWARE_HAL )
-    xSemaphoreGiveFromISR(ctx->sem_tx, &xHigherPriorityTaskWoken);
-    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
-#endif /* ENABLE_RTOS_AWARE_HAL */
-    ctx->tx_status = I2_TRANSFER_DONE;
+  if ( ctx && ctx->tx_async && (huart->gState == HAL_UART_STATE_READY) ) {
+    uart_tx_async_done(ctx, I2_FAILURE);
+    uart_tx_async_next(ctx);
   }
 }
 
@@ -1675,7 +2124,7 @@ i2_error i2_uart_rx_trigger_level_set(i2_uart_inst_t *inst,
     return I2_INVALID_PARAM;
   }
 
-  ctx = uart_get_ctx_from_name(inst->ctx_name);
+  ctx = uart_get_ctx_from_inst(inst);
   if ( !ctx ) {
     return I2_INVALID_PARAM;
   }
@@ -1706,7 +2155,7 @@ i2_error i2_uart_rx_trigger_level_get(i2_uart_inst_t *inst,
     return I2_INVALID_PARAM;
   }
 
-  ctx = uart_get_ctx_from_name(inst->ctx_name);
+  ctx = uart_get_ctx_from_inst(inst);
   if ( !ctx ) {
     return I2_INVALID_PARAM;
   }
@@ -1735,7 +2184,7 @@ i2_error i2_uart_rx_water_mark_get(i2_uart_inst_t *inst, int32_t *rx_water_mark)
     return I2_INVALID_PARAM;
   }
 
-  ctx = uart_get_ctx_from_name(inst->ctx_name);
+  ctx = uart_get_ctx_from_inst(inst);
   if ( !ctx ) {
     return I2_INVALID_PARAM;
   }
@@ -1764,7 +2213,7 @@ i2_error i2_uart_rx_byte_count_get(i2_uart_inst_t *inst, int32_t *count)
     return I2_INVALID_PARAM;
   }
 
-  ctx = uart_get_ctx_from_name(inst->ctx_name);
+  ctx = uart_get_ctx_from_inst(inst);
   if ( !ctx ) {
     return I2_INVALID_PARAM;
   }
@@ -1791,7 +2240,7 @@ i2_error i2_uart_rx_fifo_size_get(i2_uart_inst_t *inst, int32_t *size)
     return I2_INVALID_PARAM;
   }
 
-  ctx = uart_get_ctx_from_name(inst->ctx_name);
+  ctx = uart_get_ctx_from_inst(inst);
   if ( !ctx ) {
     return I2_INVALID_PARAM;
   }
@@ -1819,7 +2268,7 @@ i2_error i2_uart_baud_rate_set(i2_uart_inst_t *inst, int32_t baud_rate)
     return I2_INVALID_PARAM;
   }
 
-  ctx = uart_get_ctx_from_name(inst->ctx_name);
+  ctx = uart_get_ctx_from_inst(inst);
   if ( !ctx ) {
     return I2_INVALID_PARAM;
   }
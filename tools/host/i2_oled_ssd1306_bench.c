@@ -0,0 +1,274 @@
+/**
+ * @author      iota square [i2]
+ * <pre>
+ * ██╗ ██████╗ ████████╗ █████╗ ██████╗
+ * ██║██╔═══██╗╚══██╔══╝██╔══██╗╚════██╗
+ * ██║██║   ██║   ██║   ███████║ █████╔╝
+ * ██║██║   ██║   ██║   ██╔══██║██╔═══╝
+ * ██║╚██████╔╝   ██║   ██║  ██║███████╗
+ * ╚═╝ ╚═════╝    ╚═╝   ╚═╝  ╚═╝╚══════╝
+ * </pre>
+ *
+ * @date        17-10-2026
+ * @file        i2_oled_ssd1306_bench.c
+ * @brief       Host benchmark of SSD1306 OLED drawing calls.
+ *
+ * @copyright   GNU GPU v3
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * Free Software, Hell Yeah!
+ *
+ **/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "i2_oled_ssd1306.h"
+#include "i2_oled_ssd1306_emu.h"
+#include "i2_oled_widget.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define BENCH_CALLS           ( 256 )   /**< Drawing calls per case   */
+#define BENCH_PATH_LEN        ( 256 )   /**< Max length of PBM path   */
+
+/* Private types -------------------------------------------------------------*/
+/** @brief Benchmark case, draws call (n) of case */
+typedef struct {
+  const char  *name;              /**< Case name, also PBM file name  */
+  void        (*draw)(uint32_t n); /**< Drawing call                  */
+} bench_case_t;
+
+/* Private variables ---------------------------------------------------------*/
+/** @brief Checks failed */
+static int32_t failures;
+/** @brief 16x16 test bitmap, rows of bytes */
+static uint8_t bench_bitmap[32] = {
+  0x07, 0xE0, 0x18, 0x18, 0x20, 0x04, 0x40, 0x02,
+  0x4C, 0x32, 0x8C, 0x31, 0x80, 0x01, 0x80, 0x01,
+  0x80, 0x01, 0x88, 0x11, 0x84, 0x21, 0x43, 0xC2,
+  0x40, 0x02, 0x20, 0x04, 0x18, 0x18, 0x07, 0xE0,
+};
+/** @brief Widget screen of widget case */
+static i2_widget_screen_t bench_screen;
+/** @brief Widgets of widget case */
+static i2_widget_t bench_label, bench_value, bench_bar;
+/** @brief Label texts of widget case */
+static const char *bench_labels[] = { "idle", "busy" };
+
+/* Private functions ---------------------------------------------------------*/
+/** @brief Single pixel, inverted so every call changes display */
+static void bench_pixel(uint32_t n)
+{
+  ssd1306_draw_pixel(n % SSD1306_DISPLAY_HEIGHT, (n * 7) % SSD1306_DISPLAY_WIDTH,
+                     SSD1306_INVERSE, SSD1306_LAYER1);
+}
+
+/** @brief Line across display */
+static void bench_line(uint32_t n)
+{
+  ssd1306_draw_line(0, n % SSD1306_DISPLAY_WIDTH, SSD1306_DISPLAY_HEIGHT - 1,
+                    SSD1306_DISPLAY_WIDTH - 1 - (n % SSD1306_DISPLAY_WIDTH),
+                    SSD1306_INVERSE, SSD1306_LAYER1);
+}
+
+/** @brief 24x32 filled rectangle */
+static void bench_rect_fill(uint32_t n)
+{
+  ssd1306_fill_rectangle(n % 40, (n * 5) % 96, 24, 32,
+                         SSD1306_INVERSE, SSD1306_LAYER1);
+}
+
+/** @brief Circle outline of radius 12 */
+static void bench_circle(uint32_t n)
+{
+  ssd1306_draw_circle(16 + (n % 32), 16 + ((n * 3) % 96), 12,
+                      SSD1306_INVERSE, SSD1306_LAYER1);
+}
+
+/** @brief 10 character text run */
+static void bench_text_run(uint32_t n)
+{
+  char text[11];
+
+  snprintf(text, sizeof(text), "run %6u", (unsigned)n);
+  ssd1306_draw_text_run((n % 7) * 8, 4, text, 1, SSD1306_WHITE, SSD1306_LAYER1);
+}
+
+/** @brief 16x16 bitmap */
+static void bench_bitmap_draw(uint32_t n)
+{
+  ssd1306_draw_bitmap(n % 48, (n * 11) % 112, bench_bitmap, 16, 16,
+                      SSD1306_INVERSE, SSD1306_LAYER1);
+}
+
+/** @brief Widget screen update, value changes every call, label every 16 */
+static void bench_widget(uint32_t n)
+{
+  i2_widget_label_set(&bench_label, bench_labels[(n / 16) & 1]);
+  i2_widget_value_set(&bench_value, (int32_t)(n * 37) % 1000);
+  i2_widget_bar_set(&bench_bar, (int32_t)(n % 100));
+  i2_widget_update(&bench_screen);
+}
+
+/** @brief Benchmark cases */
+static const bench_case_t bench_cases[] = {
+  { "pixel",      bench_pixel },
+  { "line",       bench_line },
+  { "rect_fill",  bench_rect_fill },
+  { "circle",     bench_circle },
+  { "text_run",   bench_text_run },
+  { "bitmap",     bench_bitmap_draw },
+  { "widget",     bench_widget },
+};
+
+/**
+ * @brief   Changed pixels.
+ * @details Counts GDDRAM pixels differing from a previous copy.
+ *
+ * @param[in] prev    Previous GDDRAM contents.
+ * @return  Number of changed pixels.
+ */
+static uint32_t bench_changed(const uint8_t *prev)
+{
+  const uint8_t *gddram = ssd1306_emu_gddram();
+  uint32_t changed = 0;
+  uint32_t i;
+
+  for (i = 0; i < SSD1306_DISPLAY_PAGES * SSD1306_DISPLAY_WIDTH; i++) {
+    changed += __builtin_popcount(gddram[i] ^ prev[i]);
+  }
+
+  return changed;
+}
+
+/**
+ * @brief   Frame check.
+ * @details Checks that emulated GDDRAM holds frame buffer of driver.
+ *
+ * @return  Number of mismatching pixels.
+ */
+static uint32_t bench_mismatch(void)
+{
+  const uint8_t *gddram = ssd1306_emu_gddram();
+  uint32_t mismatch = 0;
+  int16_t x, y;
+  uint8_t lit;
+
+  for (y = 0; y < SSD1306_DISPLAY_HEIGHT; y++) {
+    for (x = 0; x < SSD1306_DISPLAY_WIDTH; x++) {
+      lit = (gddram[(y / 8) * SSD1306_DISPLAY_WIDTH + x] >> (y & 7)) & 0x1;
+      if (lit != ssd1306_get_pixel(y, x)) {
+        mismatch++;
+      }
+    }
+  }
+
+  return mismatch;
+}
+
+/**
+ * @brief   Runs benchmark case.
+ * @details Every drawing call is followed by a refresh, changed pixels and
+ *          bytes sent to display are summed over all calls.
+ *
+ * @param[in] bench   Benchmark case.
+ * @param[in] out     Directory for PBM of final frame.
+ * @return  None.
+ */
+static void bench_run(const bench_case_t *bench, const char *out)
+{
+  uint8_t prev[SSD1306_DISPLAY_PAGES * SSD1306_DISPLAY_WIDTH];
+  char path[BENCH_PATH_LEN];
+  ssd1306_emu_stats_t stats;
+  struct timespec start, end;
+  uint64_t pixels = 0;
+  double us;
+  uint32_t n;
+
+  ssd1306_clear_screen(SSD1306_LAYER1);
+  ssd1306_refresh();
+  ssd1306_emu_stats_reset();
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (n = 0; n < BENCH_CALLS; n++) {
+    memcpy(prev, ssd1306_emu_gddram(), sizeof(prev));
+    bench->draw(n);
+    ssd1306_refresh();
+    pixels += bench_changed(prev);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  ssd1306_emu_stats_get(&stats);
+
+  us = (end.tv_sec - start.tv_sec) * 1e6 + (end.tv_nsec - start.tv_nsec) / 1e3;
+  printf("%-10s %10.1f %10.1f %10.1f %10.1f %10.2f\n", bench->name,
+         (double)pixels / BENCH_CALLS,
+         (double)(stats.cmd_bytes + stats.data_bytes) / BENCH_CALLS,
+         (double)stats.data_bytes / BENCH_CALLS,
+         (double)stats.cmd_writes / BENCH_CALLS, us / BENCH_CALLS);
+
+  if (bench_mismatch() != 0) {
+    printf("%s: display does not match frame buffer\n", bench->name);
+    failures++;
+  }
+
+  snprintf(path, sizeof(path), "%s/ssd1306_%s.pbm", out, bench->name);
+  if (ssd1306_emu_write_pbm(path) != I2_SUCCESS) {
+    printf("%s: cannot write %s\n", bench->name, path);
+    failures++;
+  }
+}
+
+/* Public functions ----------------------------------------------------------*/
+/**
+ * @brief   Host assert.
+ * @details Driver asserts abort benchmark.
+ *
+ * @param[in] good : parameter to check.
+ * @return  None.
+ */
+void i2_assert(int32_t good)
+{
+  if (!good) {
+    abort();
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  const char *out = (argc > 1) ? argv[1] : ".";
+  uint32_t i;
+
+  ssd1306_set_backend(&ssd1306_emu_backend);
+  ssd1306_init(SSD1306_CMD_SWITCH_CAP_VCC);
+
+  i2_widget_label_init(&bench_label, 0, 0, 1, bench_labels[0]);
+  i2_widget_value_init(&bench_value, 16, 0, 2, 4, "mV");
+  i2_widget_bar_init(&bench_bar, 48, 0, 8, 128, 0, 100);
+  i2_widget_add(&bench_screen, &bench_label);
+  i2_widget_add(&bench_screen, &bench_value);
+  i2_widget_add(&bench_screen, &bench_bar);
+
+  printf("%-10s %10s %10s %10s %10s %10s\n", "case", "pixels",
+         "bytes", "data", "writes", "us");
+  for (i = 0; i < sizeof(bench_cases) / sizeof(bench_cases[0]); i++) {
+    bench_run(&bench_cases[i], out);
+  }
+
+  printf("ssd1306 bench: %s, %d failures\n", failures ? "FAIL" : "PASS",
+         (int)failures);
+
+  return failures ? 1 : 0;
+}
+
+/************************ (C) COPYRIGHT iota2 ***[i2]*****END OF FILE**********/
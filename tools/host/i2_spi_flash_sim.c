@@ -0,0 +1,454 @@
+/**
+ * @author      iota square [i2]
+ * <pre>
+ * ██╗ ██████╗ ████████╗ █████╗ ██████╗
+ * ██║██╔═══██╗╚══██╔══╝██╔══██╗╚════██╗
+ * ██║██║   ██║   ██║   ███████║ █████╔╝
+ * ██║██║   ██║   ██║   ██╔══██║██╔═══╝
+ * ██║╚██████╔╝   ██║   ██║  ██║███████╗
+ * ╚═╝ ╚═════╝    ╚═╝   ╚═╝  ╚═╝╚══════╝
+ * </pre>
+ *
+ * @date        17-10-2026
+ * @file        i2_spi_flash_sim.c
+ * @brief       Host simulated SPI NOR flash.
+ *
+ * @copyright   GNU GPU v3
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * Free Software, Hell Yeah!
+ *
+ **/
+
+/* Includes ------------------------------------------------------------------*/
+#include "i2_spi_flash_sim.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "i2_stm32f4xx_hal_spi.h"
+
+/* Private defines -----------------------------------------------------------*/
+/**
+ * @defgroup SPI_FLASH_SIM_CMD Simulated flash instructions.
+ * JEDEC instructions decoded by simulated flash, erase instructions come
+ * from configuration.
+ *
+ * @{
+ */
+#define SIM_CMD_WRITE_ENABLE          ( 0x06 )  /**< Set write enable latch   */
+#define SIM_CMD_READ_STATUS           ( 0x05 )  /**< Read status register     */
+#define SIM_CMD_READ_JEDEC_ID         ( 0x9F )  /**< Read JEDEC ID            */
+#define SIM_CMD_READ_SFDP             ( 0x5A )  /**< Read SFDP tables         */
+#define SIM_CMD_FAST_READ             ( 0x0B )  /**< Read with dummy cycles   */
+#define SIM_CMD_PAGE_PROGRAM          ( 0x02 )  /**< Program up to one page   */
+#define SIM_CMD_SUSPEND               ( 0x75 )  /**< Suspend erase / program  */
+#define SIM_CMD_RESUME                ( 0x7A )  /**< Resume erase / program   */
+#define SIM_CMD_ENTER_4B_ADDR         ( 0xB7 )  /**< Enter 4 byte addressing  */
+/** @} */ /* SPI_FLASH_SIM_CMD */
+
+#define SIM_SR_WIP                    ( 0x01 )  /**< Write in progress        */
+#define SIM_SR_WEL                    ( 0x02 )  /**< Write enable latch       */
+#define SIM_SFDP_SIZE                 ( 0x70 )  /**< SFDP space answered      */
+#define SIM_SFDP_BFPT                 ( 0x30 )  /**< BFPT table address       */
+#define SIM_SFDP_BFPT_DWORDS          ( 16 )    /**< BFPT length              */
+#define SIM_MAX_PAGE_SIZE             ( 4096 )  /**< Page latch size          */
+
+/* Private variables ---------------------------------------------------------*/
+/** @brief Simulated flash configuration */
+static i2_spi_flash_sim_cfg_t sim_cfg;
+/** @brief Simulated flash statistics */
+static i2_spi_flash_sim_stats_t sim_stats;
+/** @brief Simulated flash array */
+static uint8_t *sim_mem;
+/** @brief Simulated SFDP address space */
+static uint8_t sim_sfdp[SIM_SFDP_SIZE];
+/** @brief Page program latch */
+static uint8_t sim_page[SIM_MAX_PAGE_SIZE];
+
+/** @brief Instruction decoder state, valid while CS is asserted */
+static struct {
+  uint8_t       opcode;         /**< Current instruction                */
+  uint32_t      pos;            /**< Bytes clocked under CS             */
+  uint32_t      addr;           /**< Address of instruction             */
+  uint32_t      count;          /**< Data bytes of instruction          */
+  bool          ignored;        /**< Instruction rejected               */
+} sim_cmd;
+
+static uint8_t  sim_addr_len;   /**< Current address bytes, 3 or 4      */
+static uint32_t sim_busy;       /**< Status reads left with WIP set     */
+static bool     sim_wel;        /**< Write enable latch                 */
+static uint32_t sim_tick;       /**< Simulated millisecond tick         */
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief   Little endian DWORD store.
+ * @details Puts a DWORD in SFDP table bytes.
+ *
+ * @param[in] addr        SFDP address.
+ * @param[in] dw          DWORD value.
+ * @return  None.
+ */
+static void sim_sfdp_dword(uint32_t addr, uint32_t dw)
+{
+  sim_sfdp[addr + 0] = (uint8_t)dw;
+  sim_sfdp[addr + 1] = (uint8_t)(dw >> 8);
+  sim_sfdp[addr + 2] = (uint8_t)(dw >> 16);
+  sim_sfdp[addr + 3] = (uint8_t)(dw >> 24);
+}
+
+/**
+ * @brief   SFDP build.
+ * @details Builds SFDP header, one parameter header and a JESD216B Basic
+ *          Flash Parameter Table from configuration.
+ *
+ * @return  None.
+ */
+static void sim_sfdp_build(void)
+{
+  uint32_t bfpt = SIM_SFDP_BFPT;
+  uint32_t bits = 0;
+  int32_t i;
+
+  memset(sim_sfdp, 0xFF, sizeof(sim_sfdp));
+  sim_sfdp_dword(0x00, 0x50444653);           /* "SFDP" */
+  sim_sfdp_dword(0x04, 0xFF000106);           /* Rev 1.6, 1 header */
+  sim_sfdp_dword(0x08, (SIM_SFDP_BFPT_DWORDS << 24) | 0x0106 << 8);
+  sim_sfdp_dword(0x0C, 0xFF000000 | bfpt);    /* BFPT, ID MSB 0xFF */
+
+  memset(&sim_sfdp[bfpt], 0, SIM_SFDP_BFPT_DWORDS * 4);
+  /* DWORD 1: 3 or 4 byte address */
+  sim_sfdp_dword(bfpt + 0, sim_cfg.addr_4b ? (1UL << 17) : 0);
+  /* DWORD 2: density */
+  while ( (1ULL << bits) < ((uint64_t)sim_cfg.size * 8) ) {
+    bits++;
+  }
+  if ( bits > 31 ) {
+    sim_sfdp_dword(bfpt + 4, (1UL << 31) | bits);
+  } else {
+    sim_sfdp_dword(bfpt + 4, (uint32_t)(((uint64_t)sim_cfg.size * 8) - 1));
+  }
+  /* DWORD 8 and 9: erase types */
+  for (i = 0; i < I2_SPI_FLASH_SIM_ERASE_TYPES; i++) {
+    uint32_t addr = bfpt + 28 + ((i / 2) * 4);
+    uint32_t dw = sim_sfdp[addr] | (sim_sfdp[addr + 1] << 8) |
+                  (sim_sfdp[addr + 2] << 16) | ((uint32_t)sim_sfdp[addr + 3] << 24);
+
+    dw |= (uint32_t)(sim_cfg.erase[i].exp |
+                     (sim_cfg.erase[i].opcode << 8)) << (16 * (i % 2));
+    sim_sfdp_dword(addr, dw);
+  }
+  /* DWORD 11: page size */
+  for (bits = 0; (1UL << bits) < sim_cfg.page_size; bits++) {
+  }
+  sim_sfdp_dword(bfpt + 40, bits << 4);
+  /* DWORD 12 and 13: suspend supported */
+  sim_sfdp_dword(bfpt + 48, ((uint32_t)SIM_CMD_SUSPEND << 24) |
+                            ((uint32_t)SIM_CMD_RESUME << 16));
+}
+
+/**
+ * @brief   Erase type lookup.
+ * @details Finds configured erase type of an opcode.
+ *
+ * @param[in] opcode      Instruction.
+ * @return  Erase type index, -1 if not an erase instruction.
+ */
+static int32_t sim_erase_type(uint8_t opcode)
+{
+  int32_t i;
+
+  for (i = 0; i < I2_SPI_FLASH_SIM_ERASE_TYPES; i++) {
+    if ( sim_cfg.erase[i].exp && (sim_cfg.erase[i].opcode == opcode) ) {
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+/**
+ * @brief   Address bytes.
+ * @details Address length of an instruction.
+ *
+ * @param[in] opcode      Instruction.
+ * @return  Address bytes, 0 if instruction has no address.
+ */
+static uint32_t sim_addr_bytes(uint8_t opcode)
+{
+  if ( opcode == SIM_CMD_READ_SFDP ) {
+    return 3;
+  }
+  if ( (opcode == SIM_CMD_FAST_READ) || (opcode == SIM_CMD_PAGE_PROGRAM) ||
+       (sim_erase_type(opcode) >= 0) ) {
+    return sim_addr_len;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief   Byte exchange.
+ * @details Clocks one byte through instruction decoder.
+ *
+ * @param[in] tx          Byte sent by host.
+ * @return  Byte returned by flash.
+ */
+static uint8_t sim_byte(uint8_t tx)
+{
+  uint32_t alen, data;
+  uint8_t rx = 0xFF;
+
+  if ( sim_cmd.pos++ == 0 ) {
+    sim_cmd.opcode = tx;
+    if ( sim_busy && (tx != SIM_CMD_READ_STATUS) && (tx != SIM_CMD_SUSPEND) ) {
+      sim_stats.while_busy++;
+      sim_cmd.ignored = true;
+    }
+    return rx;
+  }
+  if ( sim_cmd.ignored ) {
+    return rx;
+  }
+
+  alen = sim_addr_bytes(sim_cmd.opcode);
+  if ( sim_cmd.pos <= (alen + 1) ) {
+    sim_cmd.addr = (sim_cmd.addr << 8) | tx;
+    return rx;
+  }
+
+  switch ( sim_cmd.opcode ) {
+  case SIM_CMD_READ_STATUS:
+    rx = (sim_busy ? SIM_SR_WIP : 0) | (sim_wel ? SIM_SR_WEL : 0);
+    if ( sim_busy ) {
+      sim_busy--;
+    }
+    break;
+  case SIM_CMD_READ_JEDEC_ID:
+    data = sim_cmd.pos - 2;
+    rx = (data < 3) ? sim_cfg.jedec_id[data] : 0xFF;
+    break;
+  case SIM_CMD_READ_SFDP:
+    /* One dummy byte */
+    if ( sim_cmd.pos > (alen + 2) ) {
+      data = sim_cmd.addr + sim_cmd.count++;
+      rx = (sim_cfg.sfdp && (data < SIM_SFDP_SIZE)) ? sim_sfdp[data] : 0xFF;
+    }
+    break;
+  case SIM_CMD_FAST_READ:
+    if ( sim_cmd.pos > (alen + 2) ) {
+      rx = sim_mem[(sim_cmd.addr + sim_cmd.count++) & (sim_cfg.size - 1)];
+    }
+    break;
+  case SIM_CMD_PAGE_PROGRAM:
+    /* Page latch wraps around, as on real parts */
+    data = (sim_cmd.addr + sim_cmd.count++) & (sim_cfg.page_size - 1);
+    sim_page[data] &= tx;
+    break;
+  default:
+    break;
+  }
+
+  return rx;
+}
+
+/**
+ * @brief   Chip select assert.
+ * @details Starts a new instruction.
+ *
+ * @return  None.
+ */
+static void sim_cs_assert(void)
+{
+  memset(&sim_cmd, 0, sizeof(sim_cmd));
+  memset(sim_page, 0xFF, sizeof(sim_page));
+}
+
+/**
+ * @brief   Chip select deassert.
+ * @details Executes write enable, program and erase instructions, which
+ *          real parts start on CS rising edge.
+ *
+ * @return  None.
+ */
+static void sim_cs_deassert(void)
+{
+  uint32_t base, size, i;
+  int32_t type;
+
+  if ( !sim_cmd.pos || sim_cmd.ignored ) {
+    return;
+  }
+
+  switch ( sim_cmd.opcode ) {
+  case SIM_CMD_WRITE_ENABLE:
+    sim_wel = true;
+    return;
+  case SIM_CMD_ENTER_4B_ADDR:
+    sim_addr_len = 4;
+    return;
+  case SIM_CMD_READ_STATUS:
+  case SIM_CMD_READ_JEDEC_ID:
+  case SIM_CMD_READ_SFDP:
+  case SIM_CMD_FAST_READ:
+  case SIM_CMD_SUSPEND:
+  case SIM_CMD_RESUME:
+    return;
+  case SIM_CMD_PAGE_PROGRAM:
+    if ( !sim_wel ) {
+      sim_stats.no_wel++;
+      return;
+    }
+    sim_stats.programs++;
+    base = sim_cmd.addr & ~(sim_cfg.page_size - 1) & (sim_cfg.size - 1);
+    if ( ((sim_cmd.addr & (sim_cfg.page_size - 1)) + sim_cmd.count) >
+         sim_cfg.page_size ) {
+      sim_stats.page_cross++;
+    }
+    for (i = 0; i < sim_cfg.page_size; i++) {
+      sim_mem[base + i] &= sim_page[i];
+    }
+    break;
+  default:
+    type = sim_erase_type(sim_cmd.opcode);
+    if ( type < 0 ) {
+      sim_stats.unknown++;
+      return;
+    }
+    if ( !sim_wel ) {
+      sim_stats.no_wel++;
+      return;
+    }
+    sim_stats.erases[type]++;
+    size = 1UL << sim_cfg.erase[type].exp;
+    if ( sim_cmd.addr & (size - 1) ) {
+      sim_stats.misaligned++;
+    }
+    base = sim_cmd.addr & ~(size - 1) & (sim_cfg.size - 1);
+    memset(&sim_mem[base], 0xFF, size);
+    break;
+  }
+
+  sim_wel = false;
+  sim_busy = I2_SPI_FLASH_SIM_BUSY_POLLS;
+}
+
+/* Public functions ----------------------------------------------------------*/
+/**
+ * @brief   Simulated flash initialization.
+ * @details Powers up an erased flash with given geometry, and clears
+ *          statistics.
+ *
+ * @param[in] *cfg        Flash configuration.
+ * @return  None.
+ */
+void i2_spi_flash_sim_init(const i2_spi_flash_sim_cfg_t *cfg)
+{
+  sim_cfg = *cfg;
+  free(sim_mem);
+  sim_mem = malloc(sim_cfg.size);
+  memset(sim_mem, 0xFF, sim_cfg.size);
+  memset(&sim_stats, 0, sizeof(sim_stats));
+  sim_addr_len = 3;
+  sim_busy = 0;
+  sim_wel = false;
+  sim_sfdp_build();
+}
+
+/**
+ * @brief   Simulated flash array.
+ * @details Gives direct access to flash contents.
+ *
+ * @return  Flash array.
+ */
+uint8_t* i2_spi_flash_sim_mem(void)
+{
+  return sim_mem;
+}
+
+/**
+ * @brief   Simulated flash statistics.
+ * @details Gives access to instruction counters.
+ *
+ * @return  Statistics.
+ */
+i2_spi_flash_sim_stats_t* i2_spi_flash_sim_stats(void)
+{
+  return &sim_stats;
+}
+
+/**
+ * @brief   SPI transaction.
+ * @details Host replacement of SPI driver, runs segments through simulated
+ *          flash under one CS assertion.
+ *
+ * @param[in] *inst       SPI instance, unused.
+ * @param[in] *xfers      Transfer segments.
+ * @param[in] count       Number of segments.
+ * @param[in] timeout     Timeout, unused.
+ * @return  Execution error code @ref I2_ERROR.
+ */
+i2_error i2_spi_transaction(i2_spi_inst_t *inst, const i2_spi_xfer_t *xfers,
+                            int32_t count, uint32_t timeout)
+{
+  uint8_t rx;
+  int32_t i, j;
+
+  (void)inst;
+  (void)timeout;
+
+  sim_cs_assert();
+  for (i = 0; i < count; i++) {
+    for (j = 0; j < xfers[i].size; j++) {
+      rx = sim_byte(xfers[i].txbuf ? xfers[i].txbuf[j] : 0xFF);
+      if ( xfers[i].rxbuf ) {
+        xfers[i].rxbuf[j] = rx;
+      }
+    }
+  }
+  sim_cs_deassert();
+
+  return I2_SUCCESS;
+}
+
+/**
+ * @brief   SPI configuration.
+ * @details Host replacement of SPI driver, any configuration is accepted.
+ *
+ * @return  Execution error code @ref I2_ERROR.
+ */
+i2_error i2_spi_config_set(i2_spi_inst_t *inst, i2_spi_data_width_t data_width,
+                           i2_spi_clock_speed_t clk_speed, i2_spi_mode_t mode,
+                           i2_spi_first_bit_t first_bit)
+{
+  (void)inst;
+  (void)data_width;
+  (void)clk_speed;
+  (void)mode;
+  (void)first_bit;
+
+  return I2_SUCCESS;
+}
+
+/**
+ * @brief   HAL tick.
+ * @details Host replacement of HAL tick, advances on every call so busy
+ *          polling always terminates.
+ *
+ * @return  Tick in ms.
+ */
+uint32_t HAL_GetTick(void)
+{
+  return sim_tick++;
+}
+
+/************************ (C) COPYRIGHT iota2 ***[i2]*****END OF FILE**********/
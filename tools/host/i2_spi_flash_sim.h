@@ -0,0 +1,93 @@
+/**
+ * @author      iota square [i2]
+ * <pre>
+ * ██╗ ██████╗ ████████╗ █████╗ ██████╗
+ * ██║██╔═══██╗╚══██╔══╝██╔══██╗╚════██╗
+ * ██║██║   ██║   ██║   ███████║ █████╔╝
+ * ██║██║   ██║   ██║   ██╔══██║██╔═══╝
+ * ██║╚██████╔╝   ██║   ██║  ██║███████╗
+ * ╚═╝ ╚═════╝    ╚═╝   ╚═╝  ╚═╝╚══════╝
+ * </pre>
+ *
+ * @date        17-10-2026
+ * @file        i2_spi_flash_sim.h
+ * @brief       Host simulated SPI NOR flash.
+ *
+ * @copyright   GNU GPU v3
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * Free Software, Hell Yeah!
+ *
+ **/
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Public defines ------------------------------------------------------------*/
+/**
+ * @defgroup I2_SPI_FLASH_SIM_SPEC Simulated flash parameters.
+ * Limits of simulated SPI NOR flash.
+ *
+ * @{
+ */
+#define I2_SPI_FLASH_SIM_ERASE_TYPES  ( 4 )   /**< Erase types in SFDP      */
+#define I2_SPI_FLASH_SIM_BUSY_POLLS   ( 3 )   /**< Status reads with WIP set */
+/** @} */ /* I2_SPI_FLASH_SIM_SPEC */
+
+/**
+ * @defgroup i2_spi_flash_sim_cfg_t Simulated flash configuration.
+ * Geometry of simulated flash, also published in its SFDP tables.
+ *
+ * @{
+ */
+/** @brief Simulated flash configuration */
+typedef struct {
+  uint8_t       jedec_id[3];    /**< Manufacturer, type, capacity code  */
+  uint32_t      size;           /**< Flash size in bytes, power of 2    */
+  uint32_t      page_size;      /**< Program page size, power of 2      */
+  bool          sfdp;           /**< Answer SFDP reads                  */
+  bool          addr_4b;        /**< 3 or 4 byte address capable        */
+  /** Erase types as size exponent and opcode, exponent 0 if unused */
+  struct {
+    uint8_t     exp;            /**< log2 of erase size                 */
+    uint8_t     opcode;         /**< Erase instruction                  */
+  } erase[I2_SPI_FLASH_SIM_ERASE_TYPES];
+} i2_spi_flash_sim_cfg_t;
+/** @} */ /* i2_spi_flash_sim_cfg_t */
+
+/**
+ * @defgroup i2_spi_flash_sim_stats_t Simulated flash statistics.
+ * Commands seen by simulated flash, and protocol violations.
+ *
+ * @{
+ */
+/** @brief Simulated flash statistics */
+typedef struct {
+  uint32_t      erases[I2_SPI_FLASH_SIM_ERASE_TYPES]; /**< Per erase type */
+  uint32_t      programs;       /**< Page program instructions          */
+  uint32_t      page_cross;     /**< Programs crossing a page boundary  */
+  uint32_t      no_wel;         /**< Program / erase without WEL set    */
+  uint32_t      while_busy;     /**< Instructions sent while WIP set    */
+  uint32_t      misaligned;     /**< Erase address not block aligned    */
+  uint32_t      unknown;        /**< Unknown instructions               */
+} i2_spi_flash_sim_stats_t;
+/** @} */ /* i2_spi_flash_sim_stats_t */
+
+/* Public functions --------------------------------------------------------- */
+void i2_spi_flash_sim_init(const i2_spi_flash_sim_cfg_t *cfg);
+uint8_t* i2_spi_flash_sim_mem(void);
+i2_spi_flash_sim_stats_t* i2_spi_flash_sim_stats(void);
+
+/************************ (C) COPYRIGHT iota2 ***[i2]*****END OF FILE**********/
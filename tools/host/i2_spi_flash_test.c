@@ -0,0 +1,251 @@
+/**
+ * @author      iota square [i2]
+ * <pre>
+ * ██╗ ██████╗ ████████╗ █████╗ ██████╗
+ * ██║██╔═══██╗╚══██╔══╝██╔══██╗╚════██╗
+ * ██║██║   ██║   ██║   ███████║ █████╔╝
+ * ██║██║   ██║   ██║   ██╔══██║██╔═══╝
+ * ██║╚██████╔╝   ██║   ██║  ██║███████╗
+ * ╚═╝ ╚═════╝    ╚═╝   ╚═╝  ╚═╝╚══════╝
+ * </pre>
+ *
+ * @date        17-10-2026
+ * @file        i2_spi_flash_test.c
+ * @brief       Host test of SPI NOR flash driver.
+ *
+ * @copyright   GNU GPU v3
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * Free Software, Hell Yeah!
+ *
+ **/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+
+#include "i2_spi_flash.h"
+#include "i2_spi_flash_sim.h"
+
+/* Private defines -----------------------------------------------------------*/
+/** @brief Test check, reports failing line and counts failures */
+#define CHECK(x)  do { if (!(x)) { printf("%s:%d: %s\n", __FILE__, __LINE__, \
+                       #x); failures++; } } while (0)
+
+/* Private variables ---------------------------------------------------------*/
+/** @brief Failed checks */
+static int32_t failures;
+/** @brief SPI instance of flash, unused by simulation */
+static i2_spi_inst_t spi;
+/** @brief Flash device under test */
+static i2_spi_flash_t flash;
+/** @brief Test data */
+static uint8_t data[4096];
+/** @brief Read back buffer */
+static uint8_t rdbuf[4096];
+
+/** @brief 16MB SFDP part, erase types listed out of order */
+static const i2_spi_flash_sim_cfg_t sfdp_16m = {
+  .jedec_id = { 0xEF, 0x40, 0x18 },
+  .size = 16UL << 20, .page_size = 256, .sfdp = true, .addr_4b = false,
+  .erase = { { 16, 0xD8 }, { 12, 0x20 }, { 0, 0 }, { 15, 0x52 } },
+};
+
+/** @brief 32MB SFDP part, needs 4 byte addressing */
+static const i2_spi_flash_sim_cfg_t sfdp_32m = {
+  .jedec_id = { 0xEF, 0x40, 0x19 },
+  .size = 32UL << 20, .page_size = 256, .sfdp = true, .addr_4b = true,
+  .erase = { { 12, 0x20 }, { 16, 0xD8 } },
+};
+
+/** @brief 2MB part without SFDP, standard erase instructions */
+static const i2_spi_flash_sim_cfg_t legacy_2m = {
+  .jedec_id = { 0xC2, 0x20, 0x15 },
+  .size = 2UL << 20, .page_size = 256, .sfdp = false,
+  .erase = { { 12, 0x20 }, { 15, 0x52 }, { 16, 0xD8 } },
+};
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief   Area state check.
+ * @details Checks whether a flash area holds only erased bytes.
+ *
+ * @param[in] addr        Area address.
+ * @param[in] size        Area size.
+ * @return  true if area is erased.
+ */
+static bool area_erased(uint32_t addr, uint32_t size)
+{
+  const uint8_t *mem = i2_spi_flash_sim_mem();
+
+  while ( size-- ) {
+    if ( mem[addr++] != 0xFF ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief   Protocol check.
+ * @details Checks that driver never violated flash protocol.
+ *
+ * @return  None.
+ */
+static void check_protocol(void)
+{
+  i2_spi_flash_sim_stats_t *stats = i2_spi_flash_sim_stats();
+
+  CHECK(stats->page_cross == 0);
+  CHECK(stats->no_wel == 0);
+  CHECK(stats->while_busy == 0);
+  CHECK(stats->misaligned == 0);
+  CHECK(stats->unknown == 0);
+}
+
+/**
+ * @brief   SFDP parsing test.
+ * @details Geometry and sorted erase types come from SFDP.
+ *
+ * @return  None.
+ */
+static void test_sfdp(void)
+{
+  i2_spi_flash_sim_init(&sfdp_16m);
+  CHECK(i2_spi_flash_init(&flash, &spi) == I2_SUCCESS);
+  CHECK(flash.sfdp);
+  CHECK(flash.size == (16UL << 20));
+  CHECK(flash.page_size == 256);
+  CHECK(flash.addr_len == 3);
+  CHECK((flash.erase[0].size == 0x1000) && (flash.erase[0].opcode == 0x20));
+  CHECK((flash.erase[1].size == 0x8000) && (flash.erase[1].opcode == 0x52));
+  CHECK((flash.erase[2].size == 0x10000) && (flash.erase[2].opcode == 0xD8));
+  CHECK(flash.erase[3].size == 0);
+  CHECK((flash.suspend_opcode == 0x75) && (flash.resume_opcode == 0x7A));
+
+  i2_spi_flash_sim_init(&legacy_2m);
+  CHECK(i2_spi_flash_init(&flash, &spi) == I2_SUCCESS);
+  CHECK(!flash.sfdp);
+  CHECK(flash.size == (2UL << 20));
+  CHECK((flash.erase[0].size == 0x1000) && (flash.erase[2].size == 0x10000));
+  check_protocol();
+}
+
+/**
+ * @brief   Erase test.
+ * @details Largest fitting erase types are used, and invalid areas are
+ *          rejected before anything is erased.
+ *
+ * @return  None.
+ */
+static void test_erase(void)
+{
+  i2_spi_flash_sim_stats_t *stats;
+  uint8_t *mem;
+
+  i2_spi_flash_sim_init(&sfdp_16m);
+  CHECK(i2_spi_flash_init(&flash, &spi) == I2_SUCCESS);
+  stats = i2_spi_flash_sim_stats();
+  mem = i2_spi_flash_sim_mem();
+  memset(mem, 0x00, 0x40000);
+
+  /* 4K up to 32K boundary, 32K up to 64K boundary, 64K, 4K tail */
+  CHECK(i2_spi_flash_erase(&flash, 0x7000, 0x1A000) == I2_SUCCESS);
+  CHECK(stats->erases[1] == 2);     /* 4K  */
+  CHECK(stats->erases[3] == 1);     /* 32K */
+  CHECK(stats->erases[0] == 1);     /* 64K */
+  CHECK(area_erased(0x7000, 0x1A000));
+  CHECK(mem[0x6FFF] == 0x00);
+  CHECK(mem[0x21000] == 0x00);
+
+  /* Invalid areas erase nothing */
+  memset(stats->erases, 0, sizeof(stats->erases));
+  CHECK(i2_spi_flash_erase(&flash, 0x30800, 0x1000) == I2_INVALID_PARAM);
+  CHECK(i2_spi_flash_erase(&flash, 0x30000, 0x1800) == I2_INVALID_PARAM);
+  CHECK(i2_spi_flash_erase(&flash, 0xFFFFF000, 0x2000) == I2_INVALID_PARAM);
+  CHECK(i2_spi_flash_erase(&flash, flash.size - 0x1000, 0x2000) ==
+        I2_INVALID_PARAM);
+  CHECK(i2_spi_flash_erase(&flash, 0, 0) == I2_INVALID_PARAM);
+  CHECK((stats->erases[0] | stats->erases[1] | stats->erases[3]) == 0);
+
+  /* Single block erase start */
+  CHECK(i2_spi_flash_erase_start(&flash, 0x38000, 0x8000) == I2_SUCCESS);
+  CHECK(i2_spi_flash_wait_ready(&flash, 100) == I2_SUCCESS);
+  CHECK(stats->erases[3] == 1);
+  CHECK(i2_spi_flash_erase_start(&flash, 0x34000, 0x8000) ==
+        I2_INVALID_PARAM);
+  check_protocol();
+}
+
+/**
+ * @brief   Program test.
+ * @details Writes are split on page boundaries and read back intact.
+ *
+ * @param[in] *cfg        Flash configuration.
+ * @param[in] addr        Address to write to.
+ * @return  None.
+ */
+static void test_program(const i2_spi_flash_sim_cfg_t *cfg, uint32_t addr)
+{
+  i2_spi_flash_sim_stats_t *stats;
+  uint32_t i;
+
+  i2_spi_flash_sim_init(cfg);
+  CHECK(i2_spi_flash_init(&flash, &spi) == I2_SUCCESS);
+  stats = i2_spi_flash_sim_stats();
+
+  for (i = 0; i < sizeof(data); i++) {
+    data[i] = (uint8_t)((i * 7) + (i >> 8));
+  }
+
+  /* 0x1F0 start: 16 byte head, 3 full pages, 216 byte tail */
+  CHECK(i2_spi_flash_write(&flash, addr + 0x1F0, data, 1000) == I2_SUCCESS);
+  CHECK(stats->programs == 5);
+  CHECK(!memcmp(i2_spi_flash_sim_mem() + addr + 0x1F0, data, 1000));
+  CHECK(area_erased(addr, 0x1F0));
+  CHECK(area_erased(addr + 0x1F0 + 1000, 0x100));
+
+  memset(rdbuf, 0, sizeof(rdbuf));
+  CHECK(i2_spi_flash_read(&flash, addr + 0x1F0, rdbuf, 1000) == I2_SUCCESS);
+  CHECK(!memcmp(rdbuf, data, 1000));
+
+  CHECK(i2_spi_flash_write(&flash, flash.size - 16, data, 32) ==
+        I2_INVALID_PARAM);
+  CHECK(i2_spi_flash_read(&flash, 0xFFFFFFF0, rdbuf, 32) == I2_INVALID_PARAM);
+  check_protocol();
+}
+
+/* Public functions ----------------------------------------------------------*/
+/**
+ * @brief   Test entry.
+ * @details Runs SPI NOR flash driver against simulated flash.
+ *
+ * @return  0 if all checks pass.
+ */
+int main(void)
+{
+  test_sfdp();
+  test_erase();
+  test_program(&sfdp_16m, 0x10000);
+  test_program(&sfdp_32m, 0x1800000);
+  if ( flash.addr_len != 4 ) {
+    failures++;
+    printf("4 byte addressing not used\n");
+  }
+
+  printf("spi flash: %s, %d failures\n", failures ? "FAIL" : "PASS",
+         (int)failures);
+
+  return failures ? 1 : 0;
+}
+
+/************************ (C) COPYRIGHT iota2 ***[i2]*****END OF FILE**********/